@@ -19,6 +19,11 @@ namespace blink {
 ZipAssetStore::ZipAssetStore(UnzipperProvider unzipper_provider)
     : unzipper_provider_(std::move(unzipper_provider)) {}
 
+ZipAssetStore::ZipAssetStore(UnzipperProvider unzipper_provider,
+                             std::string zip_path)
+    : unzipper_provider_(std::move(unzipper_provider)),
+      zip_path_(std::move(zip_path)) {}
+
 ZipAssetStore::~ZipAssetStore() {}
 
 bool ZipAssetStore::GetAsBuffer(const std::string& asset_name,
@@ -59,4 +64,44 @@ bool ZipAssetStore::GetAsBuffer(const std::string& asset_name,
   return true;
 }
 
+bool ZipAssetStore::GetStoredAssetLocation(const std::string& asset_name,
+                                           size_t* offset,
+                                           size_t* length) {
+  zip::UniqueUnzipper unzipper = unzipper_provider_();
+  if (!unzipper.is_valid())
+    return false;
+
+  if (unzLocateFile(unzipper.get(), asset_name.c_str(), 0) != UNZ_OK)
+    return false;
+
+  unz_file_info file_info;
+  int result = unzGetCurrentFileInfo(unzipper.get(), &file_info, nullptr, 0,
+                                     nullptr, 0, nullptr, 0);
+  if (result != UNZ_OK) {
+    FTL_LOG(WARNING) << "unzGetCurrentFileInfo failed, error=" << result;
+    return false;
+  }
+
+  // Bit 0 of the general purpose flags marks encrypted entries.
+  if (file_info.compression_method != 0 || (file_info.flag & 1) != 0 ||
+      file_info.compressed_size != file_info.uncompressed_size)
+    return false;
+
+  // The position of the data is only known once the entry is opened, as the
+  // local header has a variable length.
+  result = unzOpenCurrentFile(unzipper.get());
+  if (result != UNZ_OK) {
+    FTL_LOG(WARNING) << "unzOpenCurrentFile failed, error=" << result;
+    return false;
+  }
+  ZPOS64_T position = unzGetCurrentFileZStreamPos64(unzipper.get());
+  unzCloseCurrentFile(unzipper.get());
+  if (position == 0)
+    return false;
+
+  *offset = position;
+  *length = file_info.uncompressed_size;
+  return true;
+}
+
 }  // namespace blink
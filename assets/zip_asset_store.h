@@ -6,6 +6,7 @@
 #define FLUTTER_ASSETS_ZIP_ASSET_STORE_H_
 
 #include <map>
+#include <string>
 #include <vector>
 
 #include "flutter/assets/unzipper_provider.h"
@@ -17,12 +18,25 @@ namespace blink {
 class ZipAssetStore : public ftl::RefCountedThreadSafe<ZipAssetStore> {
  public:
   explicit ZipAssetStore(UnzipperProvider unzipper_provider);
+  // For stores reading the zip file at |zip_path|, which allows stored
+  // assets to be mapped rather than copied. See GetStoredAssetLocation().
+  ZipAssetStore(UnzipperProvider unzipper_provider, std::string zip_path);
   ~ZipAssetStore();
 
   bool GetAsBuffer(const std::string& asset_name, std::vector<uint8_t>* data);
 
+  // Empty unless the store was created with the path of its zip file.
+  const std::string& zip_path() const { return zip_path_; }
+
+  // Finds the bytes of |asset_name| in the zip file, for assets stored there
+  // as is, i.e. neither compressed nor encrypted. Returns false otherwise.
+  bool GetStoredAssetLocation(const std::string& asset_name,
+                              size_t* offset,
+                              size_t* length);
+
  private:
   UnzipperProvider unzipper_provider_;
+  const std::string zip_path_;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(ZipAssetStore);
 };
@@ -0,0 +1,39 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/counting_task_runner.h"
+
+#include <utility>
+
+namespace blink {
+
+CountingTaskRunner::CountingTaskRunner(ftl::RefPtr<ftl::TaskRunner> runner)
+    : runner_(std::move(runner)), task_count_(0) {}
+
+CountingTaskRunner::~CountingTaskRunner() {}
+
+// The count goes up before the task is handed on, so that a task that reads
+// it never sees a count from before itself was posted.
+void CountingTaskRunner::PostTask(ftl::Closure task) {
+  ++task_count_;
+  runner_->PostTask(std::move(task));
+}
+
+void CountingTaskRunner::PostTaskForTime(ftl::Closure task,
+                                         ftl::TimePoint target_time) {
+  ++task_count_;
+  runner_->PostTaskForTime(std::move(task), target_time);
+}
+
+void CountingTaskRunner::PostDelayedTask(ftl::Closure task,
+                                         ftl::TimeDelta delay) {
+  ++task_count_;
+  runner_->PostDelayedTask(std::move(task), delay);
+}
+
+bool CountingTaskRunner::RunsTasksOnCurrentThread() {
+  return runner_->RunsTasksOnCurrentThread();
+}
+
+}  // namespace blink
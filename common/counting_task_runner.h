@@ -0,0 +1,44 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_COUNTING_TASK_RUNNER_H_
+#define FLUTTER_COMMON_COUNTING_TASK_RUNNER_H_
+
+#include <atomic>
+#include <stdint.h>
+
+#include "lib/ftl/macros.h"
+#include "lib/ftl/memory/ref_ptr.h"
+#include "lib/ftl/tasks/task_runner.h"
+
+namespace blink {
+
+// Forwards the tasks posted to it to another runner and counts them, so that
+// code holding back work for a task it has already posted can tell whether
+// anything was posted behind that task since.
+class CountingTaskRunner : public ftl::TaskRunner {
+ public:
+  explicit CountingTaskRunner(ftl::RefPtr<ftl::TaskRunner> runner);
+
+  void PostTask(ftl::Closure task) override;
+  void PostTaskForTime(ftl::Closure task, ftl::TimePoint target_time) override;
+  void PostDelayedTask(ftl::Closure task, ftl::TimeDelta delay) override;
+  bool RunsTasksOnCurrentThread() override;
+
+  // The tasks posted so far, from any thread.
+  uint64_t task_count() const { return task_count_.load(); }
+
+ protected:
+  ~CountingTaskRunner() override;
+
+ private:
+  const ftl::RefPtr<ftl::TaskRunner> runner_;
+  std::atomic<uint64_t> task_count_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(CountingTaskRunner);
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_COMMON_COUNTING_TASK_RUNNER_H_
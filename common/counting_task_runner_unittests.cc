@@ -0,0 +1,89 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/counting_task_runner.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace blink {
+namespace {
+
+// Keeps the tasks posted to it until the test runs them.
+class ManualTaskRunner : public ftl::TaskRunner {
+ public:
+  void PostTask(ftl::Closure task) override { tasks_.push_back(task); }
+  void PostTaskForTime(ftl::Closure task, ftl::TimePoint target_time) override {
+    tasks_.push_back(task);
+  }
+  void PostDelayedTask(ftl::Closure task, ftl::TimeDelta delay) override {
+    tasks_.push_back(task);
+  }
+  bool RunsTasksOnCurrentThread() override { return runs_tasks_; }
+
+  void RunTasks() {
+    std::vector<ftl::Closure> tasks;
+    tasks.swap(tasks_);
+    for (const auto& task : tasks)
+      task();
+  }
+
+  size_t task_count() const { return tasks_.size(); }
+  void set_runs_tasks(bool runs_tasks) { runs_tasks_ = runs_tasks; }
+
+ private:
+  std::vector<ftl::Closure> tasks_;
+  bool runs_tasks_ = false;
+};
+
+}  // namespace
+
+TEST(CountingTaskRunnerTest, CountsEveryKindOfTask) {
+  auto target = ftl::MakeRefCounted<ManualTaskRunner>();
+  auto runner = ftl::MakeRefCounted<CountingTaskRunner>(target);
+  EXPECT_EQ(0u, runner->task_count());
+
+  runner->PostTask([]() {});
+  runner->PostTaskForTime([]() {}, ftl::TimePoint::Now());
+  runner->PostDelayedTask([]() {}, ftl::TimeDelta());
+  EXPECT_EQ(3u, runner->task_count());
+  EXPECT_EQ(3u, target->task_count());
+}
+
+TEST(CountingTaskRunnerTest, ForwardsTasksInOrder) {
+  auto target = ftl::MakeRefCounted<ManualTaskRunner>();
+  auto runner = ftl::MakeRefCounted<CountingTaskRunner>(target);
+
+  std::vector<int> order;
+  runner->PostTask([&order]() { order.push_back(1); });
+  runner->PostTask([&order]() { order.push_back(2); });
+  target->RunTasks();
+
+  EXPECT_EQ((std::vector<int>{1, 2}), order);
+  // Running tasks does not change the count.
+  EXPECT_EQ(2u, runner->task_count());
+}
+
+TEST(CountingTaskRunnerTest, CountIncludesTheTaskReadingIt) {
+  auto target = ftl::MakeRefCounted<ManualTaskRunner>();
+  auto runner = ftl::MakeRefCounted<CountingTaskRunner>(target);
+
+  uint64_t count_in_task = 0;
+  runner->PostTask([&]() { count_in_task = runner->task_count(); });
+  target->RunTasks();
+
+  EXPECT_EQ(1u, count_in_task);
+}
+
+TEST(CountingTaskRunnerTest, RunsTasksOnTheThreadOfItsTarget) {
+  auto target = ftl::MakeRefCounted<ManualTaskRunner>();
+  auto runner = ftl::MakeRefCounted<CountingTaskRunner>(target);
+
+  EXPECT_FALSE(runner->RunsTasksOnCurrentThread());
+  target->set_runs_tasks(true);
+  EXPECT_TRUE(runner->RunsTasksOnCurrentThread());
+}
+
+}  // namespace blink
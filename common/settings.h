@@ -27,6 +27,14 @@ struct Settings {
   std::string aot_rodata_blob_file_name;
   std::string temp_directory_path;
   std::vector<std::string> dart_flags;
+  // The most GPU threads platform views are spread over. With the default of
+  // one, all views rasterize on the same thread.
+  int gpu_thread_count = 1;
+  // Load the fonts of the asset bundle while the isolate starts.
+  bool prewarm_fonts = false;
+  // Create the UI isolate while the platform sets up the view, before the
+  // script to run is known.
+  bool precreate_isolate = false;
 
   static const Settings& Get();
   static void Set(const Settings& settings);
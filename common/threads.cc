@@ -4,6 +4,8 @@
 
 #include "flutter/common/threads.h"
 
+#include <pthread.h>
+
 #include <utility>
 
 namespace blink {
@@ -11,6 +13,23 @@ namespace {
 
 Threads* g_threads = nullptr;
 
+pthread_once_t g_current_key_once = PTHREAD_ONCE_INIT;
+pthread_key_t g_current_key;
+
+void CreateCurrentKey() {
+  FTL_CHECK(pthread_key_create(&g_current_key, nullptr) == 0);
+}
+
+const Threads* GetCurrentThreads() {
+  pthread_once(&g_current_key_once, CreateCurrentKey);
+  return static_cast<const Threads*>(pthread_getspecific(g_current_key));
+}
+
+void SetCurrentThreads(const Threads* threads) {
+  pthread_once(&g_current_key_once, CreateCurrentKey);
+  pthread_setspecific(g_current_key, threads);
+}
+
 }  // namespace
 
 Threads::Threads() {}
@@ -43,6 +62,8 @@ const ftl::RefPtr<ftl::TaskRunner>& Threads::IO() {
 }
 
 const Threads& Threads::Get() {
+  if (const Threads* current = GetCurrentThreads())
+    return *current;
   FTL_CHECK(g_threads);
   return *g_threads;
 }
@@ -53,4 +74,17 @@ void Threads::Set(const Threads& threads) {
   *g_threads = threads;
 }
 
+void Threads::SetCurrent(const Threads* threads) {
+  SetCurrentThreads(threads);
+}
+
+Threads::Scope::Scope(const Threads* threads)
+    : previous_(GetCurrentThreads()) {
+  SetCurrentThreads(threads);
+}
+
+Threads::Scope::~Scope() {
+  SetCurrentThreads(previous_);
+}
+
 }  // namespace blink
@@ -5,10 +5,15 @@
 #ifndef FLUTTER_COMMON_THREADS_H_
 #define FLUTTER_COMMON_THREADS_H_
 
+#include "lib/ftl/macros.h"
 #include "lib/ftl/tasks/task_runner.h"
 
 namespace blink {
 
+// A set of task runners an engine runs on. The process has a default set,
+// installed with Set(). Engines may be given sets of their own, which share
+// the default platform, UI and IO threads but rasterize on a different GPU
+// thread.
 class Threads {
  public:
   Threads();
@@ -18,6 +23,14 @@ class Threads {
           ftl::RefPtr<ftl::TaskRunner> io);
   ~Threads();
 
+  const ftl::RefPtr<ftl::TaskRunner>& platform() const { return platform_; }
+  const ftl::RefPtr<ftl::TaskRunner>& gpu() const { return gpu_; }
+  const ftl::RefPtr<ftl::TaskRunner>& ui() const { return ui_; }
+  const ftl::RefPtr<ftl::TaskRunner>& io() const { return io_; }
+
+  // The task runners of the set current on the calling thread (see
+  // SetCurrent() and Scope),
+  // or of the default set if there is none.
   static const ftl::RefPtr<ftl::TaskRunner>& Platform();
   static const ftl::RefPtr<ftl::TaskRunner>& Gpu();
   static const ftl::RefPtr<ftl::TaskRunner>& UI();
@@ -25,6 +38,24 @@ class Threads {
 
   static void Set(const Threads& settings);
 
+  // Makes |threads| current on the calling thread for good, for threads that
+  // only ever serve one set. |threads| must outlive the thread's use of it.
+  static void SetCurrent(const Threads* threads);
+
+  // Makes |threads| current on the calling thread for the lifetime of the
+  // scope. |threads| must outlive the scope. Code on shared threads opens a
+  // scope while it works for a particular engine.
+  class Scope {
+   public:
+    explicit Scope(const Threads* threads);
+    ~Scope();
+
+   private:
+    const Threads* previous_;
+
+    FTL_DISALLOW_COPY_AND_ASSIGN(Scope);
+  };
+
  private:
   static const Threads& Get();
 
@@ -0,0 +1,151 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/worker_pool.h"
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/glue/trace_event.h"
+#include "flutter/glue/trace_recorder.h"
+#include "lib/ftl/logging.h"
+
+namespace blink {
+namespace {
+
+// The engine already keeps the platform, UI, GPU and IO threads busy, so the
+// pool only takes a share of the remaining cores.
+const size_t kMinWorkerCount = 2;
+const size_t kMaxWorkerCount = 4;
+
+pthread_once_t g_worker_key_once = PTHREAD_ONCE_INIT;
+pthread_key_t g_worker_key;
+
+void CreateWorkerKey() {
+  FTL_CHECK(pthread_key_create(&g_worker_key, nullptr) == 0);
+}
+
+void* GetCurrentWorker() {
+  pthread_once(&g_worker_key_once, CreateWorkerKey);
+  return pthread_getspecific(g_worker_key);
+}
+
+void SetCurrentWorker(void* worker) {
+  pthread_once(&g_worker_key_once, CreateWorkerKey);
+  pthread_setspecific(g_worker_key, worker);
+}
+
+}  // namespace
+
+WorkerPool& WorkerPool::Get() {
+  static WorkerPool* pool = new WorkerPool(std::min(
+      std::max<size_t>(std::thread::hardware_concurrency() / 2,
+                       kMinWorkerCount),
+      kMaxWorkerCount));
+  return *pool;
+}
+
+WorkerPool::WorkerPool(size_t worker_count)
+    : next_worker_(0), post_count_(0), shutting_down_(false) {
+  FTL_DCHECK(worker_count > 0);
+  for (size_t i = 0; i < worker_count; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+    workers_[i]->pool = this;
+    workers_[i]->index = i;
+  }
+  // Start the threads once the list is complete, as they look at each other.
+  for (size_t i = 0; i < worker_count; ++i) {
+    Worker* worker = workers_[i].get();
+    worker->thread = std::thread([this, worker]() { Run(worker); });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(post_mutex_);
+    shutting_down_ = true;
+  }
+  post_cond_.notify_all();
+  for (const auto& worker : workers_)
+    worker->thread.join();
+}
+
+void WorkerPool::PostTask(Priority priority,
+                          const char* tag,
+                          ftl::Closure task) {
+  // Tasks posted by this pool's own workers stay with the poster.
+  Worker* worker = static_cast<Worker*>(GetCurrentWorker());
+  if (!worker || worker->pool != this)
+    worker = workers_[next_worker_.fetch_add(1) % workers_.size()].get();
+
+  {
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    worker->queues[static_cast<size_t>(priority)].push_back(
+        {tag, std::move(task)});
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(post_mutex_);
+    ++post_count_;
+  }
+  post_cond_.notify_one();
+}
+
+void WorkerPool::Run(Worker* worker) {
+  SetCurrentWorker(worker);
+#if defined(FLUTTER_TRACE_RECORDER)
+  glue::TraceRecorder::SetCurrentThreadName("worker_thread");
+#endif  // defined(FLUTTER_TRACE_RECORDER)
+  for (;;) {
+    // Every task counted before the search is in some queue it looks at,
+    // unless another worker took it first.
+    uint64_t seen_post_count;
+    {
+      std::lock_guard<std::mutex> lock(post_mutex_);
+      seen_post_count = post_count_;
+    }
+
+    Task task;
+    if (TakeTask(worker->index, &task)) {
+      TRACE_EVENT0("flutter", task.tag);
+      task.closure();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(post_mutex_);
+    if (shutting_down_ && post_count_ == seen_post_count)
+      return;
+    post_cond_.wait(lock, [this, seen_post_count]() {
+      return post_count_ != seen_post_count || shutting_down_;
+    });
+  }
+}
+
+bool WorkerPool::TakeTask(size_t index, Task* task) {
+  for (size_t priority = 0; priority < kPriorityCount; ++priority) {
+    // Own work first, then steal from the others.
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      Worker* worker = workers_[(index + i) % workers_.size()].get();
+      if (TakeTaskFromQueue(worker, priority, task))
+        return true;
+    }
+  }
+  return false;
+}
+
+bool WorkerPool::TakeTaskFromQueue(Worker* worker,
+                                   size_t priority,
+                                   Task* task) {
+  std::lock_guard<std::mutex> lock(worker->mutex);
+  std::deque<Task>& queue = worker->queues[priority];
+  if (queue.empty())
+    return false;
+  *task = std::move(queue.front());
+  queue.pop_front();
+  return true;
+}
+
+}  // namespace blink
@@ -0,0 +1,89 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_WORKER_POOL_H_
+#define FLUTTER_COMMON_WORKER_POOL_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "lib/ftl/functional/closure.h"
+#include "lib/ftl/macros.h"
+
+namespace blink {
+
+// A pool of threads for background work that does not need a particular
+// thread, unlike work that uses the GPU or IO thread's GL context. Tasks run
+// in no particular order within a priority, possibly concurrently.
+//
+// Each worker has its own queues, so that posting rarely contends with other
+// workers. Tasks posted from a worker go to that worker's queues; other tasks
+// are spread over the workers. Workers that run out of work take tasks from
+// the others, and sleep once there are none left anywhere.
+class WorkerPool {
+ public:
+  enum class Priority {
+    // Someone is waiting for the result, e.g. a frame or a Dart callback.
+    kUserBlocking,
+    // Work whose result nobody waits for, e.g. writing out diagnostics or
+    // freeing memory.
+    kBackground,
+  };
+
+  // The process-wide pool. Started on first use, and never shut down.
+  static WorkerPool& Get();
+
+  explicit WorkerPool(size_t worker_count);
+  // Runs the tasks already posted, including those they post in turn, then
+  // stops the workers. Only tasks of the pool may post while it shuts down.
+  ~WorkerPool();
+
+  // |tag| names the task in traces and must be a string literal.
+  void PostTask(Priority priority, const char* tag, ftl::Closure task);
+
+  size_t worker_count() const { return workers_.size(); }
+
+ private:
+  static constexpr size_t kPriorityCount = 2;
+
+  struct Task {
+    const char* tag;
+    ftl::Closure closure;
+  };
+
+  struct Worker {
+    WorkerPool* pool;
+    size_t index;
+    std::mutex mutex;
+    std::deque<Task> queues[kPriorityCount];
+    std::thread thread;
+  };
+
+  void Run(Worker* worker);
+  bool TakeTask(size_t index, Task* task);
+  bool TakeTaskFromQueue(Worker* worker, size_t priority, Task* task);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<size_t> next_worker_;
+
+  // Counts the tasks ever posted. A worker that found every queue empty
+  // sleeps until the count moves on from what it was before the search.
+  std::mutex post_mutex_;
+  std::condition_variable post_cond_;
+  uint64_t post_count_;
+  bool shutting_down_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(WorkerPool);
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_COMMON_WORKER_POOL_H_
@@ -0,0 +1,135 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/worker_pool.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace blink {
+namespace {
+
+// Long enough that a test only times out when it would otherwise hang.
+constexpr std::chrono::seconds kTimeout(10);
+
+class Latch {
+ public:
+  void Signal() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    signaled_ = true;
+    cond_.notify_all();
+  }
+
+  bool Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cond_.wait_for(lock, kTimeout, [this]() { return signaled_; });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool signaled_ = false;
+};
+
+}  // namespace
+
+TEST(WorkerPoolTest, RunsUserBlockingTasksFirst) {
+  WorkerPool pool(1);
+
+  // Hold the only worker while the other tasks are posted.
+  Latch started;
+  Latch release;
+  pool.PostTask(WorkerPool::Priority::kUserBlocking, "Block", [&]() {
+    started.Signal();
+    release.Wait();
+  });
+  ASSERT_TRUE(started.Wait());
+
+  std::mutex mutex;
+  std::vector<int> order;
+  auto record = [&](int value) {
+    return [&, value]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(value);
+    };
+  };
+  pool.PostTask(WorkerPool::Priority::kBackground, "Background", record(3));
+  pool.PostTask(WorkerPool::Priority::kUserBlocking, "UserBlocking", record(1));
+  pool.PostTask(WorkerPool::Priority::kBackground, "Background", record(4));
+  pool.PostTask(WorkerPool::Priority::kUserBlocking, "UserBlocking", record(2));
+
+  Latch done;
+  pool.PostTask(WorkerPool::Priority::kBackground, "Done",
+                [&]() { done.Signal(); });
+  release.Signal();
+  ASSERT_TRUE(done.Wait());
+
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_EQ((std::vector<int>{1, 2, 3, 4}), order);
+}
+
+TEST(WorkerPoolTest, IdleWorkersStealTasks) {
+  WorkerPool pool(2);
+
+  // A task posted from a worker goes to that worker's own queue. The worker
+  // then blocks until the task has run, which only another worker stealing
+  // it can bring about.
+  Latch stolen;
+  std::thread::id poster;
+  std::thread::id runner;
+  pool.PostTask(WorkerPool::Priority::kUserBlocking, "Poster", [&]() {
+    poster = std::this_thread::get_id();
+    pool.PostTask(WorkerPool::Priority::kUserBlocking, "Stolen", [&]() {
+      runner = std::this_thread::get_id();
+      stolen.Signal();
+    });
+    EXPECT_TRUE(stolen.Wait());
+  });
+
+  ASSERT_TRUE(stolen.Wait());
+  EXPECT_NE(poster, runner);
+}
+
+TEST(WorkerPoolTest, WakesIdleWorkers) {
+  WorkerPool pool(2);
+
+  // Let the workers go to sleep, then check each post still gets picked up.
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  for (int i = 0; i < 100; ++i) {
+    Latch ran;
+    pool.PostTask(WorkerPool::Priority::kBackground, "Task",
+                  [&]() { ran.Signal(); });
+    ASSERT_TRUE(ran.Wait());
+  }
+}
+
+TEST(WorkerPoolTest, ShutdownRunsPostedTasks) {
+  std::mutex mutex;
+  int count = 0;
+  auto increment = [&]() {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++count;
+  };
+
+  {
+    WorkerPool pool(3);
+    for (int i = 0; i < 100; ++i) {
+      pool.PostTask(WorkerPool::Priority::kBackground, "Task", [&]() {
+        increment();
+        // Tasks may still post while the pool shuts down.
+        pool.PostTask(WorkerPool::Priority::kBackground, "Nested", increment);
+      });
+    }
+  }
+
+  // The destructor waited for every task, nested ones included.
+  EXPECT_EQ(200, count);
+}
+
+}  // namespace blink
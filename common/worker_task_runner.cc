@@ -0,0 +1,75 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/worker_task_runner.h"
+
+#include <utility>
+
+#include "flutter/common/threads.h"
+
+namespace blink {
+
+WorkerTaskRunner::WorkerTaskRunner(WorkerPool::Priority priority,
+                                   const char* tag)
+    : priority_(priority), tag_(tag), scheduled_(false) {}
+
+WorkerTaskRunner::~WorkerTaskRunner() {}
+
+void WorkerTaskRunner::PostTask(ftl::Closure task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+    if (scheduled_)
+      return;
+    scheduled_ = true;
+  }
+  ftl::RefPtr<WorkerTaskRunner> self(this);
+  WorkerPool::Get().PostTask(priority_, tag_,
+                             [self]() { self->RunNextTask(); });
+}
+
+void WorkerTaskRunner::PostTaskForTime(ftl::Closure task,
+                                       ftl::TimePoint target_time) {
+  ftl::RefPtr<WorkerTaskRunner> self(this);
+  Threads::IO()->PostTaskForTime(
+      [self, task]() { self->PostTask(task); }, target_time);
+}
+
+void WorkerTaskRunner::PostDelayedTask(ftl::Closure task,
+                                       ftl::TimeDelta delay) {
+  PostTaskForTime(std::move(task), ftl::TimePoint::Now() + delay);
+}
+
+bool WorkerTaskRunner::RunsTasksOnCurrentThread() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return running_thread_ == std::this_thread::get_id();
+}
+
+void WorkerTaskRunner::RunNextTask() {
+  ftl::Closure task;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task = std::move(tasks_.front());
+    tasks_.pop_front();
+    running_thread_ = std::this_thread::get_id();
+  }
+
+  task();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_thread_ = std::thread::id();
+    if (tasks_.empty()) {
+      scheduled_ = false;
+      return;
+    }
+  }
+  // Going back to the pool for each task lets the workers share out the
+  // work of several runners.
+  ftl::RefPtr<WorkerTaskRunner> self(this);
+  WorkerPool::Get().PostTask(priority_, tag_,
+                             [self]() { self->RunNextTask(); });
+}
+
+}  // namespace blink
@@ -0,0 +1,53 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_WORKER_TASK_RUNNER_H_
+#define FLUTTER_COMMON_WORKER_TASK_RUNNER_H_
+
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "flutter/common/worker_pool.h"
+#include "lib/ftl/macros.h"
+#include "lib/ftl/tasks/task_runner.h"
+
+namespace blink {
+
+// Runs the tasks posted to it on the worker pool, one at a time and in the
+// order they were posted, for code that expects a task runner of its own but
+// does not need a thread of its own. Consecutive tasks may run on different
+// workers. Delayed tasks wait on the IO thread until they are due.
+class WorkerTaskRunner : public ftl::TaskRunner {
+ public:
+  // |tag| names the tasks in traces and must be a string literal.
+  WorkerTaskRunner(WorkerPool::Priority priority, const char* tag);
+
+  void PostTask(ftl::Closure task) override;
+  void PostTaskForTime(ftl::Closure task, ftl::TimePoint target_time) override;
+  void PostDelayedTask(ftl::Closure task, ftl::TimeDelta delay) override;
+  bool RunsTasksOnCurrentThread() override;
+
+ protected:
+  ~WorkerTaskRunner() override;
+
+ private:
+  void RunNextTask();
+
+  const WorkerPool::Priority priority_;
+  const char* const tag_;
+
+  std::mutex mutex_;
+  std::deque<ftl::Closure> tasks_;
+  // Whether a task of this runner is posted to or running on the pool. There
+  // is at most one at a time.
+  bool scheduled_;
+  std::thread::id running_thread_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(WorkerTaskRunner);
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_COMMON_WORKER_TASK_RUNNER_H_
@@ -0,0 +1,133 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/worker_task_runner.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace blink {
+namespace {
+
+// Long enough that a test only times out when it would otherwise hang.
+constexpr std::chrono::seconds kTimeout(10);
+
+class Latch {
+ public:
+  void Signal() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    signaled_ = true;
+    cond_.notify_all();
+  }
+
+  bool Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cond_.wait_for(lock, kTimeout, [this]() { return signaled_; });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool signaled_ = false;
+};
+
+ftl::RefPtr<WorkerTaskRunner> CreateRunner() {
+  return ftl::MakeRefCounted<WorkerTaskRunner>(
+      WorkerPool::Priority::kUserBlocking, "Test");
+}
+
+}  // namespace
+
+TEST(WorkerTaskRunnerTest, RunsTasksInPostOrder) {
+  ftl::RefPtr<WorkerTaskRunner> runner = CreateRunner();
+
+  const int kTaskCount = 1000;
+  std::vector<int> order;
+  Latch done;
+  for (int i = 0; i < kTaskCount; ++i) {
+    runner->PostTask([&order, i]() { order.push_back(i); });
+  }
+  runner->PostTask([&done]() { done.Signal(); });
+  ASSERT_TRUE(done.Wait());
+
+  ASSERT_EQ(static_cast<size_t>(kTaskCount), order.size());
+  for (int i = 0; i < kTaskCount; ++i)
+    EXPECT_EQ(i, order[i]);
+}
+
+TEST(WorkerTaskRunnerTest, RunsOneTaskAtATime) {
+  // More runners than workers, so that their tasks compete for the pool.
+  const size_t kRunnerCount = WorkerPool::Get().worker_count() * 2;
+  const int kTasksPerRunner = 200;
+  std::vector<ftl::RefPtr<WorkerTaskRunner>> runners;
+  std::vector<std::atomic<int>> running(kRunnerCount);
+  std::atomic<int> overlaps(0);
+  std::atomic<size_t> remaining(kRunnerCount * kTasksPerRunner);
+  Latch done;
+  for (size_t i = 0; i < kRunnerCount; ++i)
+    runners.push_back(CreateRunner());
+
+  for (int task = 0; task < kTasksPerRunner; ++task) {
+    for (size_t i = 0; i < kRunnerCount; ++i) {
+      std::atomic<int>* runner_running = &running[i];
+      runners[i]->PostTask([&, runner_running]() {
+        if (runner_running->fetch_add(1) != 0)
+          ++overlaps;
+        std::this_thread::yield();
+        runner_running->fetch_sub(1);
+        if (--remaining == 0)
+          done.Signal();
+      });
+    }
+  }
+  ASSERT_TRUE(done.Wait());
+
+  EXPECT_EQ(0, overlaps.load());
+}
+
+TEST(WorkerTaskRunnerTest, RunsTasksOnCurrentThreadOnlyInItsTasks) {
+  ftl::RefPtr<WorkerTaskRunner> runner = CreateRunner();
+  ftl::RefPtr<WorkerTaskRunner> other = CreateRunner();
+  EXPECT_FALSE(runner->RunsTasksOnCurrentThread());
+
+  bool in_own_task = false;
+  bool in_other_task = true;
+  Latch done;
+  runner->PostTask([&]() {
+    in_own_task = runner->RunsTasksOnCurrentThread();
+    in_other_task = other->RunsTasksOnCurrentThread();
+    done.Signal();
+  });
+  ASSERT_TRUE(done.Wait());
+
+  EXPECT_TRUE(in_own_task);
+  EXPECT_FALSE(in_other_task);
+}
+
+TEST(WorkerTaskRunnerTest, TasksCanPostToTheirRunner) {
+  ftl::RefPtr<WorkerTaskRunner> runner = CreateRunner();
+
+  std::vector<int> order;
+  Latch done;
+  runner->PostTask([&]() {
+    order.push_back(1);
+    // Runs after the task posted before it, not nested in this one.
+    runner->PostTask([&]() {
+      order.push_back(3);
+      done.Signal();
+    });
+    order.push_back(2);
+  });
+  ASSERT_TRUE(done.Wait());
+
+  EXPECT_EQ((std::vector<int>{1, 2, 3}), order);
+}
+
+}  // namespace blink
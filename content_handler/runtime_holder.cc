@@ -185,7 +185,7 @@ void RuntimeHolder::HandlePlatformMessage(
 
 void RuntimeHolder::DidCreateMainIsolate(Dart_Isolate isolate) {
   if (asset_store_)
-    blink::AssetFontSelector::Install(asset_store_);
+    blink::AssetFontSelector::Install(asset_store_, nullptr);
   InitFidlInternal();
   InitMozartInternal();
 }
@@ -0,0 +1,160 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This example puts a blurred bar over a busy backdrop and steps through a
+// range of blur sigmas, at full and at reduced resolution, with a static and
+// with a moving backdrop. For each configuration it prints the average and
+// worst wall-clock time between frames, after a few frames of warm-up.
+//
+// On a device, frames are paced by vsync, so this only shows configurations
+// that miss it. Run it in the test shell with --benchmark-frames=N, which
+// begins each frame as soon as the previous one has been rasterized, to get
+// the full cost of each configuration. The blur also shows up in the
+// "BackdropFilterLayer::Paint" trace events.
+
+import 'dart:math' as math;
+import 'dart:typed_data';
+import 'dart:ui' as ui;
+
+const List<double> kSigmas = const <double>[2.0, 5.0, 10.0, 20.0, 40.0];
+const int kFramesPerConfiguration = 120;
+// Frames skipped at the start of each configuration, so that the backdrop
+// cache settles before measuring.
+const int kWarmUpFrames = 10;
+
+class Configuration {
+  const Configuration(this.sigma, this.downsample, this.animateBackdrop);
+
+  final double sigma;
+  final bool downsample;
+  final bool animateBackdrop;
+
+  @override
+  String toString() {
+    return 'sigma $sigma, '
+           '${downsample ? "downsampled" : "full resolution"}, '
+           '${animateBackdrop ? "moving" : "static"} backdrop';
+  }
+}
+
+final List<Configuration> configurations = () {
+  final List<Configuration> result = <Configuration>[];
+  for (bool animateBackdrop in <bool>[false, true]) {
+    for (bool downsample in <bool>[false, true]) {
+      for (double sigma in kSigmas)
+        result.add(new Configuration(sigma, downsample, animateBackdrop));
+    }
+  }
+  return result;
+}();
+
+int frameCount = 0;
+ui.Picture backdrop;
+ui.Size backdropSize;
+
+final Stopwatch frameStopwatch = new Stopwatch();
+int measuredFrames = 0;
+int totalFrameMicroseconds = 0;
+int worstFrameMicroseconds = 0;
+
+// Accounts for the time since the previous frame began.
+void measureFrame(int frameInConfiguration) {
+  final int elapsed = frameStopwatch.elapsedMicroseconds;
+  frameStopwatch
+    ..reset()
+    ..start();
+  // The first interval of a configuration still belongs to the previous one.
+  if (frameInConfiguration <= kWarmUpFrames)
+    return;
+  ++measuredFrames;
+  totalFrameMicroseconds += elapsed;
+  worstFrameMicroseconds = math.max(worstFrameMicroseconds, elapsed);
+}
+
+void report(Configuration configuration) {
+  if (measuredFrames == 0)
+    return;
+  final double average = totalFrameMicroseconds / measuredFrames / 1000.0;
+  final double worst = worstFrameMicroseconds / 1000.0;
+  print('$configuration: ${average.toStringAsFixed(2)}ms average, '
+        '${worst.toStringAsFixed(2)}ms worst over $measuredFrames frames');
+  measuredFrames = 0;
+  totalFrameMicroseconds = 0;
+  worstFrameMicroseconds = 0;
+}
+
+ui.Picture recordBackdrop(ui.Rect paintBounds) {
+  final ui.PictureRecorder recorder = new ui.PictureRecorder();
+  final ui.Canvas canvas = new ui.Canvas(recorder, paintBounds);
+  final math.Random random = new math.Random(42);
+  final ui.Paint paint = new ui.Paint();
+  for (int i = 0; i < 400; ++i) {
+    paint.color = new ui.Color(0xFF000000 | random.nextInt(0xFFFFFF));
+    canvas.drawCircle(
+        new ui.Point(random.nextDouble() * paintBounds.width,
+                     random.nextDouble() * paintBounds.height),
+        4.0 + random.nextDouble() * 24.0,
+        paint);
+  }
+  return recorder.endRecording();
+}
+
+ui.Picture recordBar(ui.Rect bounds) {
+  final ui.PictureRecorder recorder = new ui.PictureRecorder();
+  final ui.Canvas canvas = new ui.Canvas(recorder, bounds);
+  canvas.drawRect(bounds, new ui.Paint()..color = const ui.Color(0x40FFFFFF));
+  return recorder.endRecording();
+}
+
+void beginFrame(Duration timeStamp) {
+  final double devicePixelRatio = ui.window.devicePixelRatio;
+  final ui.Size logicalSize = ui.window.physicalSize / devicePixelRatio;
+  final ui.Rect paintBounds = ui.Point.origin & logicalSize;
+  if (backdrop == null || backdropSize != logicalSize) {
+    backdrop = recordBackdrop(paintBounds);
+    backdropSize = logicalSize;
+  }
+
+  final int index = frameCount ~/ kFramesPerConfiguration;
+  final Configuration configuration =
+      configurations[index % configurations.length];
+  final int frameInConfiguration = frameCount % kFramesPerConfiguration;
+  measureFrame(frameInConfiguration);
+  if (frameInConfiguration == kFramesPerConfiguration - 1)
+    report(configuration);
+  ++frameCount;
+
+  final double scroll = configuration.animateBackdrop
+      ? (timeStamp.inMilliseconds % 2000) / 2000.0 * 100.0
+      : 0.0;
+  final ui.Rect barBounds =
+      new ui.Rect.fromLTWH(0.0, 0.0, logicalSize.width, logicalSize.height / 3.0);
+
+  final Float64List deviceTransform = new Float64List(16)
+    ..[0] = devicePixelRatio
+    ..[5] = devicePixelRatio
+    ..[10] = 1.0
+    ..[15] = 1.0;
+  final ui.SceneBuilder sceneBuilder = new ui.SceneBuilder()
+    ..pushTransform(deviceTransform)
+    ..addPicture(new ui.Offset(0.0, -scroll), backdrop)
+    ..pushClipRect(barBounds)
+    ..pushBackdropFilter(
+        new ui.ImageFilter.blur(sigmaX: configuration.sigma,
+                                sigmaY: configuration.sigma),
+        downsampleHint: configuration.downsample)
+    ..addPicture(ui.Offset.zero, recordBar(barBounds))
+    ..pop()
+    ..pop()
+    ..addPerformanceOverlay(0x03, new ui.Rect.fromLTWH(
+        0.0, logicalSize.height - 120.0, logicalSize.width, 120.0))
+    ..pop();
+  ui.window.render(sceneBuilder.build());
+  ui.window.scheduleFrame();
+}
+
+void main() {
+  ui.window.onBeginFrame = beginFrame;
+  ui.window.scheduleFrame();
+}
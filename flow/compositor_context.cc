@@ -42,7 +42,8 @@ CompositorContext::ScopedFrame::ScopedFrame(CompositorContext& context,
     : context_(context),
       gr_context_(gr_context),
       canvas_(&canvas),
-      instrumentation_enabled_(instrumentation_enabled) {
+      instrumentation_enabled_(instrumentation_enabled),
+      profile_(nullptr) {
   context_.BeginFrame(*this, instrumentation_enabled_);
 }
 
@@ -16,6 +16,8 @@
 
 namespace flow {
 
+class FrameProfile;
+
 class CompositorContext {
  public:
   class ScopedFrame {
@@ -26,6 +28,11 @@ class CompositorContext {
 
     GrContext* gr_context() const { return gr_context_; }
 
+    // Set to have the frame's layers profiled, e.g. to diagnose slow frames.
+    FrameProfile* profile() const { return profile_; }
+
+    void set_profile(FrameProfile* profile) { profile_ = profile; }
+
     ScopedFrame(ScopedFrame&& frame);
 
     ~ScopedFrame();
@@ -35,6 +42,7 @@ class CompositorContext {
     GrContext* gr_context_;
     SkCanvas* canvas_;
     const bool instrumentation_enabled_;
+    FrameProfile* profile_;
 
     ScopedFrame(CompositorContext& context,
                 GrContext* gr_context,
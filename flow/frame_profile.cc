@@ -0,0 +1,96 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_profile.h"
+
+#include "flutter/flow/layers/layer.h"
+#include "lib/ftl/logging.h"
+
+namespace flow {
+
+FrameProfile::ScopedPreroll::ScopedPreroll(FrameProfile* profile,
+                                           const Layer* layer)
+    : profile_(profile), index_(kNoLayer), parent_index_(kNoLayer) {
+  if (!profile_)
+    return;
+  index_ = profile_->AddLayer(layer);
+  parent_index_ = profile_->current_index_;
+  profile_->current_index_ = index_;
+  profile_->current_depth_++;
+  start_ = ftl::TimePoint::Now();
+}
+
+FrameProfile::ScopedPreroll::~ScopedPreroll() {
+  if (!profile_)
+    return;
+  profile_->layers_[index_].preroll_time = ftl::TimePoint::Now() - start_;
+  profile_->current_index_ = parent_index_;
+  profile_->current_depth_--;
+}
+
+FrameProfile::ScopedPaint::ScopedPaint(FrameProfile* profile,
+                                       const Layer* layer)
+    : entry_(nullptr) {
+  if (!profile)
+    return;
+  auto it = profile->layer_indices_.find(layer);
+  if (it == profile->layer_indices_.end())
+    return;
+  entry_ = &profile->layers_[it->second];
+  start_ = ftl::TimePoint::Now();
+}
+
+FrameProfile::ScopedPaint::~ScopedPaint() {
+  if (!entry_)
+    return;
+  entry_->painted = true;
+  entry_->paint_time = entry_->paint_time + (ftl::TimePoint::Now() - start_);
+}
+
+FrameProfile::FrameProfile(size_t frame_number)
+    : frame_number_(frame_number),
+      frame_size_(SkISize::MakeEmpty()),
+      current_index_(kNoLayer),
+      current_depth_(0) {}
+
+FrameProfile::~FrameProfile() = default;
+
+size_t FrameProfile::AddLayer(const Layer* layer) {
+  size_t index = layers_.size();
+  layers_.emplace_back();
+  layers_.back().type_name = layer->GetTypeName();
+  layers_.back().depth = current_depth_;
+  entry_layers_.push_back(layer);
+  layer_indices_[layer] = index;
+  return index;
+}
+
+void FrameProfile::AddCulledLayer(const Layer* layer) {
+  layers_[AddLayer(layer)].culled = true;
+}
+
+void FrameProfile::SetRasterCacheResult(RasterCache::ImageResult result) {
+  if (current_index_ == kNoLayer)
+    return;
+  LayerEntry& entry = layers_[current_index_];
+  entry.has_raster_cache_result = true;
+  entry.raster_cache_result = result;
+}
+
+void FrameProfile::Finish(const SkISize& frame_size,
+                          ftl::TimeDelta build_time,
+                          ftl::TimeDelta raster_time) {
+  FTL_DCHECK(current_index_ == kNoLayer);
+  frame_size_ = frame_size;
+  build_time_ = build_time;
+  raster_time_ = raster_time;
+  for (size_t i = 0; i < layers_.size(); ++i) {
+    if (entry_layers_[i]->has_paint_bounds())
+      layers_[i].paint_bounds = entry_layers_[i]->paint_bounds();
+  }
+  entry_layers_.clear();
+  layer_indices_.clear();
+}
+
+}  // namespace flow
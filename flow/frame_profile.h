@@ -0,0 +1,119 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_FRAME_PROFILE_H_
+#define FLUTTER_FLOW_FRAME_PROFILE_H_
+
+#include <stdint.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/flow/raster_cache.h"
+#include "lib/ftl/macros.h"
+#include "lib/ftl/time/time_delta.h"
+#include "lib/ftl/time/time_point.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flow {
+
+class Layer;
+
+// How long each layer of a frame took to preroll and paint, and what the
+// raster cache did with its pictures. Filled in on the GPU thread while the
+// frame is drawn; once Finish() has been called the profile no longer refers
+// to the layers and may be read on any thread.
+class FrameProfile {
+ public:
+  struct LayerEntry {
+    const char* type_name = nullptr;
+    // The number of ancestors. Entries are in the order the layers were
+    // prerolled, so each layer is followed by its descendants.
+    int depth = 0;
+    // The preroll skipped the layer and its descendants as out of view.
+    bool culled = false;
+    bool painted = false;
+    SkRect paint_bounds = SkRect::MakeEmpty();
+    ftl::TimeDelta preroll_time;
+    ftl::TimeDelta paint_time;
+    bool has_raster_cache_result = false;
+    RasterCache::ImageResult raster_cache_result =
+        RasterCache::ImageResult::kEmpty;
+  };
+
+  // Times the preroll of |layer|, including its descendants. Does nothing if
+  // |profile| is null.
+  class ScopedPreroll {
+   public:
+    ScopedPreroll(FrameProfile* profile, const Layer* layer);
+    ~ScopedPreroll();
+
+   private:
+    FrameProfile* profile_;
+    size_t index_;
+    size_t parent_index_;
+    ftl::TimePoint start_;
+
+    FTL_DISALLOW_COPY_AND_ASSIGN(ScopedPreroll);
+  };
+
+  // Times the painting of |layer|, including its descendants. Does nothing if
+  // |profile| is null.
+  class ScopedPaint {
+   public:
+    ScopedPaint(FrameProfile* profile, const Layer* layer);
+    ~ScopedPaint();
+
+   private:
+    LayerEntry* entry_;
+    ftl::TimePoint start_;
+
+    FTL_DISALLOW_COPY_AND_ASSIGN(ScopedPaint);
+  };
+
+  explicit FrameProfile(size_t frame_number);
+  ~FrameProfile();
+
+  // Records a layer that was not prerolled because it is out of view.
+  void AddCulledLayer(const Layer* layer);
+
+  // Applies to the layer being prerolled.
+  void SetRasterCacheResult(RasterCache::ImageResult result);
+
+  // Records the frame's totals and the final bounds of its layers. Called
+  // after the frame has been drawn, while its layers are still alive.
+  void Finish(const SkISize& frame_size,
+              ftl::TimeDelta build_time,
+              ftl::TimeDelta raster_time);
+
+  size_t frame_number() const { return frame_number_; }
+  const SkISize& frame_size() const { return frame_size_; }
+  ftl::TimeDelta build_time() const { return build_time_; }
+  ftl::TimeDelta raster_time() const { return raster_time_; }
+  const std::vector<LayerEntry>& layers() const { return layers_; }
+
+ private:
+  static const size_t kNoLayer = static_cast<size_t>(-1);
+
+  size_t AddLayer(const Layer* layer);
+
+  size_t frame_number_;
+  SkISize frame_size_;
+  ftl::TimeDelta build_time_;
+  ftl::TimeDelta raster_time_;
+  std::vector<LayerEntry> layers_;
+
+  // Only valid until Finish().
+  std::vector<const Layer*> entry_layers_;
+  std::unordered_map<const Layer*, size_t> layer_indices_;
+  size_t current_index_;
+  int current_depth_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(FrameProfile);
+};
+
+}  // namespace flow
+
+#endif  // FLUTTER_FLOW_FRAME_PROFILE_H_
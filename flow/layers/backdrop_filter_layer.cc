@@ -5,19 +5,145 @@
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 
 #include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace flow {
 
+static const int kDownsampleScale = 2;
+
 BackdropFilterLayer::BackdropFilterLayer() {}
 
 BackdropFilterLayer::~BackdropFilterLayer() {}
 
+const char* BackdropFilterLayer::GetTypeName() const {
+  return "BackdropFilterLayer";
+}
+
+void BackdropFilterLayer::Preroll(PrerollContext* context,
+                                  const SkMatrix& matrix) {
+  // The backdrop is everything painted before this layer.
+  PaintSignature* signature = context->paint_signature;
+  signature->Add(matrix);
+  raster_cache_ = signature->is_stable() ? context->raster_cache : nullptr;
+  backdrop_signature_ = signature->value();
+  inside_save_layer_ = context->inside_save_layer;
+
+  signature->Add(reinterpret_cast<uintptr_t>(filter_.get()));
+  context->inside_save_layer = true;
+  ContainerLayer::Preroll(context, matrix);
+}
+
 void BackdropFilterLayer::Paint(PaintContext& context) {
   TRACE_EVENT0("flutter", "BackdropFilterLayer::Paint");
-  SkAutoCanvasRestore save(&context.canvas, false);
-  context.canvas.saveLayer(
-      SkCanvas::SaveLayerRec{&paint_bounds(), nullptr, filter_.get(), 0});
+  SkIRect device_bounds;
+  sk_sp<SkImage> backdrop = GetFilteredBackdrop(context, &device_bounds);
+  if (!backdrop) {
+    SkAutoCanvasRestore save(&context.canvas, false);
+    context.canvas.saveLayer(
+        SkCanvas::SaveLayerRec{&paint_bounds(), nullptr, filter_.get(), 0});
+    PaintChildren(context);
+    return;
+  }
+
+  SkAutoCanvasRestore save(&context.canvas, true);
+  {
+    SkAutoCanvasRestore device_space(&context.canvas, true);
+    context.canvas.resetMatrix();
+    SkPaint paint;
+    paint.setFilterQuality(kLow_SkFilterQuality);
+    context.canvas.drawImageRect(backdrop.get(), SkRect::Make(device_bounds),
+                                 &paint);
+  }
+  // The children draw over the filtered backdrop just as they would over
+  // the layer the backdrop filter would have started them in.
+  context.canvas.clipRect(paint_bounds());
   PaintChildren(context);
 }
 
+sk_sp<SkImage> BackdropFilterLayer::GetFilteredBackdrop(
+    PaintContext& context,
+    SkIRect* device_bounds) {
+  if (!raster_cache_ && !downsample_)
+    return nullptr;
+
+  // Filtering separately reads the backdrop from the frame's surface, which
+  // only holds it when no other layer is being drawn into. Device bounds
+  // only describe the layer if it is axis-aligned.
+  SkCanvas& canvas = context.canvas;
+  SkSurface* surface = canvas.getSurface();
+  const SkMatrix& ctm = canvas.getTotalMatrix();
+  if (inside_save_layer_ || !surface || !ctm.isScaleTranslate())
+    return nullptr;
+
+  SkRect bounds;
+  ctm.mapRect(&bounds, paint_bounds());
+  bounds.roundOut(device_bounds);
+  SkIRect clip_bounds;
+  if (!canvas.getClipDeviceBounds(&clip_bounds) ||
+      !device_bounds->intersect(clip_bounds))
+    return nullptr;
+
+  RasterCache::BackdropKey key = {filter_.get(), *device_bounds, downsample_,
+                                  backdrop_signature_};
+  bool should_cache = false;
+  if (raster_cache_) {
+    if (sk_sp<SkImage> image =
+            raster_cache_->GetFilteredBackdrop(key, &should_cache))
+      return image;
+  }
+  if (!should_cache && !downsample_)
+    return nullptr;
+
+  sk_sp<SkImage> image = RenderFilteredBackdrop(surface, ctm, *device_bounds);
+  if (image && should_cache)
+    raster_cache_->SetFilteredBackdrop(key, image);
+  return image;
+}
+
+sk_sp<SkImage> BackdropFilterLayer::RenderFilteredBackdrop(
+    SkSurface* surface,
+    const SkMatrix& ctm,
+    const SkIRect& device_bounds) {
+  TRACE_EVENT2("flutter", "BackdropFilterLayer::RenderFilteredBackdrop",
+               "width", device_bounds.width(), "height",
+               device_bounds.height());
+  const int scale = downsample_ ? kDownsampleScale : 1;
+  SkImageInfo info = SkImageInfo::MakeN32Premul(
+      (device_bounds.width() + scale - 1) / scale,
+      (device_bounds.height() + scale - 1) / scale);
+  sk_sp<SkSurface> target = surface->makeSurface(info);
+  if (!target)
+    return nullptr;
+
+  // The filter is specified in the layer's coordinates, so scale it to device
+  // pixels as saveLayer() would. The downsampling scale below then applies
+  // on top, shrinking the blur along with the image.
+  sk_sp<SkImageFilter> filter = filter_->makeWithLocalMatrix(
+      SkMatrix::MakeScale(ctm.getScaleX(), ctm.getScaleY()));
+
+  // Only the pixels the filter reads to produce |device_bounds| are copied
+  // out of the surface. The full snapshot is dropped before anything draws
+  // to the surface again, so it never costs a copy of the whole surface.
+  SkIRect source_bounds = filter->filterBounds(
+      device_bounds, SkMatrix::I(), SkImageFilter::kReverse_MapDirection);
+  if (!source_bounds.intersect(
+          SkIRect::MakeWH(surface->width(), surface->height())))
+    return nullptr;
+  sk_sp<SkImage> backdrop =
+      surface->makeImageSnapshot()->makeSubset(source_bounds);
+  if (!backdrop)
+    return nullptr;
+
+  SkCanvas* canvas = target->getCanvas();
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->scale(1.0f / scale, 1.0f / scale);
+  canvas->translate(-device_bounds.x(), -device_bounds.y());
+
+  SkPaint paint;
+  paint.setImageFilter(std::move(filter));
+  canvas->drawImage(backdrop.get(), source_bounds.x(), source_bounds.y(),
+                    &paint);
+  return target->makeImageSnapshot();
+}
+
 }  // namespace flow
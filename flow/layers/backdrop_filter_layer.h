@@ -7,6 +7,8 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+class SkSurface;
+
 namespace flow {
 
 class BackdropFilterLayer : public ContainerLayer {
@@ -16,11 +18,29 @@ class BackdropFilterLayer : public ContainerLayer {
 
   void set_filter(sk_sp<SkImageFilter> filter) { filter_ = std::move(filter); }
 
+  // Allows the backdrop to be filtered at reduced resolution and scaled back
+  // up, which is much cheaper for large blurs and hardly visible.
+  void set_downsample(bool downsample) { downsample_ = downsample; }
+
  protected:
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
+  const char* GetTypeName() const override;
 
  private:
+  sk_sp<SkImage> GetFilteredBackdrop(PaintContext& context,
+                                     SkIRect* device_bounds);
+  sk_sp<SkImage> RenderFilteredBackdrop(SkSurface* surface,
+                                        const SkMatrix& ctm,
+                                        const SkIRect& device_bounds);
+
   sk_sp<SkImageFilter> filter_;
+  bool downsample_ = false;
+
+  // Set by Preroll() for the current frame.
+  RasterCache* raster_cache_ = nullptr;
+  uint64_t backdrop_signature_ = 0;
+  bool inside_save_layer_ = false;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(BackdropFilterLayer);
 };
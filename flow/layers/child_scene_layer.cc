@@ -39,11 +39,21 @@ ChildSceneLayer::ChildSceneLayer() : device_pixel_ratio_(1.0f) {}
 
 ChildSceneLayer::~ChildSceneLayer() {}
 
+const char* ChildSceneLayer::GetTypeName() const {
+  return "ChildSceneLayer";
+}
+
 void ChildSceneLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  context->paint_signature->AddVolatile();
   transform_ = matrix;
   transform_.preTranslate(offset_.x(), offset_.y());
   float inverse_device_pixel_ratio = 1.f / device_pixel_ratio_;
   transform_.preScale(inverse_device_pixel_ratio, inverse_device_pixel_ratio);
+
+  context->child_paint_bounds = SkRect::MakeXYWH(
+      offset_.x(), offset_.y(),
+      physical_size_.width() * inverse_device_pixel_ratio,
+      physical_size_.height() * inverse_device_pixel_ratio);
 }
 
 void ChildSceneLayer::Paint(PaintContext& context) {
@@ -29,6 +29,7 @@ class ChildSceneLayer : public Layer {
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
+  const char* GetTypeName() const override;
   void UpdateScene(mozart::SceneUpdate* update,
                    mozart::Node* container) override;
 
@@ -10,7 +10,16 @@ ClipPathLayer::ClipPathLayer() {}
 
 ClipPathLayer::~ClipPathLayer() {}
 
+const char* ClipPathLayer::GetTypeName() const {
+  return "ClipPathLayer";
+}
+
 void ClipPathLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  context->paint_signature->Add(clip_path_.getGenerationID());
+  context->paint_signature->Add(matrix);
+  context->inside_save_layer = true;
+  if (!context->cull_rect.intersect(clip_path_.getBounds()))
+    context->cull_rect.setEmpty();
   PrerollChildren(context, matrix);
   if (!context->child_paint_bounds.intersect(clip_path_.getBounds()))
     context->child_paint_bounds.setEmpty();
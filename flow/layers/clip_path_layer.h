@@ -19,6 +19,7 @@ class ClipPathLayer : public ContainerLayer {
  protected:
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
+  const char* GetTypeName() const override;
 
  private:
   SkPath clip_path_;
@@ -10,7 +10,15 @@ ClipRectLayer::ClipRectLayer() {}
 
 ClipRectLayer::~ClipRectLayer() {}
 
+const char* ClipRectLayer::GetTypeName() const {
+  return "ClipRectLayer";
+}
+
 void ClipRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  context->paint_signature->Add(&clip_rect_, sizeof(clip_rect_));
+  context->paint_signature->Add(matrix);
+  if (!context->cull_rect.intersect(clip_rect_))
+    context->cull_rect.setEmpty();
   PrerollChildren(context, matrix);
   if (!context->child_paint_bounds.intersect(clip_rect_))
     context->child_paint_bounds.setEmpty();
@@ -10,7 +10,16 @@ ClipRRectLayer::ClipRRectLayer() {}
 
 ClipRRectLayer::~ClipRRectLayer() {}
 
+const char* ClipRRectLayer::GetTypeName() const {
+  return "ClipRRectLayer";
+}
+
 void ClipRRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  context->paint_signature->Add(&clip_rrect_, sizeof(clip_rrect_));
+  context->paint_signature->Add(matrix);
+  context->inside_save_layer = true;
+  if (!context->cull_rect.intersect(clip_rrect_.getBounds()))
+    context->cull_rect.setEmpty();
   PrerollChildren(context, matrix);
   if (!context->child_paint_bounds.intersect(clip_rrect_.getBounds()))
     context->child_paint_bounds.setEmpty();
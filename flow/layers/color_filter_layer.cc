@@ -10,6 +10,18 @@ ColorFilterLayer::ColorFilterLayer() {}
 
 ColorFilterLayer::~ColorFilterLayer() {}
 
+const char* ColorFilterLayer::GetTypeName() const {
+  return "ColorFilterLayer";
+}
+
+void ColorFilterLayer::Preroll(PrerollContext* context,
+                               const SkMatrix& matrix) {
+  context->paint_signature->Add(color_);
+  context->paint_signature->Add(static_cast<uint64_t>(blend_mode_));
+  context->inside_save_layer = true;
+  ContainerLayer::Preroll(context, matrix);
+}
+
 void ColorFilterLayer::Paint(PaintContext& context) {
   TRACE_EVENT0("flutter", "ColorFilterLayer::Paint");
   sk_sp<SkColorFilter> color_filter =
@@ -19,7 +19,9 @@ class ColorFilterLayer : public ContainerLayer {
   void set_blend_mode(SkBlendMode blend_mode) { blend_mode_ = blend_mode; }
 
  protected:
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
+  const char* GetTypeName() const override;
 
  private:
   SkColor color_;
@@ -4,14 +4,17 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/flow/frame_profile.h"
+
 namespace flow {
 
+static const uint64_t kEndOfChildrenSignature = 0xe0c;
+
 ContainerLayer::ContainerLayer() {}
 
 ContainerLayer::~ContainerLayer() {}
 
-void ContainerLayer::Add(std::unique_ptr<Layer> layer) {
-  layer->set_parent(this);
+void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
   layers_.push_back(std::move(layer));
 }
 
@@ -23,27 +26,55 @@ void ContainerLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 
 void ContainerLayer::PrerollChildren(PrerollContext* context,
                                      const SkMatrix& matrix) {
-  SkRect child_paint_bounds;
+  SkRect child_paint_bounds = SkRect::MakeEmpty();
   for (auto& layer : layers_) {
+    // A layer prerolled in an earlier frame, typically as part of a retained
+    // subtree, already knows its bounds. If they are out of view, neither it
+    // nor anything below it needs to be visited.
+    if (layer->has_paint_bounds() &&
+        !SkRect::Intersects(layer->paint_bounds(), context->cull_rect)) {
+      layer->set_needs_painting(false);
+      child_paint_bounds.join(layer->paint_bounds());
+      if (context->profile)
+        context->profile->AddCulledLayer(layer.get());
+      continue;
+    }
+
     PrerollContext child_context = *context;
-    layer->Preroll(&child_context, matrix);
+    {
+      FrameProfile::ScopedPreroll profile_scope(context->profile, layer.get());
+      layer->Preroll(&child_context, matrix);
+    }
+    layer->set_paint_bounds(child_context.child_paint_bounds);
+    layer->set_needs_painting(
+        SkRect::Intersects(child_context.child_paint_bounds,
+                           context->cull_rect));
     child_paint_bounds.join(child_context.child_paint_bounds);
   }
   context->child_paint_bounds = child_paint_bounds;
+
+  // Separates what is painted inside this layer from what follows it.
+  context->paint_signature->Add(kEndOfChildrenSignature);
 }
 
 void ContainerLayer::PaintChildren(PaintContext& context) const {
   // Intentionally not tracing here as there should be no self-time
   // and the trace event on this common function has a small overhead.
-  for (auto& layer : layers_)
-    layer->Paint(context);
+  for (auto& layer : layers_) {
+    if (layer->needs_painting()) {
+      FrameProfile::ScopedPaint profile_scope(context.profile, layer.get());
+      layer->Paint(context);
+    }
+  }
 }
 
 #if defined(OS_FUCHSIA)
 void ContainerLayer::UpdateScene(mozart::SceneUpdate* update,
                                  mozart::Node* container) {
-  for (auto& layer : layers_)
-    layer->UpdateScene(update, container);
+  for (auto& layer : layers_) {
+    if (layer->needs_painting())
+      layer->UpdateScene(update, container);
+  }
 }
 #endif
 
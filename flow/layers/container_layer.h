@@ -15,7 +15,7 @@ class ContainerLayer : public Layer {
   ContainerLayer();
   ~ContainerLayer() override;
 
-  void Add(std::unique_ptr<Layer> layer);
+  void Add(std::shared_ptr<Layer> layer);
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void PrerollChildren(PrerollContext* context, const SkMatrix& matrix);
@@ -27,10 +27,10 @@ class ContainerLayer : public Layer {
                    mozart::Node* container) override;
 #endif
 
-  const std::vector<std::unique_ptr<Layer>>& layers() const { return layers_; }
+  const std::vector<std::shared_ptr<Layer>>& layers() const { return layers_; }
 
  private:
-  std::vector<std::unique_ptr<Layer>> layers_;
+  std::vector<std::shared_ptr<Layer>> layers_;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
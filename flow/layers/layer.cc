@@ -8,11 +8,27 @@
 
 namespace flow {
 
-Layer::Layer() : parent_(nullptr), has_paint_bounds_(false), paint_bounds_() {}
+Layer::Layer()
+    : has_paint_bounds_(false), needs_painting_(true), paint_bounds_() {}
 
 Layer::~Layer() {}
 
-void Layer::Preroll(PrerollContext* context, const SkMatrix& matrix) {}
+void Layer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  context->child_paint_bounds =
+      has_paint_bounds() ? paint_bounds() : SkRect::MakeEmpty();
+}
+
+bool Layer::CanPaintWithAlpha() const {
+  return false;
+}
+
+void Layer::PaintWithAlpha(PaintContext& context, SkAlpha alpha) {
+  FTL_NOTREACHED();
+}
+
+const char* Layer::GetTypeName() const {
+  return "Layer";
+}
 
 #if defined(OS_FUCHSIA)
 void Layer::UpdateScene(mozart::SceneUpdate* update, mozart::Node* container) {}
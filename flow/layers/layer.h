@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "flutter/flow/instrumentation.h"
+#include "flutter/flow/paint_signature.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/glue/trace_event.h"
 #include "lib/ftl/build_config.h"
@@ -33,7 +34,12 @@ class Node;
 
 namespace flow {
 
-class ContainerLayer;
+class FrameProfile;
+
+// Layers are shared between the trees of successive frames when the
+// framework retains a subtree, so a layer has no single parent and must not
+// hold state specific to one tree. Layers are only prerolled and painted on
+// the GPU thread, one frame at a time.
 class Layer {
  public:
   Layer();
@@ -43,28 +49,54 @@ class Layer {
     RasterCache* raster_cache;
     GrContext* gr_context;
     SkRect child_paint_bounds;
+    // The part of the frame that may be visible, in the coordinate space of
+    // the layer being prerolled.
+    SkRect cull_rect;
+    // Accumulates what the frame paints. Shared by the whole preroll.
+    PaintSignature* paint_signature;
+    // Whether an ancestor paints into a separate layer, so the frame's
+    // surface does not hold the layer's backdrop.
+    bool inside_save_layer;
+    // Collects per-layer timings when the frame is being profiled, else null.
+    FrameProfile* profile;
   };
 
+  // Prepares the layer for painting and reports its paint bounds through
+  // |context->child_paint_bounds|. Layers that do not change once built may
+  // rely on their parent to record the result with set_paint_bounds() and to
+  // skip prerolling them again while those bounds are outside the cull rect.
   virtual void Preroll(PrerollContext* context, const SkMatrix& matrix);
 
   struct PaintContext {
     SkCanvas& canvas;
     const Stopwatch& frame_time;
     const Stopwatch& engine_time;
+    FrameProfile* profile;
   };
 
   virtual void Paint(PaintContext& context) = 0;
 
+  // Whether the layer can apply a group opacity to what it draws by itself,
+  // without an offscreen buffer, because none of its drawing overlaps. Only
+  // valid after Preroll().
+  virtual bool CanPaintWithAlpha() const;
+
+  // Paints the layer with |alpha| applied on top of its own opacity. Only
+  // called on layers for which CanPaintWithAlpha() is true.
+  virtual void PaintWithAlpha(PaintContext& context, SkAlpha alpha);
+
+  // Names the kind of layer in diagnostics, e.g. "OpacityLayer".
+  virtual const char* GetTypeName() const;
+
 #if defined(OS_FUCHSIA)
   virtual void UpdateScene(mozart::SceneUpdate* update,
                            mozart::Node* container);
 #endif
 
-  ContainerLayer* parent() const { return parent_; }
-
-  void set_parent(ContainerLayer* parent) { parent_ = parent; }
-
   // subclasses should assume this will be true by the time Paint() is called
+  // for a layer that needs painting. The bounds are in the coordinate space
+  // of the parent and, since layers do not change once built, stay valid for
+  // the life of the layer.
   bool has_paint_bounds() const { return has_paint_bounds_; }
 
   const SkRect& paint_bounds() const {
@@ -77,9 +109,18 @@ class Layer {
     paint_bounds_ = paint_bounds;
   }
 
+  // Whether the last preroll found the layer to be visible. Layers that are
+  // not were skipped by the preroll and must not be painted, since any state
+  // they hold is left over from an earlier frame.
+  bool needs_painting() const { return needs_painting_; }
+
+  void set_needs_painting(bool needs_painting) {
+    needs_painting_ = needs_painting;
+  }
+
  private:
-  ContainerLayer* parent_;
   bool has_paint_bounds_;  // if false, paint_bounds_ is not valid
+  bool needs_painting_;
   SkRect paint_bounds_;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(Layer);
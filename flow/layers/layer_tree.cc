@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/layer_tree.h"
 
+#include "flutter/flow/frame_profile.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/glue/trace_event.h"
 
@@ -28,10 +29,20 @@ void LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
   TRACE_EVENT0("flutter", "LayerTree::Preroll");
   frame.context().raster_cache().SetCheckboardCacheImages(
       checkerboard_raster_cache_images_);
+  SkRect cull_rect = frame_size_.isEmpty()
+                         ? SkRect::MakeLargest()
+                         : SkRect::Make(frame_size_);
+  PaintSignature paint_signature;
   Layer::PrerollContext context = {
       ignore_raster_cache ? nullptr : &frame.context().raster_cache(),
-      frame.gr_context(), SkRect::MakeEmpty(),
+      frame.gr_context(),
+      SkRect::MakeEmpty(),
+      cull_rect,
+      &paint_signature,
+      false,
+      frame.profile(),
   };
+  FrameProfile::ScopedPreroll profile_scope(frame.profile(), root_layer_.get());
   root_layer_->Preroll(&context, SkMatrix());
 }
 
@@ -45,8 +56,10 @@ void LayerTree::UpdateScene(mozart::SceneUpdate* update,
 
 void LayerTree::Paint(CompositorContext::ScopedFrame& frame) {
   Layer::PaintContext context = {frame.canvas(), frame.context().frame_time(),
-                                 frame.context().engine_time()};
+                                 frame.context().engine_time(),
+                                 frame.profile()};
   TRACE_EVENT0("flutter", "LayerTree::Paint");
+  FrameProfile::ScopedPaint profile_scope(frame.profile(), root_layer_.get());
   root_layer_->Paint(context);
 }
 
@@ -41,7 +41,12 @@ class LayerTree {
 
   Layer* root_layer() const { return root_layer_.get(); }
 
-  void set_root_layer(std::unique_ptr<Layer> root_layer) {
+  // The root may be shared with other trees, such as a snapshot of this one.
+  const std::shared_ptr<Layer>& shared_root_layer() const {
+    return root_layer_;
+  }
+
+  void set_root_layer(std::shared_ptr<Layer> root_layer) {
     root_layer_ = std::move(root_layer);
   }
 
@@ -79,7 +84,7 @@ class LayerTree {
  private:
   SkISize frame_size_;  // Physical pixels.
   uint32_t scene_version_;
-  std::unique_ptr<Layer> root_layer_;
+  std::shared_ptr<Layer> root_layer_;
   ftl::TimeDelta construction_time_;
   uint32_t rasterizer_tracing_threshold_;
   bool checkerboard_raster_cache_images_;
@@ -4,14 +4,40 @@
 
 #include "flutter/flow/layers/opacity_layer.h"
 
+#include "third_party/skia/include/core/SkMath.h"
+
 namespace flow {
 
 OpacityLayer::OpacityLayer() {}
 
 OpacityLayer::~OpacityLayer() {}
 
+const char* OpacityLayer::GetTypeName() const {
+  return "OpacityLayer";
+}
+
+void OpacityLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  context->paint_signature->Add(alpha_);
+  context->inside_save_layer = true;
+  ContainerLayer::Preroll(context, matrix);
+}
+
 void OpacityLayer::Paint(PaintContext& context) {
   TRACE_EVENT0("flutter", "OpacityLayer::Paint");
+  if (!alpha_)
+    return;
+  if (alpha_ == 255) {
+    PaintChildren(context);
+    return;
+  }
+
+  // Fading a single cached picture, possibly under transforms, is the common
+  // case and needs no offscreen buffer; the alpha goes on the draw itself.
+  if (CanPaintWithAlpha()) {
+    PaintWithAlpha(context, 255);
+    return;
+  }
+
   SkPaint paint;
   paint.setAlpha(alpha_);
 
@@ -20,4 +46,15 @@ void OpacityLayer::Paint(PaintContext& context) {
   PaintChildren(context);
 }
 
+bool OpacityLayer::CanPaintWithAlpha() const {
+  return layers().size() == 1 && layers().front()->CanPaintWithAlpha();
+}
+
+void OpacityLayer::PaintWithAlpha(PaintContext& context, SkAlpha alpha) {
+  Layer* child = layers().front().get();
+  if (!child->needs_painting())
+    return;
+  child->PaintWithAlpha(context, SkMulDiv255Round(alpha, alpha_));
+}
+
 }  // namespace flow
@@ -16,8 +16,13 @@ class OpacityLayer : public ContainerLayer {
 
   void set_alpha(int alpha) { alpha_ = alpha; }
 
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+  bool CanPaintWithAlpha() const override;
+  void PaintWithAlpha(PaintContext& context, SkAlpha alpha) override;
+
  protected:
   void Paint(PaintContext& context) override;
+  const char* GetTypeName() const override;
 
  private:
   int alpha_;
@@ -62,6 +62,17 @@ void VisualizeStopWatch(SkCanvas& canvas,
 PerformanceOverlayLayer::PerformanceOverlayLayer(uint64_t options)
     : options_(options) {}
 
+const char* PerformanceOverlayLayer::GetTypeName() const {
+  return "PerformanceOverlayLayer";
+}
+
+void PerformanceOverlayLayer::Preroll(PrerollContext* context,
+                                      const SkMatrix& matrix) {
+  // The statistics change every frame.
+  context->paint_signature->AddVolatile();
+  Layer::Preroll(context, matrix);
+}
+
 void PerformanceOverlayLayer::Paint(PaintContext& context) {
   if (!options_)
     return;
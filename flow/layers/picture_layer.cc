@@ -5,6 +5,7 @@
 #include "flutter/flow/layers/picture_layer.h"
 
 #include "flutter/common/threads.h"
+#include "flutter/flow/frame_profile.h"
 #include "flutter/flow/raster_cache.h"
 #include "lib/ftl/logging.h"
 
@@ -19,14 +20,33 @@ PictureLayer::~PictureLayer() {
   blink::Threads::IO()->PostTask([picture]() { picture->unref(); });
 }
 
+const char* PictureLayer::GetTypeName() const {
+  return "PictureLayer";
+}
+
 void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  SkRect bounds = picture_->cullRect().makeOffset(offset_.x(), offset_.y());
+
+  PaintSignature* signature = context->paint_signature;
+  signature->Add(picture_->uniqueID());
+  signature->Add(&offset_, sizeof(offset_));
+  signature->Add(matrix);
+
+  // Pictures out of view are not painted, so there is no point in caching
+  // them.
+  image_ = nullptr;
   if (auto cache = context->raster_cache) {
-    image_ = cache->GetPrerolledImage(context->gr_context, picture_.get(),
-                                      matrix, is_complex_, will_change_);
+    if (SkRect::Intersects(bounds, context->cull_rect)) {
+      RasterCache::ImageResult result;
+      image_ = cache->GetPrerolledImage(context->gr_context, picture_.get(),
+                                        matrix, is_complex_, will_change_,
+                                        &result);
+      if (context->profile)
+        context->profile->SetRasterCacheResult(result);
+    }
   }
 
-  context->child_paint_bounds =
-      picture_->cullRect().makeOffset(offset_.x(), offset_.y());
+  context->child_paint_bounds = bounds;
 }
 
 void PictureLayer::Paint(PaintContext& context) {
@@ -46,4 +66,25 @@ void PictureLayer::Paint(PaintContext& context) {
   }
 }
 
+bool PictureLayer::CanPaintWithAlpha() const {
+  // A cached picture is a single image draw, which can take the alpha
+  // directly. Drawing the picture itself with a paint would make Skia
+  // allocate a layer anyway.
+  return !!image_;
+}
+
+void PictureLayer::PaintWithAlpha(PaintContext& context, SkAlpha alpha) {
+  FTL_DCHECK(image_);
+
+  TRACE_EVENT0("flutter", "PictureLayer::PaintWithAlpha");
+
+  SkPaint paint;
+  paint.setAlpha(alpha);
+
+  SkAutoCanvasRestore save(&context.canvas, true);
+  context.canvas.translate(offset_.x(), offset_.y());
+  context.canvas.drawImageRect(image_.get(), picture_->cullRect(), &paint,
+                               SkCanvas::kFast_SrcRectConstraint);
+}
+
 }  // namespace flow
@@ -24,6 +24,9 @@ class PictureLayer : public Layer {
 
   void Preroll(PrerollContext* frame, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
+  const char* GetTypeName() const override;
+  bool CanPaintWithAlpha() const override;
+  void PaintWithAlpha(PaintContext& context, SkAlpha alpha) override;
 
  private:
   SkPoint offset_;
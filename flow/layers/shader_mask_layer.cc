@@ -10,6 +10,21 @@ ShaderMaskLayer::ShaderMaskLayer() {}
 
 ShaderMaskLayer::~ShaderMaskLayer() {}
 
+const char* ShaderMaskLayer::GetTypeName() const {
+  return "ShaderMaskLayer";
+}
+
+void ShaderMaskLayer::Preroll(PrerollContext* context,
+                              const SkMatrix& matrix) {
+  PaintSignature* signature = context->paint_signature;
+  signature->Add(reinterpret_cast<uintptr_t>(shader_.get()));
+  signature->Add(&mask_rect_, sizeof(mask_rect_));
+  signature->Add(static_cast<uint64_t>(blend_mode_));
+  signature->Add(matrix);
+  context->inside_save_layer = true;
+  ContainerLayer::Preroll(context, matrix);
+}
+
 void ShaderMaskLayer::Paint(PaintContext& context) {
   TRACE_EVENT0("flutter", "ShaderMaskLayer::Paint");
   SkAutoCanvasRestore save(&context.canvas, false);
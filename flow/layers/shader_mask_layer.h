@@ -25,7 +25,9 @@ class ShaderMaskLayer : public ContainerLayer {
   }
 
  protected:
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
+  const char* GetTypeName() const override;
 
  private:
   sk_sp<SkShader> shader_;
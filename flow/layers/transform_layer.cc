@@ -10,9 +10,18 @@ TransformLayer::TransformLayer() {}
 
 TransformLayer::~TransformLayer() {}
 
+const char* TransformLayer::GetTypeName() const {
+  return "TransformLayer";
+}
+
 void TransformLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   SkMatrix childMatrix;
   childMatrix.setConcat(matrix, transform_);
+  SkMatrix inverse_transform;
+  if (transform_.invert(&inverse_transform))
+    inverse_transform.mapRect(&context->cull_rect);
+  else
+    context->cull_rect = SkRect::MakeLargest();
   PrerollChildren(context, childMatrix);
   transform_.mapRect(&context->child_paint_bounds);
 }
@@ -24,4 +33,17 @@ void TransformLayer::Paint(PaintContext& context) {
   PaintChildren(context);
 }
 
+bool TransformLayer::CanPaintWithAlpha() const {
+  return layers().size() == 1 && layers().front()->CanPaintWithAlpha();
+}
+
+void TransformLayer::PaintWithAlpha(PaintContext& context, SkAlpha alpha) {
+  Layer* child = layers().front().get();
+  if (!child->needs_painting())
+    return;
+  SkAutoCanvasRestore save(&context.canvas, true);
+  context.canvas.concat(transform_);
+  child->PaintWithAlpha(context, alpha);
+}
+
 }  // namespace flow
@@ -18,6 +18,9 @@ class TransformLayer : public ContainerLayer {
 
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
   void Paint(PaintContext& context) override;
+  const char* GetTypeName() const override;
+  bool CanPaintWithAlpha() const override;
+  void PaintWithAlpha(PaintContext& context, SkAlpha alpha) override;
 
  private:
   SkMatrix transform_;
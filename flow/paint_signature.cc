@@ -0,0 +1,31 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/paint_signature.h"
+
+#include "third_party/skia/include/core/SkMatrix.h"
+
+namespace flow {
+
+// 64-bit FNV-1a.
+static const uint64_t kOffsetBasis = 0xcbf29ce484222325ull;
+static const uint64_t kPrime = 0x100000001b3ull;
+
+PaintSignature::PaintSignature() : value_(kOffsetBasis), is_stable_(true) {}
+
+void PaintSignature::Add(const void* data, size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; ++i)
+    value_ = (value_ ^ bytes[i]) * kPrime;
+}
+
+void PaintSignature::Add(const SkMatrix& matrix) {
+  // SkMatrix also holds a lazily computed type mask, so only the values are
+  // hashed.
+  SkScalar values[9];
+  matrix.get9(values);
+  Add(values, sizeof(values));
+}
+
+}  // namespace flow
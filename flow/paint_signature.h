@@ -0,0 +1,46 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_PAINT_SIGNATURE_H_
+#define FLUTTER_FLOW_PAINT_SIGNATURE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lib/ftl/macros.h"
+
+class SkMatrix;
+
+namespace flow {
+
+// A running hash of what a frame paints, in paint order. Layers add their
+// parameters as they are prerolled, so an effect that reads back what lies
+// underneath it can tell whether that content is the same as in the last
+// frame without looking at any pixels.
+class PaintSignature {
+ public:
+  PaintSignature();
+
+  void Add(const void* data, size_t size);
+  void Add(uint64_t value) { Add(&value, sizeof(value)); }
+  void Add(const SkMatrix& matrix);
+
+  // Records content that cannot be described by its parameters, such as the
+  // performance overlay, so that nothing painted after it is considered
+  // stable.
+  void AddVolatile() { is_stable_ = false; }
+
+  uint64_t value() const { return value_; }
+  bool is_stable() const { return is_stable_; }
+
+ private:
+  uint64_t value_;
+  bool is_stable_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(PaintSignature);
+};
+
+}  // namespace flow
+
+#endif  // FLUTTER_FLOW_PAINT_SIGNATURE_H_
@@ -6,6 +6,7 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "flutter/common/threads.h"
@@ -76,11 +77,18 @@ RasterCache::Entry::Entry() {
 
 RasterCache::Entry::~Entry() {}
 
+RasterCache::BackdropEntry::BackdropEntry() {
+  device_bounds.setEmpty();
+}
+
+RasterCache::BackdropEntry::~BackdropEntry() {}
+
 sk_sp<SkImage> RasterCache::GetPrerolledImage(GrContext* context,
                                               SkPicture* picture,
                                               const SkMatrix& ctm,
                                               bool is_complex,
-                                              bool will_change) {
+                                              bool will_change,
+                                              ImageResult* result) {
   SkScalar scaleX = ctm.getScaleX();
   SkScalar scaleY = ctm.getScaleY();
 
@@ -89,8 +97,10 @@ sk_sp<SkImage> RasterCache::GetPrerolledImage(GrContext* context,
   SkISize physical_size =
       SkISize::Make(rect.width() * scaleX, rect.height() * scaleY);
 
-  if (physical_size.isEmpty())
+  if (physical_size.isEmpty()) {
+    *result = ImageResult::kEmpty;
     return nullptr;
+  }
 
   Entry& entry = cache_[picture->uniqueID()];
 
@@ -102,39 +112,94 @@ sk_sp<SkImage> RasterCache::GetPrerolledImage(GrContext* context,
   if (!size_matched) {
     entry.access_count = 1;
     entry.image = nullptr;
+    *result = ImageResult::kWarmingUp;
     return nullptr;
   }
 
   entry.access_count++;
 
-  if (entry.access_count >= kRasterThreshold) {
-    // Saturate at the threshhold.
-    entry.access_count = kRasterThreshold;
-
-    if (!entry.image && !will_change &&
-        (is_complex || isWorthRasterizing(picture))) {
-      TRACE_EVENT2("flutter", "Rasterize picture layer", "width",
-                   physical_size.width(), "height", physical_size.height());
-      SkImageInfo info = SkImageInfo::MakeN32Premul(physical_size);
-      sk_sp<SkSurface> surface =
-          SkSurface::MakeRenderTarget(context, SkBudgeted::kYes, info);
-      if (surface) {
-        SkCanvas* canvas = surface->getCanvas();
-        canvas->clear(SK_ColorTRANSPARENT);
-        canvas->scale(scaleX, scaleY);
-        canvas->translate(-rect.left(), -rect.top());
-        canvas->drawPicture(picture);
-        if (checkerboard_images_) {
-          DrawCheckerboard(canvas, rect);
-        }
-        entry.image = surface->makeImageSnapshot();
-      }
-    }
+  if (entry.access_count < kRasterThreshold) {
+    *result = ImageResult::kWarmingUp;
+    return nullptr;
+  }
+
+  // Saturate at the threshhold.
+  entry.access_count = kRasterThreshold;
+
+  if (entry.image) {
+    *result = ImageResult::kReused;
+    return entry.image;
   }
 
+  if (will_change || !(is_complex || isWorthRasterizing(picture))) {
+    *result = ImageResult::kRejected;
+    return nullptr;
+  }
+
+  TRACE_EVENT2("flutter", "Rasterize picture layer", "width",
+               physical_size.width(), "height", physical_size.height());
+  SkImageInfo info = SkImageInfo::MakeN32Premul(physical_size);
+  sk_sp<SkSurface> surface =
+      SkSurface::MakeRenderTarget(context, SkBudgeted::kYes, info);
+  if (!surface) {
+    *result = ImageResult::kRejected;
+    return nullptr;
+  }
+
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->scale(scaleX, scaleY);
+  canvas->translate(-rect.left(), -rect.top());
+  canvas->drawPicture(picture);
+  if (checkerboard_images_) {
+    DrawCheckerboard(canvas, rect);
+  }
+  entry.image = surface->makeImageSnapshot();
+  *result = ImageResult::kRasterized;
   return entry.image;
 }
 
+RasterCache::BackdropEntry& RasterCache::GetBackdropEntry(
+    const BackdropKey& key) {
+  for (BackdropEntry& entry : backdrops_) {
+    if (entry.filter.get() == key.filter &&
+        entry.device_bounds == key.device_bounds &&
+        entry.downsample == key.downsample)
+      return entry;
+  }
+  backdrops_.emplace_back();
+  BackdropEntry& entry = backdrops_.back();
+  entry.filter = sk_ref_sp(key.filter);
+  entry.device_bounds = key.device_bounds;
+  entry.downsample = key.downsample;
+  entry.signature = key.signature;
+  return entry;
+}
+
+sk_sp<SkImage> RasterCache::GetFilteredBackdrop(const BackdropKey& key,
+                                                bool* should_cache) {
+  BackdropEntry& entry = GetBackdropEntry(key);
+  entry.used_this_frame = true;
+  if (entry.signature != key.signature) {
+    entry.signature = key.signature;
+    entry.access_count = 0;
+    entry.image = nullptr;
+  }
+
+  // Like pictures, a backdrop must be stable for a few frames before it is
+  // cached: rendering it separately costs more than the plain backdrop
+  // filter, which is a loss if the content underneath keeps changing.
+  if (entry.access_count < kRasterThreshold)
+    entry.access_count++;
+  *should_cache = !entry.image && entry.access_count >= kRasterThreshold;
+  return entry.image;
+}
+
+void RasterCache::SetFilteredBackdrop(const BackdropKey& key,
+                                      sk_sp<SkImage> image) {
+  GetBackdropEntry(key).image = std::move(image);
+}
+
 void RasterCache::SweepAfterFrame() {
   std::vector<Cache::iterator> dead;
 
@@ -147,10 +212,18 @@ void RasterCache::SweepAfterFrame() {
 
   for (auto it : dead)
     cache_.erase(it);
+
+  auto end = std::remove_if(
+      backdrops_.begin(), backdrops_.end(),
+      [](const BackdropEntry& entry) { return !entry.used_this_frame; });
+  backdrops_.erase(end, backdrops_.end());
+  for (BackdropEntry& entry : backdrops_)
+    entry.used_this_frame = false;
 }
 
 void RasterCache::Clear() {
   cache_.clear();
+  backdrops_.clear();
 }
 
 void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
@@ -7,11 +7,14 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/flow/instrumentation.h"
 #include "lib/ftl/macros.h"
 #include "lib/ftl/memory/weak_ptr.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkSize.h"
 
 namespace flow {
@@ -21,11 +24,46 @@ class RasterCache {
   RasterCache();
   ~RasterCache();
 
+  // What GetPrerolledImage() did with a picture, for diagnostics.
+  enum class ImageResult {
+    // The picture covers no pixels at its current scale.
+    kEmpty,
+    // The picture has not been drawn at its current size for enough frames.
+    kWarmingUp,
+    // The picture is stable but is not worth an image, is about to change, or
+    // could not be rasterized.
+    kRejected,
+    // The picture was rasterized into a new image in this frame.
+    kRasterized,
+    // The image from an earlier frame was reused.
+    kReused,
+  };
+
   sk_sp<SkImage> GetPrerolledImage(GrContext* context,
                                    SkPicture* picture,
                                    const SkMatrix& ctm,
                                    bool is_complex,
-                                   bool will_change);
+                                   bool will_change,
+                                   ImageResult* result);
+
+  // Identifies the filtered backdrop of a BackdropFilterLayer: the filter, the
+  // device pixels it covers, and the signature of everything painted under
+  // it.
+  struct BackdropKey {
+    SkImageFilter* filter;
+    SkIRect device_bounds;
+    bool downsample;
+    uint64_t signature;
+  };
+
+  // Returns the filtered backdrop stored for |key|, or null. In that case
+  // |should_cache| tells whether the backdrop has been the same for enough
+  // frames that it is worth rendering it separately and calling
+  // SetFilteredBackdrop().
+  sk_sp<SkImage> GetFilteredBackdrop(const BackdropKey& key,
+                                     bool* should_cache);
+  void SetFilteredBackdrop(const BackdropKey& key, sk_sp<SkImage> image);
+
   void SweepAfterFrame();
 
   void Clear();
@@ -43,9 +81,26 @@ class RasterCache {
     sk_sp<SkImage> image;
   };
 
+  struct BackdropEntry {
+    BackdropEntry();
+    ~BackdropEntry();
+
+    bool used_this_frame = false;
+    int access_count = 0;
+    sk_sp<SkImageFilter> filter;
+    SkIRect device_bounds;
+    bool downsample = false;
+    uint64_t signature = 0;
+    sk_sp<SkImage> image;
+  };
+
+  BackdropEntry& GetBackdropEntry(const BackdropKey& key);
+
   using Cache = std::unordered_map<uint32_t, Entry>;
 
   Cache cache_;
+  // There are rarely more than a couple of backdrop filters on screen.
+  std::vector<BackdropEntry> backdrops_;
   bool checkerboard_images_;
   ftl::WeakPtrFactory<RasterCache> weak_factory_;
 
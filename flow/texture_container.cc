@@ -0,0 +1,211 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/texture_container.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+namespace flow {
+namespace {
+
+const uint8_t kKTXIdentifier[] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A,
+};
+
+const uint32_t kKTXEndianness = 0x04030201;
+const uint32_t kKTXEndiannessSwapped = 0x01020304;
+
+// The header fields following the identifier, in file order.
+enum KTXHeaderField {
+  kEndianness,
+  kGLType,
+  kGLTypeSize,
+  kGLFormat,
+  kGLInternalFormat,
+  kGLBaseInternalFormat,
+  kPixelWidth,
+  kPixelHeight,
+  kPixelDepth,
+  kNumberOfArrayElements,
+  kNumberOfFaces,
+  kNumberOfMipmapLevels,
+  kBytesOfKeyValueData,
+  kKTXHeaderFieldCount,
+};
+
+const size_t kKTXHeaderSize =
+    sizeof(kKTXIdentifier) + kKTXHeaderFieldCount * sizeof(uint32_t);
+
+// Larger than any texture a GPU we run on can sample, and small enough that
+// level sizes cannot overflow.
+const uint32_t kMaxDimension = 1 << 15;
+
+struct BlockFormat {
+  uint32_t width;
+  uint32_t height;
+  uint32_t bytes;
+  bool has_alpha;
+};
+
+bool GetBlockFormat(uint32_t internal_format, BlockFormat* format) {
+  switch (static_cast<TextureCompression>(internal_format)) {
+    case TextureCompression::ETC1_RGB8:
+    case TextureCompression::ETC2_RGB8:
+      *format = {4, 4, 8, false};
+      return true;
+    case TextureCompression::ETC2_RGB8_A1:
+      *format = {4, 4, 8, true};
+      return true;
+    case TextureCompression::ETC2_RGBA8_EAC:
+      *format = {4, 4, 16, true};
+      return true;
+    case TextureCompression::ASTC_4x4:
+      *format = {4, 4, 16, true};
+      return true;
+    case TextureCompression::ASTC_5x4:
+      *format = {5, 4, 16, true};
+      return true;
+    case TextureCompression::ASTC_5x5:
+      *format = {5, 5, 16, true};
+      return true;
+    case TextureCompression::ASTC_6x5:
+      *format = {6, 5, 16, true};
+      return true;
+    case TextureCompression::ASTC_6x6:
+      *format = {6, 6, 16, true};
+      return true;
+    case TextureCompression::ASTC_8x5:
+      *format = {8, 5, 16, true};
+      return true;
+    case TextureCompression::ASTC_8x6:
+      *format = {8, 6, 16, true};
+      return true;
+    case TextureCompression::ASTC_8x8:
+      *format = {8, 8, 16, true};
+      return true;
+    case TextureCompression::ASTC_10x5:
+      *format = {10, 5, 16, true};
+      return true;
+    case TextureCompression::ASTC_10x6:
+      *format = {10, 6, 16, true};
+      return true;
+    case TextureCompression::ASTC_10x8:
+      *format = {10, 8, 16, true};
+      return true;
+    case TextureCompression::ASTC_10x10:
+      *format = {10, 10, 16, true};
+      return true;
+    case TextureCompression::ASTC_12x10:
+      *format = {12, 10, 16, true};
+      return true;
+    case TextureCompression::ASTC_12x12:
+      *format = {12, 12, 16, true};
+      return true;
+  }
+  return false;
+}
+
+uint32_t ReadUInt32(const uint8_t* data, bool swap) {
+  uint32_t value;
+  memcpy(&value, data, sizeof(value));
+  if (swap) {
+    value = ((value & 0x000000FF) << 24) | ((value & 0x0000FF00) << 8) |
+            ((value & 0x00FF0000) >> 8) | ((value & 0xFF000000) >> 24);
+  }
+  return value;
+}
+
+size_t LevelLength(const BlockFormat& format, uint32_t width, uint32_t height) {
+  size_t blocks_wide = (width + format.width - 1) / format.width;
+  size_t blocks_high = (height + format.height - 1) / format.height;
+  return blocks_wide * blocks_high * format.bytes;
+}
+
+}  // namespace
+
+bool TextureContainerIsKTX(const uint8_t* data, size_t length) {
+  return length >= sizeof(kKTXIdentifier) &&
+         memcmp(data, kKTXIdentifier, sizeof(kKTXIdentifier)) == 0;
+}
+
+bool TextureContainerParseKTX(const uint8_t* data,
+                              size_t length,
+                              TextureContainer* container) {
+  if (length < kKTXHeaderSize || !TextureContainerIsKTX(data, length))
+    return false;
+
+  const uint8_t* fields = data + sizeof(kKTXIdentifier);
+  uint32_t endianness = ReadUInt32(fields, false);
+  if (endianness != kKTXEndianness && endianness != kKTXEndiannessSwapped)
+    return false;
+  bool swap = endianness == kKTXEndiannessSwapped;
+
+  uint32_t header[kKTXHeaderFieldCount];
+  for (int i = 0; i < kKTXHeaderFieldCount; ++i)
+    header[i] = ReadUInt32(fields + i * sizeof(uint32_t), swap);
+
+  // Compressed textures have no type or unpacked format. Only plain 2D
+  // textures are supported: no volumes, arrays or cube maps.
+  if (header[kGLType] != 0 || header[kGLFormat] != 0 ||
+      header[kPixelDepth] != 0 || header[kNumberOfArrayElements] != 0 ||
+      header[kNumberOfFaces] != 1)
+    return false;
+
+  BlockFormat format;
+  if (!GetBlockFormat(header[kGLInternalFormat], &format))
+    return false;
+
+  uint32_t width = header[kPixelWidth];
+  uint32_t height = header[kPixelHeight];
+  if (width == 0 || height == 0 || width > kMaxDimension ||
+      height > kMaxDimension)
+    return false;
+
+  // Zero levels asks the loader to generate mipmaps, which is not possible
+  // for compressed data; treat it as the base level alone.
+  uint32_t level_count = std::max<uint32_t>(header[kNumberOfMipmapLevels], 1);
+  uint32_t max_level_count = 1;
+  for (uint32_t extent = std::max(width, height); extent > 1; extent >>= 1)
+    ++max_level_count;
+  if (level_count > max_level_count)
+    return false;
+
+  size_t offset = kKTXHeaderSize;
+  if (header[kBytesOfKeyValueData] > length - offset)
+    return false;
+  offset += header[kBytesOfKeyValueData];
+
+  std::vector<TextureContainer::Level> levels;
+  levels.reserve(level_count);
+  for (uint32_t i = 0; i < level_count; ++i) {
+    if (length - offset < sizeof(uint32_t))
+      return false;
+    uint32_t image_size = ReadUInt32(data + offset, swap);
+    offset += sizeof(uint32_t);
+
+    uint32_t level_width = std::max<uint32_t>(width >> i, 1);
+    uint32_t level_height = std::max<uint32_t>(height >> i, 1);
+    if (image_size != LevelLength(format, level_width, level_height) ||
+        image_size > length - offset)
+      return false;
+
+    levels.push_back({SkISize::Make(level_width, level_height), data + offset,
+                      image_size});
+
+    // Levels are padded to four bytes. The padding after the last level may
+    // be missing.
+    offset += image_size;
+    offset += std::min<size_t>(3 - ((image_size + 3) % 4), length - offset);
+  }
+
+  container->compression =
+      static_cast<TextureCompression>(header[kGLInternalFormat]);
+  container->has_alpha = format.has_alpha;
+  container->levels = std::move(levels);
+  return true;
+}
+
+}  // namespace flow
@@ -0,0 +1,72 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_TEXTURE_CONTAINER_H_
+#define FLUTTER_FLOW_TEXTURE_CONTAINER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flow {
+
+// Block compressed formats accepted in texture containers, by their GL
+// internal format.
+enum class TextureCompression : uint32_t {
+  ETC1_RGB8 = 0x8D64,
+  ETC2_RGB8 = 0x9274,
+  ETC2_RGB8_A1 = 0x9276,
+  ETC2_RGBA8_EAC = 0x9278,
+  ASTC_4x4 = 0x93B0,
+  ASTC_5x4 = 0x93B1,
+  ASTC_5x5 = 0x93B2,
+  ASTC_6x5 = 0x93B3,
+  ASTC_6x6 = 0x93B4,
+  ASTC_8x5 = 0x93B5,
+  ASTC_8x6 = 0x93B6,
+  ASTC_8x8 = 0x93B7,
+  ASTC_10x5 = 0x93B8,
+  ASTC_10x6 = 0x93B9,
+  ASTC_10x8 = 0x93BA,
+  ASTC_10x10 = 0x93BB,
+  ASTC_12x10 = 0x93BC,
+  ASTC_12x12 = 0x93BD,
+};
+
+// A pre-compressed texture, as stored in a KTX file. The levels point into
+// the buffer the container was parsed from, which must outlive it.
+struct TextureContainer {
+  struct Level {
+    SkISize size;
+    const uint8_t* data;
+    size_t length;
+  };
+
+  TextureCompression compression;
+  // Whether the format stores alpha. Colors must be premultiplied, as Skia
+  // assumes for all textures.
+  bool has_alpha;
+  // The base level comes first, followed by any smaller mip levels.
+  std::vector<Level> levels;
+
+  const SkISize& size() const { return levels.front().size; }
+};
+
+// Whether |data| starts with the KTX file identifier.
+bool TextureContainerIsKTX(const uint8_t* data, size_t length);
+
+// Parses a KTX file holding a single 2D texture in one of the formats above.
+// Returns false, leaving |container| untouched, if the file is truncated,
+// describes anything else, or any level is not exactly the size its
+// dimensions and format call for.
+bool TextureContainerParseKTX(const uint8_t* data,
+                              size_t length,
+                              TextureContainer* container);
+
+}  // namespace flow
+
+#endif  // FLUTTER_FLOW_TEXTURE_CONTAINER_H_
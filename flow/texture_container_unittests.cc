@@ -0,0 +1,186 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/texture_container.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flow {
+namespace {
+
+const uint8_t kKTXIdentifier[] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A,
+};
+
+struct KTXHeader {
+  uint32_t gl_type = 0;
+  uint32_t gl_format = 0;
+  uint32_t gl_internal_format = static_cast<uint32_t>(
+      TextureCompression::ETC1_RGB8);
+  uint32_t pixel_width = 8;
+  uint32_t pixel_height = 4;
+  uint32_t pixel_depth = 0;
+  uint32_t number_of_faces = 1;
+  uint32_t number_of_mipmap_levels = 1;
+};
+
+void AppendUInt32(std::vector<uint8_t>* data, uint32_t value, bool swap) {
+  for (int i = 0; i < 4; ++i) {
+    int shift = swap ? 24 - 8 * i : 8 * i;
+    data->push_back(static_cast<uint8_t>(value >> shift));
+  }
+}
+
+// Builds a KTX file with the given header and one image per entry of
+// |level_lengths|, each filled with its level index.
+std::vector<uint8_t> MakeKTX(const KTXHeader& header,
+                             const std::vector<uint32_t>& level_lengths,
+                             bool swap = false) {
+  std::vector<uint8_t> data(kKTXIdentifier,
+                            kKTXIdentifier + sizeof(kKTXIdentifier));
+  AppendUInt32(&data, 0x04030201, swap);
+  AppendUInt32(&data, header.gl_type, swap);
+  AppendUInt32(&data, 1, swap);  // glTypeSize
+  AppendUInt32(&data, header.gl_format, swap);
+  AppendUInt32(&data, header.gl_internal_format, swap);
+  AppendUInt32(&data, 0x1907, swap);  // glBaseInternalFormat: GL_RGB
+  AppendUInt32(&data, header.pixel_width, swap);
+  AppendUInt32(&data, header.pixel_height, swap);
+  AppendUInt32(&data, header.pixel_depth, swap);
+  AppendUInt32(&data, 0, swap);  // numberOfArrayElements
+  AppendUInt32(&data, header.number_of_faces, swap);
+  AppendUInt32(&data, header.number_of_mipmap_levels, swap);
+  AppendUInt32(&data, 4, swap);  // bytesOfKeyValueData
+  AppendUInt32(&data, 0, swap);  // key/value data, skipped by the parser
+  for (size_t level = 0; level < level_lengths.size(); ++level) {
+    AppendUInt32(&data, level_lengths[level], swap);
+    data.insert(data.end(), level_lengths[level], static_cast<uint8_t>(level));
+    data.insert(data.end(), 3 - ((level_lengths[level] + 3) % 4), 0);
+  }
+  return data;
+}
+
+bool Parse(const std::vector<uint8_t>& data, TextureContainer* container) {
+  return TextureContainerParseKTX(data.data(), data.size(), container);
+}
+
+}  // namespace
+
+TEST(TextureContainerTest, RecognizesIdentifier) {
+  std::vector<uint8_t> data = MakeKTX(KTXHeader(), {16});
+  EXPECT_TRUE(TextureContainerIsKTX(data.data(), data.size()));
+  EXPECT_FALSE(TextureContainerIsKTX(data.data(), sizeof(kKTXIdentifier) - 1));
+
+  data[1] = 'X';
+  EXPECT_FALSE(TextureContainerIsKTX(data.data(), data.size()));
+}
+
+TEST(TextureContainerTest, ParsesMipChain) {
+  // An 8x4 ETC1 texture is two blocks wide; its 4x2, 2x1 and 1x1 levels are
+  // one block each.
+  KTXHeader header;
+  header.number_of_mipmap_levels = 4;
+  std::vector<uint8_t> data = MakeKTX(header, {16, 8, 8, 8});
+
+  TextureContainer container;
+  ASSERT_TRUE(Parse(data, &container));
+  EXPECT_EQ(TextureCompression::ETC1_RGB8, container.compression);
+  EXPECT_FALSE(container.has_alpha);
+  EXPECT_EQ(SkISize::Make(8, 4), container.size());
+  ASSERT_EQ(4u, container.levels.size());
+  EXPECT_EQ(SkISize::Make(4, 2), container.levels[1].size);
+  EXPECT_EQ(SkISize::Make(2, 1), container.levels[2].size);
+  EXPECT_EQ(SkISize::Make(1, 1), container.levels[3].size);
+  for (size_t level = 0; level < container.levels.size(); ++level) {
+    EXPECT_EQ(level == 0 ? 16u : 8u, container.levels[level].length);
+    EXPECT_EQ(level, container.levels[level].data[0]);
+    // The levels point into the parsed buffer.
+    EXPECT_GE(container.levels[level].data, data.data());
+    EXPECT_LE(container.levels[level].data + container.levels[level].length,
+              data.data() + data.size());
+  }
+}
+
+TEST(TextureContainerTest, ParsesSwappedEndianness) {
+  KTXHeader header;
+  header.gl_internal_format =
+      static_cast<uint32_t>(TextureCompression::ETC2_RGBA8_EAC);
+  std::vector<uint8_t> data = MakeKTX(header, {32}, true);
+
+  TextureContainer container;
+  ASSERT_TRUE(Parse(data, &container));
+  EXPECT_EQ(TextureCompression::ETC2_RGBA8_EAC, container.compression);
+  EXPECT_TRUE(container.has_alpha);
+  EXPECT_EQ(SkISize::Make(8, 4), container.size());
+}
+
+TEST(TextureContainerTest, ZeroLevelsMeansBaseLevel) {
+  KTXHeader header;
+  header.number_of_mipmap_levels = 0;
+  TextureContainer container;
+  ASSERT_TRUE(Parse(MakeKTX(header, {16}), &container));
+  EXPECT_EQ(1u, container.levels.size());
+}
+
+TEST(TextureContainerTest, RejectsMalformedFiles) {
+  TextureContainer container;
+  container.compression = TextureCompression::ASTC_4x4;
+
+  std::vector<uint8_t> data = MakeKTX(KTXHeader(), {16});
+
+  // Every truncation fails.
+  for (size_t length = 0; length < data.size(); ++length)
+    EXPECT_FALSE(TextureContainerParseKTX(data.data(), length, &container));
+
+  // A level that is not the size its dimensions call for.
+  EXPECT_FALSE(Parse(MakeKTX(KTXHeader(), {8}), &container));
+  EXPECT_FALSE(Parse(MakeKTX(KTXHeader(), {24}), &container));
+
+  // Fewer levels than the header lists.
+  KTXHeader missing_levels;
+  missing_levels.number_of_mipmap_levels = 2;
+  EXPECT_FALSE(Parse(MakeKTX(missing_levels, {16}), &container));
+
+  // More levels than the mip chain of the size has.
+  KTXHeader extra_levels;
+  extra_levels.number_of_mipmap_levels = 5;
+  EXPECT_FALSE(Parse(MakeKTX(extra_levels, {16, 8, 8, 8, 8}), &container));
+
+  // A failed parse leaves the container untouched.
+  EXPECT_EQ(TextureCompression::ASTC_4x4, container.compression);
+}
+
+TEST(TextureContainerTest, RejectsUnsupportedTextures) {
+  TextureContainer container;
+
+  KTXHeader uncompressed;
+  uncompressed.gl_type = 0x1401;    // GL_UNSIGNED_BYTE
+  uncompressed.gl_format = 0x1908;  // GL_RGBA
+  uncompressed.gl_internal_format = 0x1908;
+  EXPECT_FALSE(Parse(MakeKTX(uncompressed, {128}), &container));
+
+  KTXHeader unknown_format;
+  unknown_format.gl_internal_format = 0x83F0;  // S3TC DXT1
+  EXPECT_FALSE(Parse(MakeKTX(unknown_format, {16}), &container));
+
+  KTXHeader cube_map;
+  cube_map.number_of_faces = 6;
+  EXPECT_FALSE(Parse(MakeKTX(cube_map, {16}), &container));
+
+  KTXHeader volume;
+  volume.pixel_depth = 2;
+  EXPECT_FALSE(Parse(MakeKTX(volume, {16}), &container));
+
+  KTXHeader empty;
+  empty.pixel_width = 0;
+  EXPECT_FALSE(Parse(MakeKTX(empty, {16}), &container));
+
+  KTXHeader huge;
+  huge.pixel_width = 1 << 16;
+  EXPECT_FALSE(Parse(MakeKTX(huge, {16}), &container));
+}
+
+}  // namespace flow
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_TEXTURE_IMAGE_H_
 #define FLUTTER_FLOW_TEXTURE_IMAGE_H_
 
+#include "flutter/flow/texture_container.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageGenerator.h"
 
@@ -13,6 +14,12 @@ namespace flow {
 sk_sp<SkImage> TextureImageCreate(GrContext* context,
                                   SkImageGenerator& generator);
 
+// Uploads the base level of a pre-compressed texture.
+// Returns null if Skia has no config for the container's format or the GPU
+// does not support it.
+sk_sp<SkImage> TextureImageCreate(GrContext* context,
+                                  const TextureContainer& container);
+
 }  // namespace flow
 
 #endif  // FLUTTER_FLOW_TEXTURE_IMAGE_H_
@@ -4,13 +4,62 @@
 
 #include "flutter/flow/texture_image.h"
 
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "flutter/flow/gl_connection.h"
 #include "flutter/flow/open_gl.h"
 #include "flutter/glue/trace_event.h"
 #include "third_party/skia/include/gpu/gl/GrGLTypes.h"
 
+// Not in the OpenGL ES 2.0 headers.
+#ifndef GL_RED
+#define GL_RED 0x1903
+#endif
+#ifndef GL_R8
+#define GL_R8 0x8229
+#endif
+
 namespace flow {
 
+// What the current context can do with the textures we hand to Skia.
+struct TextureCaps {
+  // Single channel textures use GL_RED rather than GL_LUMINANCE or GL_ALPHA.
+  // Skia decides the same way, and samples Gray8 and Alpha8 textures with
+  // the matching swizzle.
+  bool red_textures = false;
+  // Whether GL_RED textures take the sized GL_R8 internal format.
+  bool sized_formats = false;
+};
+
+static TextureCaps QueryTextureCaps() {
+  GLConnection connection;
+  const GLConnection::Version& version = connection.GLVersion();
+  const std::set<std::string>& extensions = connection.Extensions();
+  bool gl3 = version.major >= 3;
+
+  TextureCaps caps;
+  if (version.isES) {
+    caps.red_textures = gl3 || extensions.count("GL_EXT_texture_rg");
+    caps.sized_formats = gl3;
+  } else {
+    caps.red_textures = gl3 || extensions.count("GL_ARB_texture_rg");
+    caps.sized_formats = caps.red_textures;
+  }
+  return caps;
+}
+
+// Every context the engine uploads from runs on the same driver, so the caps
+// are queried once, from whichever context is current at the first upload.
+static const TextureCaps& GetTextureCaps() {
+  static const TextureCaps caps = QueryTextureCaps();
+  return caps;
+}
+
 enum class TextureImageFormat {
+  Alpha,
   Grey,
   GreyAlpha,
   RGB,
@@ -22,20 +71,31 @@ enum class TextureImageDataFormat {
   UnsignedShort565,
 };
 
-static inline GLint ToGLFormat(TextureImageFormat format) {
+static inline GLint ToGLFormat(const TextureCaps& caps,
+                               TextureImageFormat format) {
   switch (format) {
     case TextureImageFormat::RGBA:
       return GL_RGBA;
     case TextureImageFormat::RGB:
       return GL_RGB;
+    case TextureImageFormat::Alpha:
+      return caps.red_textures ? GL_RED : GL_ALPHA;
     case TextureImageFormat::Grey:
-      return GL_LUMINANCE;
+      return caps.red_textures ? GL_RED : GL_LUMINANCE;
     case TextureImageFormat::GreyAlpha:
       return GL_LUMINANCE_ALPHA;
   }
   return GL_NONE;
 }
 
+static inline GLint ToGLInternalFormat(const TextureCaps& caps,
+                                       TextureImageFormat format) {
+  GLint gl_format = ToGLFormat(caps, format);
+  if (gl_format == GL_RED && caps.sized_formats)
+    return GL_R8;
+  return gl_format;
+}
+
 static inline GLint ToGLDataFormat(TextureImageDataFormat dataFormat) {
   switch (dataFormat) {
     case TextureImageDataFormat::UnsignedByte:
@@ -46,29 +106,96 @@ static inline GLint ToGLDataFormat(TextureImageDataFormat dataFormat) {
   return GL_NONE;
 }
 
-static inline GrPixelConfig ToGrPixelConfig(TextureImageDataFormat dataFormat) {
+static inline GrPixelConfig ToGrPixelConfig(TextureImageFormat format,
+                                            TextureImageDataFormat dataFormat) {
+  switch (format) {
+    case TextureImageFormat::Alpha:
+      return kAlpha_8_GrPixelConfig;
+    case TextureImageFormat::Grey:
+      return kGray_8_GrPixelConfig;
+    case TextureImageFormat::GreyAlpha:
+      // Skia has no config for luminance-alpha textures.
+      return kUnknown_GrPixelConfig;
+    case TextureImageFormat::RGB:
+    case TextureImageFormat::RGBA:
+      break;
+  }
+
   switch (dataFormat) {
     case TextureImageDataFormat::UnsignedByte:
-      return kRGBA_8888_GrPixelConfig;
+      return format == TextureImageFormat::RGBA ? kRGBA_8888_GrPixelConfig
+                                                : kUnknown_GrPixelConfig;
     case TextureImageDataFormat::UnsignedShort565:
       return kRGB_565_GrPixelConfig;
   }
   return kUnknown_GrPixelConfig;
 }
 
+static inline GrPixelConfig ToGrPixelConfig(TextureCompression compression) {
+  switch (compression) {
+    case TextureCompression::ETC1_RGB8:
+      return kETC1_GrPixelConfig;
+    case TextureCompression::ASTC_12x12:
+      return kASTC_12x12_GrPixelConfig;
+    default:
+      // Skia cannot describe the other formats.
+      return kUnknown_GrPixelConfig;
+  }
+}
+
+static inline GLint ToGLUnpackAlignment(TextureImageFormat format,
+                                        TextureImageDataFormat dataFormat) {
+  if (dataFormat == TextureImageDataFormat::UnsignedShort565)
+    return 2;
+  return format == TextureImageFormat::RGBA ? 4 : 1;
+}
+
 static inline SkColorType ToSkColorType(TextureImageFormat format) {
   switch (format) {
     case TextureImageFormat::RGBA:
       return SkColorType::kRGBA_8888_SkColorType;
-    case TextureImageFormat::RGB:
+    case TextureImageFormat::Alpha:
+      return SkColorType::kAlpha_8_SkColorType;
     case TextureImageFormat::Grey:
+      return SkColorType::kGray_8_SkColorType;
+    case TextureImageFormat::RGB:
     case TextureImageFormat::GreyAlpha:
-      // Add more specializations for greyscale images.
       return SkColorType::kRGB_565_SkColorType;
   }
   return kRGB_565_SkColorType;
 }
 
+static sk_sp<SkImage> AdoptTexture(GrContext* context,
+                                   GLuint handle,
+                                   const SkISize& size,
+                                   GrPixelConfig config) {
+  GrGLTextureInfo texInfo;
+  texInfo.fTarget = GL_TEXTURE_2D;
+  texInfo.fID = handle;
+
+  // Create an SkImage handle from the texture.
+  GrBackendTextureDesc desc;
+
+  desc.fOrigin = kTopLeft_GrSurfaceOrigin;
+  desc.fFlags = kNone_GrBackendTextureFlag;
+  desc.fWidth = size.fWidth;
+  desc.fHeight = size.fHeight;
+  desc.fTextureHandle = reinterpret_cast<GrBackendObject>(&texInfo);
+
+  desc.fConfig = config;
+
+  if (auto image = SkImage::MakeFromAdoptedTexture(context, desc)) {
+    // Texture handle was successfully adopted by the SkImage.
+    return image;
+  }
+
+  // We could not create an SkImage from the texture. Since it could not be
+  // adopted, delete the handle and return null.
+  glDeleteTextures(1, &handle);
+
+  return nullptr;
+}
+
 static sk_sp<SkImage> TextureImageCreate(GrContext* context,
                                          TextureImageFormat format,
                                          const SkISize& size,
@@ -80,6 +207,15 @@ static sk_sp<SkImage> TextureImageCreate(GrContext* context,
   if (!context)
     return nullptr;
 
+  GrPixelConfig config = ToGrPixelConfig(format, dataFormat);
+  if (config == kUnknown_GrPixelConfig)
+    return nullptr;
+
+  // Decoded images get a single level. The texture description cannot tell
+  // Skia about extra levels, so Skia builds a mip chain itself, and only for
+  // images a paint asks to draw with mipmapped filtering.
+  const TextureCaps& caps = GetTextureCaps();
+
   GLuint handle = GL_NONE;
 
   // Generate the texture handle.
@@ -95,20 +231,17 @@ static sk_sp<SkImage> TextureImageCreate(GrContext* context,
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
   // Update unpack alignment based on format.
-  glPixelStorei(GL_UNPACK_ALIGNMENT,
-                dataFormat == TextureImageDataFormat::UnsignedByte ? 4 : 2);
-
-  GLint gl_format = ToGLFormat(format);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, ToGLUnpackAlignment(format, dataFormat));
 
   // Upload the texture.
-  glTexImage2D(GL_TEXTURE_2D,               // target
-               0,                           // level
-               gl_format,                   // internal format
-               size.fWidth,                 // width
-               size.fHeight,                // height
-               0,                           // border
-               gl_format,                   // format
-               ToGLDataFormat(dataFormat),  // format
+  glTexImage2D(GL_TEXTURE_2D,                     // target
+               0,                                 // level
+               ToGLInternalFormat(caps, format),  // internal format
+               size.fWidth,                       // width
+               size.fHeight,                      // height
+               0,                                 // border
+               ToGLFormat(caps, format),          // format
+               ToGLDataFormat(dataFormat),        // format
                data);
 
   // Clear the binding. We are done.
@@ -117,31 +250,7 @@ static sk_sp<SkImage> TextureImageCreate(GrContext* context,
   // Flush the texture before it can be bound by another thread.
   glFlush();
 
-  GrGLTextureInfo texInfo;
-  texInfo.fTarget = GL_TEXTURE_2D;
-  texInfo.fID = handle;
-
-  // Create an SkImage handle from the texture.
-  GrBackendTextureDesc desc;
-
-  desc.fOrigin = kTopLeft_GrSurfaceOrigin;
-  desc.fFlags = kNone_GrBackendTextureFlag;
-  desc.fWidth = size.fWidth;
-  desc.fHeight = size.fHeight;
-  desc.fTextureHandle = reinterpret_cast<GrBackendObject>(&texInfo);
-
-  desc.fConfig = ToGrPixelConfig(dataFormat);
-
-  if (auto image = SkImage::MakeFromAdoptedTexture(context, desc)) {
-    // Texture handle was successfully adopted by the SkImage.
-    return image;
-  }
-
-  // We could not create an SkImage from the texture. Since it could not be
-  // adopted, delete the handle and return null.
-  glDeleteTextures(1, &handle);
-
-  return nullptr;
+  return AdoptTexture(context, handle, size, config);
 }
 
 static sk_sp<SkImage> TextureImageCreate(GrContext* context,
@@ -166,6 +275,14 @@ static sk_sp<SkImage> TextureImageCreate(GrContext* context,
       dataFormat = TextureImageDataFormat::UnsignedByte;
       imageFormat = TextureImageFormat::RGBA;
       break;
+    case kGray_8_SkColorType:
+      dataFormat = TextureImageDataFormat::UnsignedByte;
+      imageFormat = TextureImageFormat::Grey;
+      break;
+    case kAlpha_8_SkColorType:
+      dataFormat = TextureImageDataFormat::UnsignedByte;
+      imageFormat = TextureImageFormat::Alpha;
+      break;
     default:
       // Add more as supported.
       return nullptr;
@@ -195,7 +312,14 @@ sk_sp<SkImage> TextureImageCreate(GrContext* context,
   TextureImageFormat imageFormat = TextureImageFormat::RGBA;
   bool preferOpaque = SkAlphaTypeIsOpaque(info.alphaType());
 
-  if (preferOpaque) {
+  if (info.colorType() == kGray_8_SkColorType) {
+    // Keep greyscale and alpha-only images at one byte per pixel.
+    imageFormat = TextureImageFormat::Grey;
+    preferOpaque = true;
+  } else if (info.colorType() == kAlpha_8_SkColorType) {
+    imageFormat = TextureImageFormat::Alpha;
+    preferOpaque = false;
+  } else if (preferOpaque) {
     imageFormat = TextureImageFormat::RGB;
   }
 
@@ -210,7 +334,11 @@ sk_sp<SkImage> TextureImageCreate(GrContext* context,
 
   {
     TRACE_EVENT1("flutter", "DecodePrimaryPreferrence", "Type",
-                 preferOpaque ? "RGB565" : "RGBA8888");
+                 imageFormat == TextureImageFormat::Grey
+                     ? "Grey8"
+                     : imageFormat == TextureImageFormat::Alpha
+                           ? "Alpha8"
+                           : preferOpaque ? "RGB565" : "RGBA8888");
     // Try our preferred config.
     if (generator.tryGenerateBitmap(&bitmap, preferredImageInfo, nullptr)) {
       // Our got our preferred bitmap.
@@ -229,4 +357,76 @@ sk_sp<SkImage> TextureImageCreate(GrContext* context,
   return nullptr;
 }
 
+static bool IsCompressedFormatSupported(GLenum format) {
+  GLint count = 0;
+  glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+  if (count <= 0)
+    return false;
+  std::vector<GLint> formats(count);
+  glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+  return std::find(formats.begin(), formats.end(),
+                   static_cast<GLint>(format)) != formats.end();
+}
+
+sk_sp<SkImage> TextureImageCreate(GrContext* context,
+                                  const TextureContainer& container) {
+  const SkISize& size = container.size();
+  TRACE_EVENT2("flutter", __func__, "width", size.width(), "height",
+               size.height());
+
+  if (context == nullptr) {
+    return nullptr;
+  }
+
+  GrPixelConfig config = ToGrPixelConfig(container.compression);
+  if (config == kUnknown_GrPixelConfig) {
+    return nullptr;
+  }
+
+  GLenum format = static_cast<GLenum>(container.compression);
+  if (!IsCompressedFormatSupported(format)) {
+    return nullptr;
+  }
+
+  // Only the base level is uploaded. The texture description cannot tell
+  // Skia about further levels, so it would never sample them.
+  const TextureContainer::Level& base = container.levels.front();
+
+  GLuint handle = GL_NONE;
+  glGenTextures(1, &handle);
+  glBindTexture(GL_TEXTURE_2D, handle);
+
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+  // The container has been validated, so the driver only rejects formats it
+  // advertised but cannot handle at this size.
+  while (glGetError() != GL_NO_ERROR) {
+    // Clear errors left by earlier calls.
+  }
+  glCompressedTexImage2D(GL_TEXTURE_2D,       // target
+                         0,                   // level
+                         format,              // internal format
+                         base.size.width(),   // width
+                         base.size.height(),  // height
+                         0,                   // border
+                         base.length,         // image size
+                         base.data);          // data
+  GLenum error = glGetError();
+
+  glBindTexture(GL_TEXTURE_2D, GL_NONE);
+
+  if (error != GL_NO_ERROR) {
+    glDeleteTextures(1, &handle);
+    return nullptr;
+  }
+
+  // Flush the texture before it can be bound by another thread.
+  glFlush();
+
+  return AdoptTexture(context, handle, size, config);
+}
+
 }  // namespace flow
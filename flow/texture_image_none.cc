@@ -11,4 +11,9 @@ sk_sp<SkImage> TextureImageCreate(GrContext* context,
   return nullptr;
 }
 
+sk_sp<SkImage> TextureImageCreate(GrContext* context,
+                                  const TextureContainer& container) {
+  return nullptr;
+}
+
 }  // namespace flow
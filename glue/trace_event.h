@@ -2,14 +2,94 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-#if defined(__Fuchsia__)
+#ifndef FLUTTER_GLUE_TRACE_EVENT_H_
+#define FLUTTER_GLUE_TRACE_EVENT_H_
+
+// The engine's code includes this header rather than base's trace_event.h, so
+// that its events go wherever the build sends them.
+
+#if !defined(__Fuchsia__)
+// Also for code that uses base's tracing directly. With the recorder, base's
+// macros are replaced below, so they must never be defined after this point.
+#include "base/trace_event/trace_event.h"
+#endif  // !defined(__Fuchsia__)
+
+#if defined(FLUTTER_TRACE_RECORDER)
+
+#include <stdint.h>
+
+#include "flutter/glue/trace_recorder.h"
+
+#undef TRACE_EVENT0
+#undef TRACE_EVENT1
+#undef TRACE_EVENT2
+#undef TRACE_EVENT_INSTANT0
+#undef TRACE_EVENT_INSTANT1
+#undef TRACE_EVENT_INSTANT2
+#undef TRACE_EVENT_ASYNC_BEGIN0
+#undef TRACE_EVENT_ASYNC_BEGIN1
+#undef TRACE_EVENT_ASYNC_BEGIN2
+#undef TRACE_EVENT_ASYNC_END0
+#undef TRACE_EVENT_ASYNC_END1
+#undef TRACE_EVENT_ASYNC_END2
+#undef TRACE_COUNTER1
+
+#define FLUTTER_TRACE_CONCAT_INNER(a, b) a##b
+#define FLUTTER_TRACE_CONCAT(a, b) FLUTTER_TRACE_CONCAT_INNER(a, b)
+
+// The recorder does not keep event arguments, so they are not evaluated.
+#define TRACE_EVENT0(category, name) \
+  ::glue::TraceRecorder::ScopedEvent \
+      FLUTTER_TRACE_CONCAT(trace_event_, __LINE__)(category, name)
+#define TRACE_EVENT1(category, name, arg1_name, arg1_val) \
+  TRACE_EVENT0(category, name)
+#define TRACE_EVENT2(category, name, arg1_name, arg1_val, arg2_name, \
+                     arg2_val)                                       \
+  TRACE_EVENT0(category, name)
+#define TRACE_EVENT_INSTANT0(category, name, scope) \
+  ::glue::TraceRecorder::AddInstantEvent(category, name)
+#define TRACE_EVENT_INSTANT1(category, name, scope, arg1_name, arg1_val) \
+  TRACE_EVENT_INSTANT0(category, name, scope)
+#define TRACE_EVENT_INSTANT2(category, name, scope, arg1_name, arg1_val, \
+                             arg2_name, arg2_val)                        \
+  TRACE_EVENT_INSTANT0(category, name, scope)
+#define TRACE_EVENT_ASYNC_BEGIN0(category, name, id)        \
+  ::glue::TraceRecorder::AddAsyncBeginEvent(category, name, \
+                                            static_cast<uint64_t>(id))
+#define TRACE_EVENT_ASYNC_BEGIN1(category, name, id, arg1_name, arg1_val) \
+  TRACE_EVENT_ASYNC_BEGIN0(category, name, id)
+#define TRACE_EVENT_ASYNC_BEGIN2(category, name, id, arg1_name, arg1_val, \
+                                 arg2_name, arg2_val)                     \
+  TRACE_EVENT_ASYNC_BEGIN0(category, name, id)
+#define TRACE_EVENT_ASYNC_END0(category, name, id)        \
+  ::glue::TraceRecorder::AddAsyncEndEvent(category, name, \
+                                          static_cast<uint64_t>(id))
+#define TRACE_EVENT_ASYNC_END1(category, name, id, arg1_name, arg1_val) \
+  TRACE_EVENT_ASYNC_END0(category, name, id)
+#define TRACE_EVENT_ASYNC_END2(category, name, id, arg1_name, arg1_val, \
+                               arg2_name, arg2_val)                     \
+  TRACE_EVENT_ASYNC_END0(category, name, id)
+// Counters do keep their value.
+#define TRACE_COUNTER1(category, name, value)           \
+  ::glue::TraceRecorder::AddCounterEvent(category, name, \
+                                         static_cast<int64_t>(value))
+
+#elif defined(__Fuchsia__)
+
 #define TRACE_EVENT0(a, b)
 #define TRACE_EVENT1(a, b, c, d)
 #define TRACE_EVENT2(a, b, c, d, e, f)
+#define TRACE_EVENT_INSTANT0(a, b, c)
+#define TRACE_EVENT_INSTANT1(a, b, c, d, e)
+#define TRACE_EVENT_INSTANT2(a, b, c, d, e, f, g)
 #define TRACE_EVENT_ASYNC_BEGIN0(a, b, c)
-#define TRACE_EVENT_ASYNC_END0(a, b, c)
 #define TRACE_EVENT_ASYNC_BEGIN1(a, b, c, d, e)
+#define TRACE_EVENT_ASYNC_BEGIN2(a, b, c, d, e, f, g)
+#define TRACE_EVENT_ASYNC_END0(a, b, c)
 #define TRACE_EVENT_ASYNC_END1(a, b, c, d, e)
-#else
-#include "base/trace_event/trace_event.h"
-#endif  // defined(__Fuchsia__)
+#define TRACE_EVENT_ASYNC_END2(a, b, c, d, e, f, g)
+#define TRACE_COUNTER1(a, b, c)
+
+#endif  // defined(FLUTTER_TRACE_RECORDER)
+
+#endif  // FLUTTER_GLUE_TRACE_EVENT_H_
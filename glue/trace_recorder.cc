@@ -0,0 +1,395 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/glue/trace_recorder.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace glue {
+namespace {
+
+// 48KB per running thread that has recorded an event, and as much again for
+// the latest events of threads that have exited.
+const uint64_t kRecordCount = 2048;
+const size_t kInternCacheSize = 64;
+
+struct Record {
+  uint64_t timestamp;
+  // The end of complete events, the id of async events, the value of
+  // counters.
+  uint64_t end_or_id;
+  uint32_t name_id;
+  char phase;
+};
+
+struct InternCacheEntry {
+  const char* category;
+  const char* name;
+  uint32_t id;
+};
+
+// Written only by its owning thread. |claimed| is bumped before a record is
+// written and |written| after, so that the exporter can tell which of the
+// records it copied were being overwritten meanwhile.
+struct ThreadBuffer {
+  // The fields below are set under the buffer list's lock when the buffer
+  // is handed to a thread. The counters keep running across owners, and
+  // |begin| is where the current owner's records start.
+  uint32_t tid = 0;
+  uint64_t begin = 0;
+  std::atomic<const char*> name{nullptr};
+  std::atomic<uint64_t> claimed{0};
+  std::atomic<uint64_t> written{0};
+  Record records[kRecordCount];
+  InternCacheEntry intern_cache[kInternCacheSize] = {};
+};
+
+// The records of one thread, copied out of its buffer.
+struct ThreadRecords {
+  uint32_t tid;
+  const char* name;
+  std::vector<Record> records;
+};
+
+struct InternTable {
+  std::mutex mutex;
+  std::map<std::pair<const char*, const char*>, uint32_t> ids;
+  std::vector<std::pair<const char*, const char*>> strings;
+};
+
+struct BufferList {
+  std::mutex mutex;
+  // The buffers of running threads.
+  std::vector<ThreadBuffer*> buffers;
+  // Buffers of exited threads, reused for new threads rather than freed.
+  std::vector<ThreadBuffer*> free_buffers;
+  // The latest records of exited threads, oldest first, so that they can
+  // still be exported. At most |kRecordCount| records are kept in all.
+  std::deque<ThreadRecords> exited_threads;
+  size_t exited_record_count = 0;
+  uint32_t last_tid = 0;
+};
+
+InternTable& GetInternTable() {
+  static InternTable* table = new InternTable();
+  return *table;
+}
+
+BufferList& GetBufferList() {
+  static BufferList* list = new BufferList();
+  return *list;
+}
+
+// Copies the current owner's records out of |buffer|, leaving out any that
+// its thread started overwriting while they were copied. Must be called
+// under the buffer list's lock.
+ThreadRecords CopyRecords(ThreadBuffer* buffer) {
+  ThreadRecords copy;
+  copy.tid = buffer->tid;
+  copy.name = buffer->name.load(std::memory_order_relaxed);
+
+  uint64_t end = buffer->written.load(std::memory_order_acquire);
+  uint64_t begin =
+      std::max(buffer->begin, end > kRecordCount ? end - kRecordCount : 0);
+  std::vector<Record> records;
+  records.reserve(end - begin);
+  for (uint64_t i = begin; i < end; ++i)
+    records.push_back(buffer->records[i % kRecordCount]);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  uint64_t claimed = buffer->claimed.load(std::memory_order_relaxed);
+  uint64_t valid_begin =
+      std::max(begin, claimed > kRecordCount ? claimed - kRecordCount : 0);
+  copy.records.assign(records.begin() + (valid_begin - begin), records.end());
+  return copy;
+}
+
+// Called as a thread that has recorded events exits. Moves its records to
+// the exited threads and its buffer to the free list.
+void ReleaseThreadBuffer(void* value) {
+  ThreadBuffer* buffer = static_cast<ThreadBuffer*>(value);
+  BufferList& list = GetBufferList();
+  std::lock_guard<std::mutex> lock(list.mutex);
+
+  ThreadRecords records = CopyRecords(buffer);
+  if (!records.records.empty() || records.name) {
+    list.exited_record_count += records.records.size();
+    list.exited_threads.push_back(std::move(records));
+  }
+  while (list.exited_record_count > kRecordCount) {
+    std::vector<Record>& oldest = list.exited_threads.front().records;
+    size_t excess = list.exited_record_count - kRecordCount;
+    if (excess < oldest.size()) {
+      oldest.erase(oldest.begin(), oldest.begin() + excess);
+      list.exited_record_count -= excess;
+    } else {
+      list.exited_record_count -= oldest.size();
+      list.exited_threads.pop_front();
+    }
+  }
+
+  list.buffers.erase(
+      std::find(list.buffers.begin(), list.buffers.end(), buffer));
+  list.free_buffers.push_back(buffer);
+}
+
+pthread_once_t g_buffer_key_once = PTHREAD_ONCE_INIT;
+pthread_key_t g_buffer_key;
+
+void CreateBufferKey() {
+  pthread_key_create(&g_buffer_key, &ReleaseThreadBuffer);
+}
+
+ThreadBuffer* GetThreadBuffer() {
+  pthread_once(&g_buffer_key_once, CreateBufferKey);
+  ThreadBuffer* buffer =
+      static_cast<ThreadBuffer*>(pthread_getspecific(g_buffer_key));
+  if (buffer)
+    return buffer;
+
+  {
+    BufferList& list = GetBufferList();
+    std::lock_guard<std::mutex> lock(list.mutex);
+    if (list.free_buffers.empty()) {
+      buffer = new ThreadBuffer();
+    } else {
+      buffer = list.free_buffers.back();
+      list.free_buffers.pop_back();
+    }
+    buffer->tid = ++list.last_tid;
+    buffer->begin = buffer->written.load(std::memory_order_relaxed);
+    buffer->name.store(nullptr, std::memory_order_relaxed);
+    list.buffers.push_back(buffer);
+  }
+  pthread_setspecific(g_buffer_key, buffer);
+  return buffer;
+}
+
+uint32_t Intern(ThreadBuffer* buffer, const char* category, const char* name) {
+  InternCacheEntry& entry =
+      buffer->intern_cache[(reinterpret_cast<uintptr_t>(name) >> 3) %
+                           kInternCacheSize];
+  if (entry.name == name && entry.category == category)
+    return entry.id;
+
+  InternTable& table = GetInternTable();
+  std::lock_guard<std::mutex> lock(table.mutex);
+  uint32_t next_id = static_cast<uint32_t>(table.strings.size());
+  auto result =
+      table.ids.insert(std::make_pair(std::make_pair(category, name), next_id));
+  if (result.second)
+    table.strings.push_back(std::make_pair(category, name));
+  entry = {category, name, result.first->second};
+  return entry.id;
+}
+
+void Append(char phase,
+            const char* category,
+            const char* name,
+            uint64_t timestamp,
+            uint64_t end_or_id) {
+  ThreadBuffer* buffer = GetThreadBuffer();
+  uint32_t name_id = Intern(buffer, category, name);
+
+  uint64_t index = buffer->written.load(std::memory_order_relaxed);
+  buffer->claimed.store(index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  Record& record = buffer->records[index % kRecordCount];
+  record.timestamp = timestamp;
+  record.end_or_id = end_or_id;
+  record.name_id = name_id;
+  record.phase = phase;
+
+  buffer->written.store(index + 1, std::memory_order_release);
+}
+
+uint64_t MonotonicNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// The tick counters are constant rate and synchronized across cores on the
+// hardware we ship on, and much cheaper to read than the system clock.
+uint64_t ReadTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  uint64_t ticks;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+  return ticks;
+#else
+  return MonotonicNanoseconds();
+#endif
+}
+
+// Ticks are converted to time when exporting, from the rate observed between
+// the first time the recorder is enabled and the export.
+struct ClockBase {
+  uint64_t ticks;
+  uint64_t nanoseconds;
+};
+
+const ClockBase& GetClockBase() {
+  static ClockBase base = {ReadTicks(), MonotonicNanoseconds()};
+  return base;
+}
+
+void WriteEscaped(std::ostream& out, const char* string) {
+  for (const char* c = string; *c; ++c) {
+    if (*c == '"' || *c == '\\')
+      out << '\\';
+    out << *c;
+  }
+}
+
+void WriteMicroseconds(std::ostream& out, double microseconds) {
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.3f", microseconds);
+  out << buffer;
+}
+
+}  // namespace
+
+std::atomic<bool> TraceRecorder::enabled_(false);
+
+void TraceRecorder::SetEnabled(bool enabled) {
+  GetClockBase();
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void TraceRecorder::SetCurrentThreadName(const char* name) {
+  GetThreadBuffer()->name.store(name, std::memory_order_relaxed);
+}
+
+uint64_t TraceRecorder::Now() {
+  return ReadTicks();
+}
+
+void TraceRecorder::AddCompleteEvent(const char* category,
+                                     const char* name,
+                                     uint64_t start,
+                                     uint64_t end) {
+  Append('X', category, name, start, end);
+}
+
+void TraceRecorder::AddInstantEvent(const char* category, const char* name) {
+  if (IsEnabled())
+    Append('i', category, name, Now(), 0);
+}
+
+void TraceRecorder::AddAsyncBeginEvent(const char* category,
+                                       const char* name,
+                                       uint64_t id) {
+  if (IsEnabled())
+    Append('b', category, name, Now(), id);
+}
+
+void TraceRecorder::AddAsyncEndEvent(const char* category,
+                                     const char* name,
+                                     uint64_t id) {
+  if (IsEnabled())
+    Append('e', category, name, Now(), id);
+}
+
+void TraceRecorder::AddCounterEvent(const char* category,
+                                    const char* name,
+                                    int64_t value) {
+  if (IsEnabled())
+    Append('C', category, name, Now(), static_cast<uint64_t>(value));
+}
+
+void TraceRecorder::ExportChromeTraceEvents(std::ostream& out) {
+  const ClockBase& base = GetClockBase();
+  uint64_t tick_span = ReadTicks() - base.ticks;
+  uint64_t nanosecond_span = MonotonicNanoseconds() - base.nanoseconds;
+  double microseconds_per_tick =
+      tick_span == 0 ? 0.0 : nanosecond_span / (tick_span * 1000.0);
+  auto to_microseconds = [&](uint64_t ticks) {
+    return ticks > base.ticks ? (ticks - base.ticks) * microseconds_per_tick
+                              : 0.0;
+  };
+
+  std::vector<ThreadRecords> threads;
+  {
+    BufferList& list = GetBufferList();
+    std::lock_guard<std::mutex> lock(list.mutex);
+    threads.assign(list.exited_threads.begin(), list.exited_threads.end());
+    for (ThreadBuffer* buffer : list.buffers)
+      threads.push_back(CopyRecords(buffer));
+  }
+
+  std::vector<std::pair<const char*, const char*>> strings;
+  {
+    InternTable& table = GetInternTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    strings = table.strings;
+  }
+
+  int pid = getpid();
+  bool first = true;
+  out << "[";
+  for (const ThreadRecords& thread : threads) {
+    if (thread.name) {
+      out << (first ? "" : ",") << "{\"name\":\"thread_name\",\"ph\":\"M\","
+          << "\"pid\":" << pid << ",\"tid\":" << thread.tid
+          << ",\"args\":{\"name\":\"";
+      WriteEscaped(out, thread.name);
+      out << "\"}}";
+      first = false;
+    }
+
+    for (const Record& record : thread.records) {
+      // Names interned after the table was copied belong to events recorded
+      // after the export started.
+      if (record.name_id >= strings.size())
+        continue;
+      out << (first ? "" : ",") << "{\"cat\":\"";
+      WriteEscaped(out, strings[record.name_id].first);
+      out << "\",\"name\":\"";
+      WriteEscaped(out, strings[record.name_id].second);
+      out << "\",\"ph\":\"" << record.phase << "\",\"pid\":" << pid
+          << ",\"tid\":" << thread.tid << ",\"ts\":";
+      WriteMicroseconds(out, to_microseconds(record.timestamp));
+      switch (record.phase) {
+        case 'X':
+          out << ",\"dur\":";
+          WriteMicroseconds(out, (record.end_or_id - record.timestamp) *
+                                     microseconds_per_tick);
+          break;
+        case 'i':
+          out << ",\"s\":\"t\"";
+          break;
+        case 'b':
+        case 'e':
+          out << ",\"id\":\"0x" << std::hex << record.end_or_id << std::dec
+              << "\"";
+          break;
+        case 'C':
+          out << ",\"args\":{\"value\":"
+              << static_cast<int64_t>(record.end_or_id) << "}";
+          break;
+      }
+      out << "}";
+      first = false;
+    }
+  }
+  out << "]";
+}
+
+}  // namespace glue
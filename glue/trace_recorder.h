@@ -0,0 +1,85 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_GLUE_TRACE_RECORDER_H_
+#define FLUTTER_GLUE_TRACE_RECORDER_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <ostream>
+
+namespace glue {
+
+// Records trace events into a fixed-size ring buffer per thread, cheaply
+// enough to stay enabled in release builds. Only the most recent events of
+// each thread are kept, and a thread's buffer is reused once it exits, along
+// with a bounded number of its latest events for export. Category and event names must be string literals (or
+// otherwise live for the lifetime of the process), as only their interned ids
+// are recorded.
+//
+// Building with |flutter_trace_recorder| points the TRACE_EVENT and
+// TRACE_COUNTER macros in trace_event.h at this recorder instead of base.
+class TraceRecorder {
+ public:
+  static bool IsEnabled() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  static void SetEnabled(bool enabled);
+
+  // Names the calling thread in exported traces. |name| must be a literal.
+  static void SetCurrentThreadName(const char* name);
+
+  // Timestamps in ticks of the recorder's clock, which is monotonic and
+  // consistent across threads.
+  static uint64_t Now();
+
+  static void AddCompleteEvent(const char* category,
+                               const char* name,
+                               uint64_t start,
+                               uint64_t end);
+  static void AddInstantEvent(const char* category, const char* name);
+  static void AddAsyncBeginEvent(const char* category,
+                                 const char* name,
+                                 uint64_t id);
+  static void AddAsyncEndEvent(const char* category,
+                               const char* name,
+                               uint64_t id);
+  static void AddCounterEvent(const char* category,
+                              const char* name,
+                              int64_t value);
+
+  // Writes the recorded events as a Chrome trace event array, i.e. the
+  // "traceEvents" value of the JSON object format. Recording may continue
+  // meanwhile; events overwritten while exporting are left out.
+  static void ExportChromeTraceEvents(std::ostream& out);
+
+  // Records one complete event for the lifetime of the object.
+  class ScopedEvent {
+   public:
+    ScopedEvent(const char* category, const char* name)
+        : category_(category), name_(name), start_(IsEnabled() ? Now() : 0) {}
+
+    ~ScopedEvent() {
+      if (start_ != 0)
+        AddCompleteEvent(category_, name_, start_, Now());
+    }
+
+   private:
+    const char* category_;
+    const char* name_;
+    uint64_t start_;
+
+    ScopedEvent(const ScopedEvent&) = delete;
+    ScopedEvent& operator=(const ScopedEvent&) = delete;
+  };
+
+ private:
+  static std::atomic<bool> enabled_;
+};
+
+}  // namespace glue
+
+#endif  // FLUTTER_GLUE_TRACE_RECORDER_H_
@@ -0,0 +1,141 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/glue/trace_recorder.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace glue {
+namespace {
+
+// The records each thread keeps, as in trace_recorder.cc.
+constexpr int kRecordCount = 2048;
+
+// Each test records on its own thread, so that it starts with an empty buffer,
+// and uses event names of its own, as the recorder's state is global.
+template <typename Callable>
+void RecordOnNewThread(Callable callable) {
+  std::thread thread([&callable]() {
+    TraceRecorder::SetEnabled(true);
+    callable();
+    TraceRecorder::SetEnabled(false);
+  });
+  thread.join();
+}
+
+std::string Export() {
+  std::ostringstream out;
+  TraceRecorder::ExportChromeTraceEvents(out);
+  return out.str();
+}
+
+int CountOccurrences(const std::string& string, const std::string& pattern) {
+  int count = 0;
+  for (size_t i = string.find(pattern); i != std::string::npos;
+       i = string.find(pattern, i + pattern.size()))
+    ++count;
+  return count;
+}
+
+TEST(TraceRecorderTest, RecordsOnlyWhenEnabled) {
+  std::thread thread([]() {
+    TraceRecorder::SetEnabled(false);
+    TraceRecorder::AddInstantEvent("test", "WhileDisabled");
+    { TraceRecorder::ScopedEvent event("test", "ScopeWhileDisabled"); }
+    TraceRecorder::SetEnabled(true);
+    TraceRecorder::AddInstantEvent("test", "WhileEnabled");
+    TraceRecorder::SetEnabled(false);
+  });
+  thread.join();
+
+  std::string trace = Export();
+  EXPECT_EQ(0, CountOccurrences(trace, "\"name\":\"WhileDisabled\""));
+  EXPECT_EQ(0, CountOccurrences(trace, "\"name\":\"ScopeWhileDisabled\""));
+  EXPECT_EQ(1, CountOccurrences(trace, "\"name\":\"WhileEnabled\""));
+}
+
+TEST(TraceRecorderTest, KeepsLatestEventsWhenFull) {
+  const int kOverflow = 100;
+  RecordOnNewThread([]() {
+    for (int i = 0; i < kRecordCount + kOverflow; ++i)
+      TraceRecorder::AddCounterEvent("test", "Wraps", i);
+  });
+
+  std::string trace = Export();
+  EXPECT_EQ(kRecordCount, CountOccurrences(trace, "\"name\":\"Wraps\""));
+  std::ostringstream oldest_dropped;
+  oldest_dropped << "\"args\":{\"value\":" << kOverflow - 1 << "}";
+  EXPECT_EQ(0, CountOccurrences(trace, oldest_dropped.str()));
+  std::ostringstream oldest_kept;
+  oldest_kept << "\"args\":{\"value\":" << kOverflow << "}";
+  EXPECT_EQ(1, CountOccurrences(trace, oldest_kept.str()));
+  std::ostringstream latest;
+  latest << "\"args\":{\"value\":" << kRecordCount + kOverflow - 1 << "}";
+  EXPECT_EQ(1, CountOccurrences(trace, latest.str()));
+}
+
+TEST(TraceRecorderTest, ExportsEachPhase) {
+  RecordOnNewThread([]() {
+    { TraceRecorder::ScopedEvent event("phases", "Complete"); }
+    TraceRecorder::AddInstantEvent("phases", "Instant");
+    TraceRecorder::AddAsyncBeginEvent("phases", "Async", 42);
+    TraceRecorder::AddAsyncEndEvent("phases", "Async", 42);
+    TraceRecorder::AddCounterEvent("phases", "Counter", -5);
+  });
+
+  std::string trace = Export();
+  ASSERT_FALSE(trace.empty());
+  EXPECT_EQ('[', trace.front());
+  EXPECT_EQ(']', trace.back());
+  EXPECT_EQ(1, CountOccurrences(
+                   trace, "\"cat\":\"phases\",\"name\":\"Complete\",\"ph\":\"X\""));
+  EXPECT_EQ(1, CountOccurrences(
+                   trace, "\"cat\":\"phases\",\"name\":\"Instant\",\"ph\":\"i\""));
+  EXPECT_EQ(1, CountOccurrences(
+                   trace, "\"cat\":\"phases\",\"name\":\"Async\",\"ph\":\"b\""));
+  EXPECT_EQ(1, CountOccurrences(
+                   trace, "\"cat\":\"phases\",\"name\":\"Async\",\"ph\":\"e\""));
+  EXPECT_EQ(1, CountOccurrences(
+                   trace, "\"cat\":\"phases\",\"name\":\"Counter\",\"ph\":\"C\""));
+  EXPECT_EQ(2, CountOccurrences(trace, "\"id\":\"0x2a\""));
+  EXPECT_EQ(1, CountOccurrences(trace, "\"args\":{\"value\":-5}"));
+}
+
+TEST(TraceRecorderTest, ExportsEscapedThreadAndEventNames) {
+  RecordOnNewThread([]() {
+    TraceRecorder::SetCurrentThreadName("thread \"named\"");
+    TraceRecorder::AddInstantEvent("escapes", "back\\slash");
+  });
+
+  std::string trace = Export();
+  EXPECT_EQ(1, CountOccurrences(trace,
+                                "\"name\":\"thread_name\",\"ph\":\"M\""));
+  EXPECT_EQ(1, CountOccurrences(
+                   trace, "\"args\":{\"name\":\"thread \\\"named\\\"\"}"));
+  EXPECT_EQ(1, CountOccurrences(trace, "\"name\":\"back\\\\slash\""));
+}
+
+TEST(TraceRecorderTest, KeepsEventsOfExitedThreadsWhenReusingBuffers) {
+  RecordOnNewThread([]() {
+    for (int i = 0; i < 3; ++i)
+      TraceRecorder::AddInstantEvent("reuse", "BeforeExit");
+  });
+
+  // The second thread takes over the first one's buffer.
+  std::string trace;
+  RecordOnNewThread([&trace]() {
+    TraceRecorder::AddInstantEvent("reuse", "AfterReuse");
+    trace = Export();
+  });
+
+  EXPECT_EQ(3, CountOccurrences(trace, "\"name\":\"BeforeExit\""));
+  EXPECT_EQ(1, CountOccurrences(trace, "\"name\":\"AfterReuse\""));
+}
+
+}  // namespace
+}  // namespace glue
@@ -17,12 +17,42 @@ class Scene extends NativeFieldWrapperClass2 {
   /// object. To create a Scene object, use a [SceneBuilder].
   Scene(); // (this constructor is here just so we can document it)
 
+  /// Creates an image from this scene, as it would appear at the origin of a
+  /// window of the given size, in pixels.
+  ///
+  /// This works like [Picture.toImage]. The callback is invoked with null if
+  /// the scene has already been rendered with [Window.render].
+  void toImage(int width, int height, ImageDecoderCallback callback) {
+    if (width <= 0 || height <= 0)
+      throw new ArgumentError('Invalid image dimensions.');
+    final String error = _toImage(width, height, callback);
+    if (error != null)
+      throw new ArgumentError(error);
+  }
+  String _toImage(int width, int height, ImageDecoderCallback callback)
+      native "Scene_toImage";
+
   /// Releases the resources used by this scene.
   ///
   /// After calling this function, the scene is cannot be used further.
   void dispose() native "Scene_dispose";
 }
 
+/// A handle to a layer built by a [SceneBuilder], obtained from
+/// [SceneBuilder.popAndRetain].
+///
+/// The layer, together with everything added to it, can be added to the
+/// scenes of later frames with [SceneBuilder.addRetained] without being
+/// rebuilt. The layer lives for as long as this object or any scene using it.
+class EngineLayer extends NativeFieldWrapperClass2 {
+  /// Creates an uninitialized EngineLayer object.
+  ///
+  /// Calling the EngineLayer constructor directly will not create a useable
+  /// object. To create an EngineLayer object, use
+  /// [SceneBuilder.popAndRetain].
+  EngineLayer(); // (this constructor is here just so we can document it)
+}
+
 /// Builds a [Scene] containing the given visuals.
 ///
 /// A [Scene] can then be rendered using [Window.render].
@@ -103,8 +133,15 @@ class SceneBuilder extends NativeFieldWrapperClass2 {
   /// The given filter is applied to the current contents of the scene prior to
   /// rasterizing the given objects.
   ///
+  /// If [downsampleHint] is true, the engine may apply the filter at a lower
+  /// resolution and scale the result up. This makes large blurs much cheaper
+  /// at little visible cost, but coarsens filters with sharp detail.
+  ///
   /// See [pop] for details about the operation stack.
-  void pushBackdropFilter(ImageFilter filter) native "SceneBuilder_pushBackdropFilter";
+  void pushBackdropFilter(ImageFilter filter, { bool downsampleHint: false }) {
+    _pushBackdropFilter(filter, downsampleHint);
+  }
+  void _pushBackdropFilter(ImageFilter filter, bool downsampleHint) native "SceneBuilder_pushBackdropFilter";
 
   /// Pushes a shader mask operation onto the operation stack.
   ///
@@ -135,6 +172,29 @@ class SceneBuilder extends NativeFieldWrapperClass2 {
   /// stack.
   void pop() native "SceneBuilder_pop";
 
+  /// Ends the effect of the most recently pushed operation, like [pop], and
+  /// returns a handle to the layer that operation created.
+  ///
+  /// Passing the handle to [addRetained] on the builder of a later frame adds
+  /// the layer and its contents to that scene as they were built here, which
+  /// is much cheaper than building them again. The layer may be added at a
+  /// different position; parts of it that are out of view are skipped when
+  /// the scene is drawn.
+  ///
+  /// Returns null if the operation being ended is the first one pushed,
+  /// since that layer is the root of the scene.
+  EngineLayer popAndRetain() native "SceneBuilder_popAndRetain";
+
+  /// Adds a layer previously returned by [popAndRetain] to the scene, under
+  /// the current operations on the stack.
+  ///
+  /// A retained layer can appear in a scene only once, so adding a layer
+  /// that is already part of this scene, including one this builder returned
+  /// from [popAndRetain], is ignored. The same holds at any depth: a layer is
+  /// ignored if it contains a retained layer that is already in the scene, or
+  /// is itself contained in a retained layer that is.
+  void addRetained(EngineLayer retainedLayer) native "SceneBuilder_addRetained";
+
   /// Adds an object to the scene that displays performance statistics.
   ///
   /// Useful during development to assess the performance of the application.
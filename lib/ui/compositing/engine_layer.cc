@@ -0,0 +1,30 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/compositing/engine_layer.h"
+
+#include "flutter/common/threads.h"
+#include "lib/ftl/functional/make_copyable.h"
+
+namespace blink {
+
+IMPLEMENT_WRAPPERTYPEINFO(ui, EngineLayer);
+
+EngineLayer::EngineLayer(
+    std::shared_ptr<flow::ContainerLayer> layer,
+    std::vector<flow::ContainerLayer*> nested_retained_layers)
+    : layer_(std::move(layer)),
+      nested_retained_layers_(std::move(nested_retained_layers)),
+      gpu_task_runner_(Threads::Gpu()) {}
+
+EngineLayer::~EngineLayer() {
+  // The subtree may hold raster cache images belonging to the GPU thread's
+  // context, so the last reference must be dropped there.
+  gpu_task_runner_->PostTask(
+      ftl::MakeCopyable([layer = std::move(layer_)]() mutable {
+        layer.reset();
+      }));
+}
+
+}  // namespace blink
@@ -0,0 +1,54 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_COMPOSITING_ENGINE_LAYER_H_
+#define FLUTTER_LIB_UI_COMPOSITING_ENGINE_LAYER_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/flow/layers/container_layer.h"
+#include "lib/ftl/tasks/task_runner.h"
+#include "lib/tonic/dart_wrappable.h"
+
+namespace blink {
+
+// A handle to a layer subtree built by a SceneBuilder, which later scenes can
+// include again without rebuilding it.
+class EngineLayer : public ftl::RefCountedThreadSafe<EngineLayer>,
+                    public tonic::DartWrappable {
+  DEFINE_WRAPPERTYPEINFO();
+  FRIEND_MAKE_REF_COUNTED(EngineLayer);
+
+ public:
+  ~EngineLayer() override;
+
+  static ftl::RefPtr<EngineLayer> create(
+      std::shared_ptr<flow::ContainerLayer> layer,
+      std::vector<flow::ContainerLayer*> nested_retained_layers) {
+    return ftl::MakeRefCounted<EngineLayer>(std::move(layer),
+                                            std::move(nested_retained_layers));
+  }
+
+  const std::shared_ptr<flow::ContainerLayer>& layer() const { return layer_; }
+
+  // The retained layers inside the subtree, which must not appear elsewhere in
+  // a scene that includes it. Kept alive by the subtree.
+  const std::vector<flow::ContainerLayer*>& nested_retained_layers() const {
+    return nested_retained_layers_;
+  }
+
+ private:
+  EngineLayer(std::shared_ptr<flow::ContainerLayer> layer,
+              std::vector<flow::ContainerLayer*> nested_retained_layers);
+
+  std::shared_ptr<flow::ContainerLayer> layer_;
+  std::vector<flow::ContainerLayer*> nested_retained_layers_;
+  // The GPU thread of the view whose frame built the layer.
+  ftl::RefPtr<ftl::TaskRunner> gpu_task_runner_;
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_LIB_UI_COMPOSITING_ENGINE_LAYER_H_
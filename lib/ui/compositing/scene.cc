@@ -4,18 +4,45 @@
 
 #include "flutter/lib/ui/compositing/scene.h"
 
+#include "flutter/common/threads.h"
+#include "flutter/glue/trace_event.h"
+#include "flutter/lib/ui/painting/picture.h"
+#include "flutter/lib/ui/ui_dart_state.h"
+#include "lib/ftl/functional/make_copyable.h"
 #include "lib/tonic/converter/dart_converter.h"
 #include "lib/tonic/dart_args.h"
 #include "lib/tonic/dart_binding_macros.h"
 #include "lib/tonic/dart_library_natives.h"
+#include "lib/tonic/dart_persistent_value.h"
+#include "lib/tonic/dart_state.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 
 namespace blink {
+namespace {
+
+// Flattens |layer_tree| into a picture. Pictures are recorded by reference,
+// so this is cheap.
+sk_sp<SkPicture> FlattenLayerTree(flow::LayerTree* layer_tree,
+                                  uint32_t width,
+                                  uint32_t height) {
+  TRACE_EVENT0("flutter", "FlattenLayerTree");
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(width, height));
+  flow::CompositorContext compositor_context;
+  flow::CompositorContext::ScopedFrame frame =
+      compositor_context.AcquireFrame(nullptr, *canvas, false);
+  layer_tree->Raster(frame, true);
+  return recorder.finishRecordingAsPicture();
+}
+
+}  // namespace
 
 IMPLEMENT_WRAPPERTYPEINFO(ui, Scene);
 
-#define FOR_EACH_BINDING(V) V(Scene, dispose)
+#define FOR_EACH_BINDING(V) \
+  V(Scene, toImage)         \
+  V(Scene, dispose)
 
 DART_BIND_ALL(Scene, FOR_EACH_BINDING)
 
@@ -30,14 +57,65 @@ ftl::RefPtr<Scene> Scene::create(std::unique_ptr<flow::Layer> rootLayer,
 Scene::Scene(std::unique_ptr<flow::Layer> rootLayer,
              uint32_t rasterizerTracingThreshold,
              bool checkerboardRasterCacheImages)
-    : m_layerTree(new flow::LayerTree()) {
+    : m_layerTree(new flow::LayerTree()),
+      m_gpuTaskRunner(Threads::Gpu()),
+      m_uiTaskRunner(Threads::UI()) {
   m_layerTree->set_root_layer(std::move(rootLayer));
   m_layerTree->set_rasterizer_tracing_threshold(rasterizerTracingThreshold);
   m_layerTree->set_checkerboard_raster_cache_images(
       checkerboardRasterCacheImages);
 }
 
-Scene::~Scene() {}
+Scene::~Scene() {
+  // Retained layers in the tree may hold raster cache images belonging to the
+  // GPU thread's context, so the tree is released there.
+  if (m_layerTree) {
+    m_gpuTaskRunner->PostTask(
+        ftl::MakeCopyable([layer_tree = std::move(m_layerTree)]() mutable {
+          layer_tree.reset();
+        }));
+  }
+}
+
+Dart_Handle Scene::toImage(uint32_t width,
+                           uint32_t height,
+                           Dart_Handle callback) {
+  if (!Dart_IsClosure(callback))
+    return tonic::ToDart("Callback must be a function");
+  if (UIDartState::Current()->is_background_isolate())
+    return tonic::ToDart("Images cannot be created in a background isolate");
+
+  auto image_callback = std::make_unique<tonic::DartPersistentValue>(
+      tonic::DartState::Current(), callback);
+  if (!m_layerTree) {
+    RasterizeToImage(nullptr, width, height, std::move(image_callback));
+    return Dart_Null();
+  }
+
+  // The tree may share retained layers with frames the GPU thread is drawing,
+  // and prerolling writes to layers, so the snapshot is taken on the GPU
+  // thread between frames. It uses a tree of its own so that this scene can
+  // still be rendered.
+  std::unique_ptr<flow::LayerTree> snapshot_tree(new flow::LayerTree());
+  snapshot_tree->set_root_layer(m_layerTree->shared_root_layer());
+  ftl::RefPtr<ftl::TaskRunner> ui_task_runner = m_uiTaskRunner;
+  m_gpuTaskRunner->PostTask(ftl::MakeCopyable([
+    snapshot_tree = std::move(snapshot_tree), width, height, ui_task_runner,
+    image_callback = std::move(image_callback)
+  ]() mutable {
+    sk_sp<SkPicture> picture =
+        FlattenLayerTree(snapshot_tree.get(), width, height);
+    snapshot_tree.reset();
+    ui_task_runner->PostTask(ftl::MakeCopyable([
+      picture = std::move(picture), width, height,
+      image_callback = std::move(image_callback)
+    ]() mutable {
+      RasterizeToImage(std::move(picture), width, height,
+                       std::move(image_callback));
+    }));
+  }));
+  return Dart_Null();
+}
 
 void Scene::dispose() {
   ClearDartWrapper();
@@ -9,6 +9,7 @@
 #include <memory>
 
 #include "flutter/flow/layers/layer_tree.h"
+#include "lib/ftl/tasks/task_runner.h"
 #include "lib/tonic/dart_wrappable.h"
 #include "third_party/skia/include/core/SkPicture.h"
 
@@ -31,6 +32,8 @@ class Scene : public ftl::RefCountedThreadSafe<Scene>,
 
   std::unique_ptr<flow::LayerTree> takeLayerTree();
 
+  Dart_Handle toImage(uint32_t width, uint32_t height, Dart_Handle callback);
+
   void dispose();
 
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
@@ -41,6 +44,9 @@ class Scene : public ftl::RefCountedThreadSafe<Scene>,
                  bool checkerboardRasterCacheImages);
 
   std::unique_ptr<flow::LayerTree> m_layerTree;
+  // The threads of the view whose frame built the scene.
+  ftl::RefPtr<ftl::TaskRunner> m_gpuTaskRunner;
+  ftl::RefPtr<ftl::TaskRunner> m_uiTaskRunner;
 };
 
 }  // namespace blink
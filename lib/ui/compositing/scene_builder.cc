@@ -46,6 +46,8 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, SceneBuilder);
   V(SceneBuilder, pushBackdropFilter)               \
   V(SceneBuilder, pushShaderMask)                   \
   V(SceneBuilder, pop)                              \
+  V(SceneBuilder, popAndRetain)                     \
+  V(SceneBuilder, addRetained)                      \
   V(SceneBuilder, addPicture)                       \
   V(SceneBuilder, addChildScene)                    \
   V(SceneBuilder, addPerformanceOverlay)            \
@@ -64,78 +66,57 @@ void SceneBuilder::RegisterNatives(tonic::DartLibraryNatives* natives) {
 SceneBuilder::SceneBuilder()
     : m_currentLayer(nullptr),
       m_currentRasterizerTracingThreshold(0),
-      m_checkerboardRasterCacheImages(false) {
-  m_cullRects.push(SkRect::MakeLargest());
-}
+      m_checkerboardRasterCacheImages(false) {}
 
 SceneBuilder::~SceneBuilder() {}
 
 void SceneBuilder::pushTransform(const tonic::Float64List& matrix4) {
-  SkMatrix sk_matrix = ToSkMatrix(matrix4);
-  SkMatrix inverse_sk_matrix;
-  SkRect cullRect;
-  if (sk_matrix.invert(&inverse_sk_matrix))
-    inverse_sk_matrix.mapRect(&cullRect, m_cullRects.top());
-  else
-    cullRect = SkRect::MakeLargest();
-
   std::unique_ptr<flow::TransformLayer> layer(new flow::TransformLayer());
-  layer->set_transform(sk_matrix);
-  addLayer(std::move(layer), cullRect);
+  layer->set_transform(ToSkMatrix(matrix4));
+  addLayer(std::move(layer));
 }
 
 void SceneBuilder::pushClipRect(double left,
                                 double right,
                                 double top,
                                 double bottom) {
-  const SkRect clipRect = SkRect::MakeLTRB(left, top, right, bottom);
-  SkRect cullRect;
-  if (!cullRect.intersect(clipRect, m_cullRects.top()))
-    cullRect = SkRect::MakeEmpty();
-
   std::unique_ptr<flow::ClipRectLayer> layer(new flow::ClipRectLayer());
-  layer->set_clip_rect(clipRect);
-  addLayer(std::move(layer), cullRect);
+  layer->set_clip_rect(SkRect::MakeLTRB(left, top, right, bottom));
+  addLayer(std::move(layer));
 }
 
 void SceneBuilder::pushClipRRect(const RRect& rrect) {
-  SkRect cullRect;
-  if (!cullRect.intersect(rrect.sk_rrect.rect(), m_cullRects.top()))
-    cullRect = SkRect::MakeEmpty();
-
   std::unique_ptr<flow::ClipRRectLayer> layer(new flow::ClipRRectLayer());
   layer->set_clip_rrect(rrect.sk_rrect);
-  addLayer(std::move(layer), cullRect);
+  addLayer(std::move(layer));
 }
 
 void SceneBuilder::pushClipPath(const CanvasPath* path) {
-  SkRect cullRect;
-  if (!cullRect.intersect(path->path().getBounds(), m_cullRects.top()))
-    cullRect = SkRect::MakeEmpty();
-
   std::unique_ptr<flow::ClipPathLayer> layer(new flow::ClipPathLayer());
   layer->set_clip_path(path->path());
-  addLayer(std::move(layer), cullRect);
+  addLayer(std::move(layer));
 }
 
 void SceneBuilder::pushOpacity(int alpha) {
   std::unique_ptr<flow::OpacityLayer> layer(new flow::OpacityLayer());
   layer->set_alpha(alpha);
-  addLayer(std::move(layer), m_cullRects.top());
+  addLayer(std::move(layer));
 }
 
 void SceneBuilder::pushColorFilter(int color, int blendMode) {
   std::unique_ptr<flow::ColorFilterLayer> layer(new flow::ColorFilterLayer());
   layer->set_color(static_cast<SkColor>(color));
   layer->set_blend_mode(static_cast<SkBlendMode>(blendMode));
-  addLayer(std::move(layer), m_cullRects.top());
+  addLayer(std::move(layer));
 }
 
-void SceneBuilder::pushBackdropFilter(ImageFilter* filter) {
+void SceneBuilder::pushBackdropFilter(ImageFilter* filter,
+                                      bool downsampleHint) {
   std::unique_ptr<flow::BackdropFilterLayer> layer(
       new flow::BackdropFilterLayer());
   layer->set_filter(filter->filter());
-  addLayer(std::move(layer), m_cullRects.top());
+  layer->set_downsample(downsampleHint);
+  addLayer(std::move(layer));
 }
 
 void SceneBuilder::pushShaderMask(Shader* shader,
@@ -149,15 +130,12 @@ void SceneBuilder::pushShaderMask(Shader* shader,
   layer->set_mask_rect(SkRect::MakeLTRB(maskRectLeft, maskRectTop,
                                         maskRectRight, maskRectBottom));
   layer->set_blend_mode(static_cast<SkBlendMode>(blendMode));
-  addLayer(std::move(layer), m_cullRects.top());
+  addLayer(std::move(layer));
 }
 
-void SceneBuilder::addLayer(std::unique_ptr<flow::ContainerLayer> layer,
-                            const SkRect& cullRect) {
+void SceneBuilder::addLayer(std::unique_ptr<flow::ContainerLayer> layer) {
   FTL_DCHECK(layer);
 
-  m_cullRects.push(cullRect);
-
   if (!m_rootLayer) {
     FTL_DCHECK(!m_currentLayer);
     m_rootLayer = std::move(layer);
@@ -166,16 +144,70 @@ void SceneBuilder::addLayer(std::unique_ptr<flow::ContainerLayer> layer,
   }
   if (!m_currentLayer)
     return;
-  flow::ContainerLayer* newLayer = layer.get();
-  m_currentLayer->Add(std::move(layer));
-  m_currentLayer = newLayer;
+  std::shared_ptr<flow::ContainerLayer> newLayer = std::move(layer);
+  m_currentLayer->Add(newLayer);
+  m_currentLayer = newLayer.get();
+  m_layerStack.push_back(std::move(newLayer));
+  m_retainedLayerMarks.push_back(m_retainedLayerList.size());
 }
 
-void SceneBuilder::pop() {
+std::shared_ptr<flow::ContainerLayer> SceneBuilder::popLayer() {
   if (!m_currentLayer)
+    return nullptr;
+  if (m_layerStack.empty()) {
+    // Popping the root closes the scene.
+    m_currentLayer = nullptr;
+    return nullptr;
+  }
+  std::shared_ptr<flow::ContainerLayer> layer = std::move(m_layerStack.back());
+  m_layerStack.pop_back();
+  m_retainedLayerMarks.pop_back();
+  m_currentLayer =
+      m_layerStack.empty() ? m_rootLayer.get() : m_layerStack.back().get();
+  return layer;
+}
+
+void SceneBuilder::pop() {
+  popLayer();
+}
+
+ftl::RefPtr<EngineLayer> SceneBuilder::popAndRetain() {
+  if (m_layerStack.empty()) {
+    // The root cannot be retained; this just closes the scene.
+    popLayer();
+    return nullptr;
+  }
+  std::vector<flow::ContainerLayer*> nested(
+      m_retainedLayerList.begin() + m_retainedLayerMarks.back(),
+      m_retainedLayerList.end());
+  std::shared_ptr<flow::ContainerLayer> layer = popLayer();
+  m_retainedLayers.insert(layer.get());
+  m_retainedLayerList.push_back(layer.get());
+  return EngineLayer::create(std::move(layer), std::move(nested));
+}
+
+void SceneBuilder::addRetained(EngineLayer* retainedLayer) {
+  if (!m_currentLayer || !retainedLayer)
     return;
-  m_cullRects.pop();
-  m_currentLayer = m_currentLayer->parent();
+
+  // Neither the subtree nor any retained layer inside it may already be in
+  // the scene, whether on its own or inside another retained subtree.
+  const std::shared_ptr<flow::ContainerLayer>& layer = retainedLayer->layer();
+  const std::vector<flow::ContainerLayer*>& nested =
+      retainedLayer->nested_retained_layers();
+  if (m_retainedLayers.count(layer.get()))
+    return;
+  for (flow::ContainerLayer* nestedLayer : nested) {
+    if (m_retainedLayers.count(nestedLayer))
+      return;
+  }
+
+  m_retainedLayers.insert(nested.begin(), nested.end());
+  m_retainedLayerList.insert(m_retainedLayerList.end(), nested.begin(),
+                             nested.end());
+  m_retainedLayers.insert(layer.get());
+  m_retainedLayerList.push_back(layer.get());
+  m_currentLayer->Add(layer);
 }
 
 void SceneBuilder::addPicture(double dx,
@@ -185,11 +217,8 @@ void SceneBuilder::addPicture(double dx,
   if (!m_currentLayer)
     return;
 
-  SkRect pictureRect = picture->picture()->cullRect();
-  pictureRect.offset(dx, dy);
-  if (!SkRect::Intersects(pictureRect, m_cullRects.top()))
-    return;
-
+  // Pictures are culled against the clips when the scene is prerolled, so
+  // that layers retained for later frames keep everything they contain.
   std::unique_ptr<flow::PictureLayer> layer(new flow::PictureLayer());
   layer->set_offset(SkPoint::Make(dx, dy));
   layer->set_picture(picture->picture());
@@ -239,6 +268,10 @@ void SceneBuilder::setCheckerboardRasterCacheImages(bool checkerboard) {
 
 ftl::RefPtr<Scene> SceneBuilder::build() {
   m_currentLayer = nullptr;
+  m_layerStack.clear();
+  m_retainedLayerMarks.clear();
+  m_retainedLayers.clear();
+  m_retainedLayerList.clear();
   int32_t threshold = m_currentRasterizerTracingThreshold;
   m_currentRasterizerTracingThreshold = 0;
   ftl::RefPtr<Scene> scene = Scene::create(std::move(m_rootLayer), threshold,
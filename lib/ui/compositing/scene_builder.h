@@ -7,9 +7,11 @@
 
 #include <stdint.h>
 #include <memory>
-#include <stack>
+#include <unordered_set>
+#include <vector>
 
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/lib/ui/compositing/engine_layer.h"
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/painting/image_filter.h"
 #include "flutter/lib/ui/painting/path.h"
@@ -39,7 +41,7 @@ class SceneBuilder : public ftl::RefCountedThreadSafe<SceneBuilder>,
   void pushClipPath(const CanvasPath* path);
   void pushOpacity(int alpha);
   void pushColorFilter(int color, int transferMode);
-  void pushBackdropFilter(ImageFilter* filter);
+  void pushBackdropFilter(ImageFilter* filter, bool downsampleHint);
   void pushShaderMask(Shader* shader,
                       double maskRectLeft,
                       double maskRectRight,
@@ -47,6 +49,8 @@ class SceneBuilder : public ftl::RefCountedThreadSafe<SceneBuilder>,
                       double maskRectBottom,
                       int transferMode);
   void pop();
+  ftl::RefPtr<EngineLayer> popAndRetain();
+  void addRetained(EngineLayer* retainedLayer);
 
   void addPerformanceOverlay(uint64_t enabledOptions,
                              double left,
@@ -72,14 +76,23 @@ class SceneBuilder : public ftl::RefCountedThreadSafe<SceneBuilder>,
  private:
   SceneBuilder();
 
-  void addLayer(std::unique_ptr<flow::ContainerLayer> layer,
-                const SkRect& cullRect);
+  void addLayer(std::unique_ptr<flow::ContainerLayer> layer);
+  std::shared_ptr<flow::ContainerLayer> popLayer();
 
   std::unique_ptr<flow::ContainerLayer> m_rootLayer;
   flow::ContainerLayer* m_currentLayer;
+  // The open layers above the root, innermost last.
+  std::vector<std::shared_ptr<flow::ContainerLayer>> m_layerStack;
+  // For each open layer, the size of m_retainedLayerList when it was pushed.
+  std::vector<size_t> m_retainedLayerMarks;
+  // Retained layers already in this scene, at any depth. A layer is prerolled
+  // for a single position, so it can appear only once.
+  std::unordered_set<flow::ContainerLayer*> m_retainedLayers;
+  // The same layers, in the order they were added, so that the ones added
+  // while a layer was open are the ones nested inside it.
+  std::vector<flow::ContainerLayer*> m_retainedLayerList;
   int32_t m_currentRasterizerTracingThreshold;
   bool m_checkerboardRasterCacheImages;
-  std::stack<SkRect> m_cullRects;
 };
 
 }  // namespace blink
@@ -42,8 +42,9 @@ namespace blink {
 #define DECLARE_FUNCTION(name, count) \
   extern void name(Dart_NativeArguments args);
 
-#define BUILTIN_NATIVE_LIST(V) \
-  V(Logger_PrintString, 1)     \
+#define BUILTIN_NATIVE_LIST(V)     \
+  V(InvokeBackgroundEntryPoint, 3) \
+  V(Logger_PrintString, 1)         \
   V(ScheduleMicrotask, 1)
 
 BUILTIN_NATIVE_LIST(DECLARE_FUNCTION);
@@ -173,4 +174,12 @@ void ScheduleMicrotask(Dart_NativeArguments args) {
   tonic::DartMicrotaskQueue::ScheduleMicrotask(closure);
 }
 
+void InvokeBackgroundEntryPoint(Dart_NativeArguments args) {
+  Dart_Handle library = Dart_LookupLibrary(Dart_GetNativeArgument(args, 0));
+  if (LogIfError(library))
+    return;
+  Dart_Handle port = Dart_GetNativeArgument(args, 2);
+  LogIfError(Dart_Invoke(library, Dart_GetNativeArgument(args, 1), 1, &port));
+}
+
 }  // namespace blink
@@ -68,6 +68,27 @@ void _dispatchPlatformMessage(String name, ByteData data, int responseId) {
   }
 }
 
+// Dispatches the messages that arrived together, in order. Their payloads are
+// packed back to back in [data], [lengths] giving the size of each.
+void _dispatchPlatformMessages(List<String> names,
+                               ByteData data,
+                               Int32List lengths,
+                               Int32List responseIds) {
+  int offset = 0;
+  for (int i = 0; i < names.length; ++i) {
+    final int length = lengths[i];
+    final ByteData messageData = length == 0 ? null :
+        new ByteData.view(data.buffer, data.offsetInBytes + offset, length);
+    offset += length;
+    // An error in one handler must not keep the others from their messages.
+    try {
+      _dispatchPlatformMessage(names[i], messageData, responseIds[i]);
+    } catch (error, stackTrace) {
+      Zone.current.handleUncaughtError(error, stackTrace);
+    }
+  }
+}
+
 void _dispatchPointerDataPacket(ByteData packet) {
   if (window.onPointerDataPacket != null)
     window.onPointerDataPacket(_unpackPointerDataPacket(packet));
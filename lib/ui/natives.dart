@@ -37,6 +37,21 @@ void _setupHooks() {
 
 void _scheduleMicrotask(void callback()) native "ScheduleMicrotask";
 
+// Called by the engine on a background isolate for [Window.runInBackground].
+// The entry point is called from a message, as main is, so that the
+// microtasks it schedules run once it returns.
+void _runInBackground(String libraryUrl, String name, SendPort port) {
+  final RawReceivePort receivePort = new RawReceivePort();
+  receivePort.handler = (_) {
+    receivePort.close();
+    _invokeBackgroundEntryPoint(libraryUrl, name, port);
+  };
+  receivePort.sendPort.send(null);
+}
+
+void _invokeBackgroundEntryPoint(String libraryUrl, String name, SendPort port)
+    native "InvokeBackgroundEntryPoint";
+
 String _baseURL;
 Uri _getBaseURL() => Uri.parse(_baseURL);
 
@@ -564,13 +564,26 @@ abstract class Image extends NativeFieldWrapperClass2 {
   String toString() => '[$width\u00D7$height]';
 }
 
-/// Callback signature for [decodeImageFromList].
+/// Callback signature for [decodeImageFromList] and [takeWarmupImage].
 typedef void ImageDecoderCallback(Image result);
 
 /// Convert an image file from a byte array into an [Image] object.
 void decodeImageFromList(Uint8List list, ImageDecoderCallback callback)
     native "decodeImageFromList";
 
+/// Obtains an image that the engine decoded at startup.
+///
+/// Assets listed in the `ImageWarmupManifest.json` asset of the application
+/// bundle, a JSON array of asset names, are decoded and uploaded to the GPU
+/// while the application starts, so that images on the first screen need not
+/// wait for [decodeImageFromList]. The callback is invoked with the image
+/// once it is ready, or with null if the asset was not listed, could not be
+/// decoded, has already been taken, or was released when the system ran low
+/// on memory: each image can be obtained only once. Callers that ask while
+/// the image is still decoding each receive an image of their own.
+void takeWarmupImage(String assetName, ImageDecoderCallback callback)
+    native "takeWarmupImage";
+
 /// Determines how the interior of a [Path] is calculated.
 enum PathFillType {
   /// The interior is defined by a non-zero sum of signed edge crossings.
@@ -1071,6 +1084,43 @@ enum PointMode {
   polygon,
 }
 
+// Opcodes for the commands a [Canvas] encodes into its command buffer. Must
+// match CanvasCommand in canvas.cc, which also lists each command's arguments.
+class _CanvasCommand {
+  static const int save = 0;
+  static const int restore = 1;
+  static const int translate = 2;
+  static const int scale = 3;
+  static const int rotate = 4;
+  static const int skew = 5;
+  static const int clipRect = 6;
+  static const int clipRRect = 7;
+  static const int drawColor = 8;
+  static const int setPaint = 9;
+  static const int drawLine = 10;
+  static const int drawPaint = 11;
+  static const int drawRect = 12;
+  static const int drawRRect = 13;
+  static const int drawDRRect = 14;
+  static const int drawOval = 15;
+  static const int drawCircle = 16;
+  static const int drawArc = 17;
+}
+
+// The number of native calls made by all [Canvas] objects, so that benchmarks
+// and Observatory can see how well commands are batched. Registered with
+// dart:developer's [Metrics] as 'dart:ui.Canvas.nativeCalls'.
+final developer.Counter _canvasNativeCalls = _registerCanvasNativeCalls();
+
+developer.Counter _registerCanvasNativeCalls() {
+  final developer.Counter counter = new developer.Counter(
+    'dart:ui.Canvas.nativeCalls',
+    'The number of calls from Canvas objects into the engine.'
+  );
+  developer.Metrics.register(counter);
+  return counter;
+}
+
 /// An interface for recording graphical operations.
 ///
 /// [Canvas] objects are used in creating [Picture] objects, which can
@@ -1106,7 +1156,9 @@ class Canvas extends NativeFieldWrapperClass2 {
     if (recorder.isRecording)
       throw new ArgumentError('The given PictureRecorder is already associated with another Canvas.');
     // TODO(ianh): throw if recorder is defunct (https://github.com/flutter/flutter/issues/2531)
+    _canvasNativeCalls.value += 1.0;
     _constructor(recorder, cullRect.left, cullRect.top, cullRect.right, cullRect.bottom);
+    recorder._canvas = this;
   }
   void _constructor(PictureRecorder recorder,
                     double left,
@@ -1114,10 +1166,150 @@ class Canvas extends NativeFieldWrapperClass2 {
                     double right,
                     double bottom) native "Canvas_constructor";
 
+  // Transforms, rectangular clips and simple shapes are not sent to the engine
+  // one native call at a time. Instead they are encoded into _commands, along
+  // with the paint they use, and replayed by the engine in one call when the
+  // buffer fills, before any command that is sent directly, and when the
+  // recording ends. The binary format must match Canvas::replay in canvas.cc.
+  //
+  // The buffer starts small, so that small pictures stay cheap, and doubles
+  // as needed up to _kMaxCommandBufferByteCount, after which it is flushed
+  // whenever it fills.
+  static const int _kInitialCommandBufferByteCount = 256;
+  static const int _kMaxCommandBufferByteCount = 16 * 1024;
+  static const int _kNoPaintObjects = 0xFFFFFFFF;
+
+  ByteData _commands = new ByteData(_kInitialCommandBufferByteCount);
+  int _commandByteCount = 0;
+
+  // The objects of every paint in _commands, _kObjectCount entries per paint.
+  List<dynamic> _commandPaintObjects;
+
+  // The paint most recently encoded into _commands, which draw commands use
+  // until the next _CanvasCommand.setPaint. Copied, because Paint is mutable.
+  final ByteData _commandPaintData = new ByteData(Paint._kDataByteCount);
+  List<dynamic> _commandPaintObjectsCopy;
+  bool _hasCommandPaint = false;
+
+  // Makes room for byteCount more bytes in _commands.
+  void _reserveCommandBytes(int byteCount) {
+    if (_commandByteCount + byteCount > _kMaxCommandBufferByteCount)
+      _flushCommands();
+    final int requiredByteCount = _commandByteCount + byteCount;
+    int capacity = _commands.lengthInBytes;
+    if (requiredByteCount <= capacity)
+      return;
+    while (capacity < requiredByteCount)
+      capacity *= 2;
+    final ByteData commands = new ByteData(math.min(capacity, _kMaxCommandBufferByteCount));
+    new Uint8List.view(commands.buffer).setRange(
+        0, _commandByteCount, new Uint8List.view(_commands.buffer));
+    _commands = commands;
+  }
+
+  void _beginCommand(int command, int argumentCount) {
+    _reserveCommandBytes((argumentCount + 1) << 2);
+    _writeUint(command);
+  }
+
+  void _writeUint(int value) {
+    _commands.setUint32(_commandByteCount, value, _kFakeHostEndian);
+    _commandByteCount += 4;
+  }
+
+  void _writeFloat(double value) {
+    _commands.setFloat32(_commandByteCount, value, _kFakeHostEndian);
+    _commandByteCount += 4;
+  }
+
+  void _writeRect(double left, double top, double right, double bottom) {
+    _writeFloat(left);
+    _writeFloat(top);
+    _writeFloat(right);
+    _writeFloat(bottom);
+  }
+
+  void _writeRRect(Float32List value) {
+    for (int i = 0; i < 12; ++i)
+      _writeFloat(value[i]);
+  }
+
+  bool _isCommandPaint(Paint paint) {
+    if (!_hasCommandPaint)
+      return false;
+    final List<dynamic> objects = paint._objects;
+    if ((objects == null) != (_commandPaintObjectsCopy == null))
+      return false;
+    if (objects != null) {
+      for (int i = 0; i < Paint._kObjectCount; ++i) {
+        if (!identical(objects[i], _commandPaintObjectsCopy[i]))
+          return false;
+      }
+    }
+    for (int offset = 0; offset < Paint._kDataByteCount; offset += 4) {
+      if (paint._data.getUint32(offset, _kFakeHostEndian) !=
+          _commandPaintData.getUint32(offset, _kFakeHostEndian))
+        return false;
+    }
+    return true;
+  }
+
+  // Begins a draw command that uses the given paint, preceded by a setPaint
+  // command if the paint differs from the one the engine will have current.
+  void _beginDrawCommand(int command, int argumentCount, Paint paint) {
+    const int kSetPaintArgumentCount = 1 + (Paint._kDataByteCount >> 2);
+    // Keep the paint and the draw in the same buffer.
+    _reserveCommandBytes((kSetPaintArgumentCount + argumentCount + 2) << 2);
+    if (!_isCommandPaint(paint)) {
+      _beginCommand(_CanvasCommand.setPaint, kSetPaintArgumentCount);
+      final List<dynamic> objects = paint._objects;
+      if (objects == null) {
+        _writeUint(_kNoPaintObjects);
+        _commandPaintObjectsCopy = null;
+      } else {
+        _commandPaintObjects ??= <dynamic>[];
+        _writeUint(_commandPaintObjects.length);
+        _commandPaintObjects.addAll(objects);
+        _commandPaintObjectsCopy = new List<dynamic>.from(objects);
+      }
+      for (int offset = 0; offset < Paint._kDataByteCount; offset += 4) {
+        final int word = paint._data.getUint32(offset, _kFakeHostEndian);
+        _commandPaintData.setUint32(offset, word, _kFakeHostEndian);
+        _writeUint(word);
+      }
+      _hasCommandPaint = true;
+    }
+    _beginCommand(command, argumentCount);
+  }
+
+  // Sends any buffered commands to the engine. Must be called before every
+  // native call that records into or reads from the underlying canvas.
+  void _flushCommands() {
+    if (_commandByteCount == 0)
+      return;
+    _canvasNativeCalls.value += 1.0;
+    _replay(_commandPaintObjects, _commands, _commandByteCount);
+    _commandByteCount = 0;
+    _commandPaintObjects = null;
+    _hasCommandPaint = false;
+  }
+  void _replay(List<dynamic> paintObjects,
+               ByteData commands,
+               int byteCount) native "Canvas_replay";
+
+  // Must be called before every native call other than the replay of the
+  // command buffer.
+  void _beginDirectCall() {
+    _flushCommands();
+    _canvasNativeCalls.value += 1.0;
+  }
+
   /// Saves a copy of the current transform and clip on the save stack.
   ///
   /// Call [restore] to pop the save stack.
-  void save() native "Canvas_save";
+  void save() {
+    _beginCommand(_CanvasCommand.save, 0);
+  }
 
   /// Saves a copy of the current transform and clip on the save stack, and then
   /// creates a new group which subsequent calls will become a part of. When the
@@ -1134,6 +1326,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///
   /// Call [restore] to pop the save stack and apply the paint to the group.
   void saveLayer(Rect bounds, Paint paint) {
+    _beginDirectCall();
     if (bounds == null) {
       _saveLayerWithoutBounds(paint._objects, paint._data);
     } else {
@@ -1158,7 +1351,9 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///
   /// If the state was pushed with with [saveLayer], then this call will also
   /// cause the new layer to be composited into the previous layer.
-  void restore() native "Canvas_restore";
+  void restore() {
+    _beginCommand(_CanvasCommand.restore, 0);
+  }
 
   /// Returns the number of items on the save stack, including the
   /// initial state. This means it returns 1 for a clean canvas, and
@@ -1166,31 +1361,51 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// each matching call to [restore] decrements it.
   ///
   /// This number cannot go below 1.
-  int getSaveCount() native "Canvas_getSaveCount";
+  int getSaveCount() {
+    _beginDirectCall();
+    return _getSaveCount();
+  }
+  int _getSaveCount() native "Canvas_getSaveCount";
 
   /// Add a translation to the current transform, shifting the coordinate space
   /// horizontally by the first argument and vertically by the second argument.
-  void translate(double dx, double dy) native "Canvas_translate";
+  void translate(double dx, double dy) {
+    _beginCommand(_CanvasCommand.translate, 2);
+    _writeFloat(dx);
+    _writeFloat(dy);
+  }
 
   /// Add an axis-aligned scale to the current transform, scaling by the first
   /// argument in the horizontal direction and the second in the vertical
   /// direction.
-  void scale(double sx, double sy) native "Canvas_scale";
+  void scale(double sx, double sy) {
+    _beginCommand(_CanvasCommand.scale, 2);
+    _writeFloat(sx);
+    _writeFloat(sy);
+  }
 
   /// Add a rotation to the current transform. The argument is in radians clockwise.
-  void rotate(double radians) native "Canvas_rotate";
+  void rotate(double radians) {
+    _beginCommand(_CanvasCommand.rotate, 1);
+    _writeFloat(radians);
+  }
 
   /// Add an axis-aligned skew to the current transform, with the first argument
   /// being the horizontal skew in radians clockwise around the origin, and the
   /// second argument being the vertical skew in radians clockwise around the
   /// origin.
-  void skew(double sx, double sy) native "Canvas_skew";
+  void skew(double sx, double sy) {
+    _beginCommand(_CanvasCommand.skew, 2);
+    _writeFloat(sx);
+    _writeFloat(sy);
+  }
 
   /// Multiply the current transform by the specified 4⨉4 transformation matrix
   /// specified as a list of values in column-major order.
   void transform(Float64List matrix4) {
     if (matrix4.length != 16)
       throw new ArgumentError("[matrix4] must have 16 entries.");
+    _beginDirectCall();
     _transform(matrix4);
   }
   void _transform(Float64List matrix4) native "Canvas_transform";
@@ -1200,6 +1415,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   void setMatrix(Float64List matrix4) {
     if (matrix4.length != 16)
       throw new ArgumentError("[matrix4] must have 16 entries.");
+    _beginDirectCall();
     _setMatrix(matrix4);
   }
   void _setMatrix(Float64List matrix4) native "Canvas_setMatrix";
@@ -1207,70 +1423,62 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// Reduces the clip region to the intersection of the current clip and the
   /// given rectangle.
   void clipRect(Rect rect) {
-    _clipRect(rect.left, rect.top, rect.right, rect.bottom);
+    _beginCommand(_CanvasCommand.clipRect, 4);
+    _writeRect(rect.left, rect.top, rect.right, rect.bottom);
   }
-  void _clipRect(double left,
-                 double top,
-                 double right,
-                 double bottom) native "Canvas_clipRect";
 
   /// Reduces the clip region to the intersection of the current clip and the
   /// given rounded rectangle.
-  void clipRRect(RRect rrect) => _clipRRect(rrect._value);
-  void _clipRRect(Float32List rrect) native "Canvas_clipRRect";
+  void clipRRect(RRect rrect) {
+    _beginCommand(_CanvasCommand.clipRRect, 12);
+    _writeRRect(rrect._value);
+  }
 
   /// Reduces the clip region to the intersection of the current clip and the
   /// given [Path].
-  void clipPath(Path path) native "Canvas_clipPath";
+  void clipPath(Path path) {
+    _beginDirectCall();
+    _clipPath(path);
+  }
+  void _clipPath(Path path) native "Canvas_clipPath";
 
   /// Paints the given [Color] onto the canvas, applying the given
   /// [TransferMode], with the given color being the source and the background
   /// being the destination.
   void drawColor(Color color, TransferMode transferMode) {
-    _drawColor(color.value, transferMode.index);
+    _beginCommand(_CanvasCommand.drawColor, 2);
+    _writeUint(color.value);
+    _writeUint(transferMode.index);
   }
-  void _drawColor(int color, int transferMode) native "Canvas_drawColor";
 
   /// Draws a line between the given [Point]s using the given paint. The line is
   /// stroked, the value of the [Paint.style] is ignored for this call.
   void drawLine(Point p1, Point p2, Paint paint) {
-    _drawLine(p1.x, p1.y, p2.x, p2.y, paint._objects, paint._data);
+    _beginDrawCommand(_CanvasCommand.drawLine, 4, paint);
+    _writeRect(p1.x, p1.y, p2.x, p2.y);
   }
-  void _drawLine(double x1,
-                 double y1,
-                 double x2,
-                 double y2,
-                 List<dynamic> paintObjects,
-                 ByteData paintData) native "Canvas_drawLine";
 
   /// Fills the canvas with the given [Paint].
   ///
   /// To fill the canvas with a solid color and transfer mode, consider
   /// [drawColor] instead.
-  void drawPaint(Paint paint) => _drawPaint(paint._objects, paint._data);
-  void _drawPaint(List<dynamic> paintObjects, ByteData paintData) native "Canvas_drawPaint";
+  void drawPaint(Paint paint) {
+    _beginDrawCommand(_CanvasCommand.drawPaint, 0, paint);
+  }
 
   /// Draws a rectangle with the given [Paint]. Whether the rectangle is filled
   /// or stroked (or both) is controlled by [Paint.style].
   void drawRect(Rect rect, Paint paint) {
-    _drawRect(rect.left, rect.top, rect.right, rect.bottom,
-              paint._objects, paint._data);
+    _beginDrawCommand(_CanvasCommand.drawRect, 4, paint);
+    _writeRect(rect.left, rect.top, rect.right, rect.bottom);
   }
-  void _drawRect(double left,
-                 double top,
-                 double right,
-                 double bottom,
-                 List<dynamic> paintObjects,
-                 ByteData paintData) native "Canvas_drawRect";
 
   /// Draws a rounded rectangle with the given [Paint]. Whether the rectangle is
   /// filled or stroked (or both) is controlled by [Paint.style].
   void drawRRect(RRect rrect, Paint paint) {
-    _drawRRect(rrect._value, paint._objects, paint._data);
+    _beginDrawCommand(_CanvasCommand.drawRRect, 12, paint);
+    _writeRRect(rrect._value);
   }
-  void _drawRRect(Float32List rrect,
-                  List<dynamic> paintObjects,
-                  ByteData paintData) native "Canvas_drawRRect";
 
   /// Draws a shape consisting of the difference between two rounded rectangles
   /// with the given [Paint]. Whether this shape is filled or stroked (or both)
@@ -1278,39 +1486,29 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///
   /// This shape is almost but not quite entirely unlike an annulus.
   void drawDRRect(RRect outer, RRect inner, Paint paint) {
-    _drawDRRect(outer._value, inner._value, paint._objects, paint._data);
+    _beginDrawCommand(_CanvasCommand.drawDRRect, 24, paint);
+    _writeRRect(outer._value);
+    _writeRRect(inner._value);
   }
-  void _drawDRRect(Float32List outer,
-                   Float32List inner,
-                   List<dynamic> paintObjects,
-                   ByteData paintData) native "Canvas_drawDRRect";
 
   /// Draws an axis-aligned oval that fills the given axis-aligned rectangle
   /// with the given [Paint]. Whether the oval is filled or stroked (or both) is
   /// controlled by [Paint.style].
   void drawOval(Rect rect, Paint paint) {
-    _drawOval(rect.left, rect.top, rect.right, rect.bottom,
-              paint._objects, paint._data);
+    _beginDrawCommand(_CanvasCommand.drawOval, 4, paint);
+    _writeRect(rect.left, rect.top, rect.right, rect.bottom);
   }
-  void _drawOval(double left,
-                 double top,
-                 double right,
-                 double bottom,
-                 List<dynamic> paintObjects,
-                 ByteData paintData) native "Canvas_drawOval";
 
   /// Draws a circle centered at the point given by the first two arguments and
   /// that has the radius given by the third argument, with the [Paint] given in
   /// the fourth argument. Whether the circle is filled or stroked (or both) is
   /// controlled by [Paint.style].
   void drawCircle(Point c, double radius, Paint paint) {
-    _drawCircle(c.x, c.y, radius, paint._objects, paint._data);
+    _beginDrawCommand(_CanvasCommand.drawCircle, 3, paint);
+    _writeFloat(c.x);
+    _writeFloat(c.y);
+    _writeFloat(radius);
   }
-  void _drawCircle(double x,
-                   double y,
-                   double radius,
-                   List<dynamic> paintObjects,
-                   ByteData paintData) native "Canvas_drawCircle";
 
   /// Draw an arc scaled to fit inside the given rectangle. It starts from
   /// startAngle radians around the oval up to startAngle + sweepAngle
@@ -1323,23 +1521,18 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///
   /// This method is optimized for drawing arcs and should be faster than [Path.arcTo].
   void drawArc(Rect rect, double startAngle, double sweepAngle, bool useCenter, Paint paint) {
-    _drawArc(rect.left, rect.top, rect.right, rect.bottom, startAngle,
-             sweepAngle, useCenter, paint._objects, paint._data);
-  }
-  void _drawArc(double left,
-                double top,
-                double right,
-                double bottom,
-                double startAngle,
-                double sweepAngle,
-                bool useCenter,
-                List<dynamic> paintObjects,
-                ByteData paintData) native "Canvas_drawArc";
+    _beginDrawCommand(_CanvasCommand.drawArc, 7, paint);
+    _writeRect(rect.left, rect.top, rect.right, rect.bottom);
+    _writeFloat(startAngle);
+    _writeFloat(sweepAngle);
+    _writeUint(useCenter ? 1 : 0);
+  }
 
   /// Draws the given [Path] with the given [Paint]. Whether this shape is
   /// filled or stroked (or both) is controlled by [Paint.style]. If the path is
   /// filled, then subpaths within it are implicitly closed (see [Path.close]).
   void drawPath(Path path, Paint paint) {
+    _beginDirectCall();
     _drawPath(path, paint._objects, paint._data);
   }
   void _drawPath(Path path,
@@ -1349,6 +1542,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// Draws the given [Image] into the canvas with its top-left corner at the
   /// given [Point]. The image is composited into the canvas using the given [Paint].
   void drawImage(Image image, Point p, Paint paint) {
+    _beginDirectCall();
     _drawImage(image, p.x, p.y, paint._objects, paint._data);
   }
   void _drawImage(Image image,
@@ -1363,6 +1557,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// This might sample from outside the `src` rect by up to half the width of
   /// an applied filter.
   void drawImageRect(Image image, Rect src, Rect dst, Paint paint) {
+    _beginDirectCall();
     _drawImageRect(image,
                    src.left,
                    src.top,
@@ -1401,6 +1596,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// cover the destination rectangle while maintaining their relative
   /// positions.
   void drawImageNine(Image image, Rect center, Rect dst, Paint paint) {
+    _beginDirectCall();
     _drawImageNine(image,
                    center.left,
                    center.top,
@@ -1427,17 +1623,23 @@ class Canvas extends NativeFieldWrapperClass2 {
 
   /// Draw the given picture onto the canvas. To create a picture, see
   /// [PictureRecorder].
-  void drawPicture(Picture picture) native "Canvas_drawPicture";
+  void drawPicture(Picture picture) {
+    _beginDirectCall();
+    _drawPicture(picture);
+  }
+  void _drawPicture(Picture picture) native "Canvas_drawPicture";
 
   /// Draws the text in the given paragraph into this canvas at the given offset.
   ///
   /// Valid only after [Paragraph.layout] has been called on the paragraph.
   void drawParagraph(Paragraph paragraph, Offset offset) {
+    _beginDirectCall();
     paragraph._paint(this, offset.dx, offset.dy);
   }
 
   /// Draws a sequence of points according to the given [PointMode].
   void drawPoints(PointMode pointMode, List<Point> points, Paint paint) {
+    _beginDirectCall();
     _drawPoints(paint._objects, paint._data, pointMode.index, _encodePointList(points));
   }
   void _drawPoints(List<dynamic> paintObjects,
@@ -1464,6 +1666,7 @@ class Canvas extends NativeFieldWrapperClass2 {
     final Int32List colorBuffer = colors.isEmpty ? null : _encodeColorList(colors);
     final Int32List indexBuffer = new Int32List.fromList(indicies);
 
+    _beginDirectCall();
     _drawVertices(
       paint._objects, paint._data, vertexMode.index, vertexBuffer,
       textureCoordinateBuffer, colorBuffer, transferMode.index, indexBuffer
@@ -1516,6 +1719,7 @@ class Canvas extends NativeFieldWrapperClass2 {
     final Int32List colorBuffer = colors.isEmpty ? null : _encodeColorList(colors);
     final Float32List cullRectBuffer = cullRect?._value;
 
+    _beginDirectCall();
     _drawAtlas(
       paint._objects, paint._data, atlas, rstTransformBuffer, rectBuffer,
       colorBuffer, transferMode.index, cullRectBuffer
@@ -1545,6 +1749,25 @@ abstract class Picture extends NativeFieldWrapperClass2 {
   /// object. To create a Picture object, use a [PictureRecorder].
   Picture(); // (this constructor is here just so we can document it)
 
+  /// Creates an image from this picture.
+  ///
+  /// The picture is rasterized into an image of the given size, in pixels,
+  /// away from the UI thread. The image is texture-backed when the GPU is
+  /// available. When it is ready, the callback is invoked with the image, or
+  /// with null if it could not be created.
+  ///
+  /// Rasterizing an expensive picture once and drawing the resulting image
+  /// with [Canvas.drawImage] is faster than replaying the picture every frame.
+  void toImage(int width, int height, ImageDecoderCallback callback) {
+    if (width <= 0 || height <= 0)
+      throw new ArgumentError('Invalid image dimensions.');
+    final String error = _toImage(width, height, callback);
+    if (error != null)
+      throw new ArgumentError(error);
+  }
+  String _toImage(int width, int height, ImageDecoderCallback callback)
+      native "Picture_toImage";
+
   /// Release the resources used by this object. The object is no longer usable
   /// after this method is called.
   void dispose() native "Picture_dispose";
@@ -1577,5 +1800,14 @@ class PictureRecorder extends NativeFieldWrapperClass2 {
   /// and the canvas objects are invalid and cannot be used further.
   ///
   /// Returns null if the PictureRecorder is not associated with a canvas.
-  Picture endRecording() native "PictureRecorder_endRecording";
+  Picture endRecording() {
+    _canvas?._flushCommands();
+    _canvas = null;
+    return _endRecording();
+  }
+  Picture _endRecording() native "PictureRecorder_endRecording";
+
+  // The canvas recording into this object, whose buffered commands must reach
+  // the engine before the picture is finished.
+  Canvas _canvas;
 }
@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/painting/canvas.h"
 
 #include <math.h>
+#include <string.h>
 
 #include "flutter/lib/ui/painting/image.h"
 #include "flutter/lib/ui/painting/matrix.h"
@@ -24,29 +25,12 @@ static void Canvas_constructor(Dart_NativeArguments args) {
 IMPLEMENT_WRAPPERTYPEINFO(ui, Canvas);
 
 #define FOR_EACH_BINDING(V)         \
-  V(Canvas, save)                   \
   V(Canvas, saveLayerWithoutBounds) \
   V(Canvas, saveLayer)              \
-  V(Canvas, restore)                \
   V(Canvas, getSaveCount)           \
-  V(Canvas, translate)              \
-  V(Canvas, scale)                  \
-  V(Canvas, rotate)                 \
-  V(Canvas, skew)                   \
   V(Canvas, transform)              \
   V(Canvas, setMatrix)              \
-  V(Canvas, clipRect)               \
-  V(Canvas, clipRRect)              \
   V(Canvas, clipPath)               \
-  V(Canvas, drawColor)              \
-  V(Canvas, drawLine)               \
-  V(Canvas, drawPaint)              \
-  V(Canvas, drawRect)               \
-  V(Canvas, drawRRect)              \
-  V(Canvas, drawDRRect)             \
-  V(Canvas, drawOval)               \
-  V(Canvas, drawCircle)             \
-  V(Canvas, drawArc)                \
   V(Canvas, drawPath)               \
   V(Canvas, drawImage)              \
   V(Canvas, drawImageRect)          \
@@ -54,7 +38,8 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Canvas);
   V(Canvas, drawPicture)            \
   V(Canvas, drawPoints)             \
   V(Canvas, drawVertices)           \
-  V(Canvas, drawAtlas)
+  V(Canvas, drawAtlas)              \
+  V(Canvas, replay)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 
@@ -80,12 +65,6 @@ Canvas::Canvas(SkCanvas* canvas) : canvas_(canvas) {}
 
 Canvas::~Canvas() {}
 
-void Canvas::save() {
-  if (!canvas_)
-    return;
-  canvas_->save();
-}
-
 void Canvas::saveLayerWithoutBounds(const Paint& paint,
                                     const PaintData& paint_data) {
   if (!canvas_)
@@ -105,42 +84,12 @@ void Canvas::saveLayer(double left,
   canvas_->saveLayer(&bounds, paint.paint());
 }
 
-void Canvas::restore() {
-  if (!canvas_)
-    return;
-  canvas_->restore();
-}
-
 int Canvas::getSaveCount() {
   if (!canvas_)
     return 0;
   return canvas_->getSaveCount();
 }
 
-void Canvas::translate(double dx, double dy) {
-  if (!canvas_)
-    return;
-  canvas_->translate(dx, dy);
-}
-
-void Canvas::scale(double sx, double sy) {
-  if (!canvas_)
-    return;
-  canvas_->scale(sx, sy);
-}
-
-void Canvas::rotate(double radians) {
-  if (!canvas_)
-    return;
-  canvas_->rotate(radians * 180.0 / M_PI);
-}
-
-void Canvas::skew(double sx, double sy) {
-  if (!canvas_)
-    return;
-  canvas_->skew(sx, sy);
-}
-
 void Canvas::transform(const tonic::Float64List& matrix4) {
   if (!canvas_)
     return;
@@ -153,112 +102,12 @@ void Canvas::setMatrix(const tonic::Float64List& matrix4) {
   canvas_->setMatrix(ToSkMatrix(matrix4));
 }
 
-void Canvas::clipRect(double left, double top, double right, double bottom) {
-  if (!canvas_)
-    return;
-  canvas_->clipRect(SkRect::MakeLTRB(left, top, right, bottom));
-}
-
-void Canvas::clipRRect(const RRect& rrect) {
-  if (!canvas_)
-    return;
-  canvas_->clipRRect(rrect.sk_rrect, true);
-}
-
 void Canvas::clipPath(const CanvasPath* path) {
   if (!canvas_)
     return;
   canvas_->clipPath(path->path(), true);
 }
 
-void Canvas::drawColor(SkColor color, SkBlendMode blend_mode) {
-  if (!canvas_)
-    return;
-  canvas_->drawColor(color, blend_mode);
-}
-
-void Canvas::drawLine(double x1,
-                      double y1,
-                      double x2,
-                      double y2,
-                      const Paint& paint,
-                      const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  canvas_->drawLine(x1, y1, x2, y2, *paint.paint());
-}
-
-void Canvas::drawPaint(const Paint& paint, const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  canvas_->drawPaint(*paint.paint());
-}
-
-void Canvas::drawRect(double left,
-                      double top,
-                      double right,
-                      double bottom,
-                      const Paint& paint,
-                      const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  canvas_->drawRect(SkRect::MakeLTRB(left, top, right, bottom), *paint.paint());
-}
-
-void Canvas::drawRRect(const RRect& rrect,
-                       const Paint& paint,
-                       const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  canvas_->drawRRect(rrect.sk_rrect, *paint.paint());
-}
-
-void Canvas::drawDRRect(const RRect& outer,
-                        const RRect& inner,
-                        const Paint& paint,
-                        const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  canvas_->drawDRRect(outer.sk_rrect, inner.sk_rrect, *paint.paint());
-}
-
-void Canvas::drawOval(double left,
-                      double top,
-                      double right,
-                      double bottom,
-                      const Paint& paint,
-                      const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  canvas_->drawOval(SkRect::MakeLTRB(left, top, right, bottom), *paint.paint());
-}
-
-void Canvas::drawCircle(double x,
-                        double y,
-                        double radius,
-                        const Paint& paint,
-                        const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  canvas_->drawCircle(x, y, radius, *paint.paint());
-}
-
-void Canvas::drawArc(double left,
-                     double top,
-                     double right,
-                     double bottom,
-                     double startAngle,
-                     double sweepAngle,
-                     bool useCenter,
-                     const Paint& paint,
-                     const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  canvas_->drawArc(SkRect::MakeLTRB(left, top, right, bottom),
-                   startAngle * 180.0 / M_PI, sweepAngle * 180.0 / M_PI,
-                   useCenter, *paint.paint());
-}
-
 void Canvas::drawPath(const CanvasPath* path,
                       const Paint& paint,
                       const PaintData& paint_data) {
@@ -404,6 +253,239 @@ void Canvas::drawAtlas(const Paint& paint,
       paint.paint());
 }
 
+namespace {
+
+// Must match _CanvasCommand in painting.dart. Each command is a 32-bit opcode
+// followed by its arguments, one 32-bit word each: floats for coordinates and
+// angles, unsigned integers for colors, modes and flags.
+enum CanvasCommand : uint32_t {
+  kSave,
+  kRestore,
+  kTranslate,     // dx, dy
+  kScale,         // sx, sy
+  kRotate,        // radians
+  kSkew,          // sx, sy
+  kClipRect,      // left, top, right, bottom
+  kClipRRect,     // 12 floats, as in RRect._value
+  kDrawColor,     // color, transfer mode
+  kSetPaint,      // object index or kNoPaintObjects, then the paint's data
+  kDrawLine,      // x1, y1, x2, y2
+  kDrawPaint,
+  kDrawRect,      // left, top, right, bottom
+  kDrawRRect,     // 12 floats
+  kDrawDRRect,    // 12 floats outer, 12 floats inner
+  kDrawOval,      // left, top, right, bottom
+  kDrawCircle,    // x, y, radius
+  kDrawArc,       // left, top, right, bottom, start, sweep, use center
+  kCanvasCommandCount,
+};
+
+constexpr uint32_t kNoPaintObjects = 0xFFFFFFFF;
+constexpr size_t kPaintDataWordCount = kPaintDataByteCount / sizeof(uint32_t);
+
+// Reads 32-bit words from a command buffer. Callers check has() before
+// reading a command's arguments.
+class CommandReader {
+ public:
+  CommandReader(const void* data, size_t word_count)
+      : words_(static_cast<const uint32_t*>(data)),
+        end_(words_ + word_count) {}
+
+  bool done() const { return words_ == end_; }
+  bool has(size_t count) const {
+    return static_cast<size_t>(end_ - words_) >= count;
+  }
+
+  uint32_t ReadUint() { return *words_++; }
+  float ReadFloat() {
+    float value;
+    memcpy(&value, words_++, sizeof(value));
+    return value;
+  }
+  SkRect ReadRect() {
+    float l = ReadFloat(), t = ReadFloat(), r = ReadFloat(), b = ReadFloat();
+    return SkRect::MakeLTRB(l, t, r, b);
+  }
+  SkRRect ReadRRect() {
+    SkRect rect = ReadRect();
+    SkVector radii[4];
+    for (int i = 0; i < 4; ++i) {
+      float x = ReadFloat(), y = ReadFloat();
+      radii[i].set(x, y);
+    }
+    SkRRect rrect;
+    rrect.setRectRadii(rect, radii);
+    return rrect;
+  }
+  const uint32_t* Skip(size_t count) {
+    const uint32_t* result = words_;
+    words_ += count;
+    return result;
+  }
+
+ private:
+  const uint32_t* words_;
+  const uint32_t* end_;
+};
+
+// The number of argument words each command takes.
+size_t CommandArgumentCount(uint32_t command) {
+  switch (command) {
+    case kSave:
+    case kRestore:
+    case kDrawPaint:
+      return 0;
+    case kRotate:
+      return 1;
+    case kTranslate:
+    case kScale:
+    case kSkew:
+    case kDrawColor:
+      return 2;
+    case kDrawCircle:
+      return 3;
+    case kClipRect:
+    case kDrawLine:
+    case kDrawRect:
+    case kDrawOval:
+      return 4;
+    case kDrawArc:
+      return 7;
+    case kSetPaint:
+      return 1 + kPaintDataWordCount;
+    case kClipRRect:
+    case kDrawRRect:
+      return 12;
+    case kDrawDRRect:
+      return 24;
+  }
+  return 0;
+}
+
+}  // namespace
+
+void Canvas::replay(const PaintObjectList& paint_objects,
+                    const tonic::DartByteData& commands,
+                    int byte_count) {
+  if (!canvas_)
+    return;
+
+  if (byte_count < 0 ||
+      static_cast<size_t>(byte_count) > commands.length_in_bytes() ||
+      byte_count % sizeof(uint32_t) != 0) {
+    FTL_LOG(ERROR) << "Invalid canvas command buffer size: " << byte_count;
+    return;
+  }
+
+  // The paint is decoded once per kSetPaint and reused by every draw after
+  // it, rather than once per draw.
+  SkPaint paint;
+  CommandReader reader(commands.data(), byte_count / sizeof(uint32_t));
+  while (!reader.done()) {
+    // The buffer comes from Dart; stop at the first malformed command rather
+    // than read past the end of it.
+    uint32_t command = reader.ReadUint();
+    if (command >= kCanvasCommandCount ||
+        !reader.has(CommandArgumentCount(command))) {
+      FTL_LOG(ERROR) << "Invalid canvas command: " << command;
+      return;
+    }
+
+    switch (command) {
+      case kSave:
+        canvas_->save();
+        break;
+      case kRestore:
+        canvas_->restore();
+        break;
+      case kTranslate: {
+        float dx = reader.ReadFloat(), dy = reader.ReadFloat();
+        canvas_->translate(dx, dy);
+        break;
+      }
+      case kScale: {
+        float sx = reader.ReadFloat(), sy = reader.ReadFloat();
+        canvas_->scale(sx, sy);
+        break;
+      }
+      case kRotate:
+        canvas_->rotate(reader.ReadFloat() * 180.0 / M_PI);
+        break;
+      case kSkew: {
+        float sx = reader.ReadFloat(), sy = reader.ReadFloat();
+        canvas_->skew(sx, sy);
+        break;
+      }
+      case kClipRect:
+        canvas_->clipRect(reader.ReadRect());
+        break;
+      case kClipRRect:
+        canvas_->clipRRect(reader.ReadRRect(), true);
+        break;
+      case kDrawColor: {
+        SkColor color = reader.ReadUint();
+        SkBlendMode blend_mode = static_cast<SkBlendMode>(reader.ReadUint());
+        canvas_->drawColor(color, blend_mode);
+        break;
+      }
+      case kSetPaint: {
+        uint32_t object_index = reader.ReadUint();
+        paint = SkPaint();
+        if (object_index != kNoPaintObjects) {
+          if (object_index >= paint_objects.size() ||
+              object_index % kPaintObjectCount != 0) {
+            FTL_LOG(ERROR) << "Invalid canvas paint object index: "
+                           << object_index;
+            return;
+          }
+          paint_objects.Apply(object_index, &paint);
+        }
+        DecodePaintData(reader.Skip(kPaintDataWordCount), &paint);
+        break;
+      }
+      case kDrawLine: {
+        float x1 = reader.ReadFloat(), y1 = reader.ReadFloat();
+        float x2 = reader.ReadFloat(), y2 = reader.ReadFloat();
+        canvas_->drawLine(x1, y1, x2, y2, paint);
+        break;
+      }
+      case kDrawPaint:
+        canvas_->drawPaint(paint);
+        break;
+      case kDrawRect:
+        canvas_->drawRect(reader.ReadRect(), paint);
+        break;
+      case kDrawRRect:
+        canvas_->drawRRect(reader.ReadRRect(), paint);
+        break;
+      case kDrawDRRect: {
+        SkRRect outer = reader.ReadRRect();
+        SkRRect inner = reader.ReadRRect();
+        canvas_->drawDRRect(outer, inner, paint);
+        break;
+      }
+      case kDrawOval:
+        canvas_->drawOval(reader.ReadRect(), paint);
+        break;
+      case kDrawCircle: {
+        float x = reader.ReadFloat(), y = reader.ReadFloat();
+        float radius = reader.ReadFloat();
+        canvas_->drawCircle(x, y, radius, paint);
+        break;
+      }
+      case kDrawArc: {
+        SkRect rect = reader.ReadRect();
+        float start_angle = reader.ReadFloat();
+        float sweep_angle = reader.ReadFloat();
+        bool use_center = reader.ReadUint();
+        canvas_->drawArc(rect, start_angle * 180.0 / M_PI,
+                         sweep_angle * 180.0 / M_PI, use_center, paint);
+        break;
+      }
+    }
+  }
+}
+
 void Canvas::Clear() {
   canvas_ = nullptr;
 }
@@ -9,8 +9,8 @@
 #include "flutter/lib/ui/painting/path.h"
 #include "flutter/lib/ui/painting/picture.h"
 #include "flutter/lib/ui/painting/picture_recorder.h"
-#include "flutter/lib/ui/painting/rrect.h"
 #include "lib/tonic/dart_wrappable.h"
+#include "lib/tonic/typed_data/dart_byte_data.h"
 #include "lib/tonic/typed_data/float32_list.h"
 #include "lib/tonic/typed_data/float64_list.h"
 #include "lib/tonic/typed_data/int32_list.h"
@@ -37,7 +37,6 @@ class Canvas : public ftl::RefCountedThreadSafe<Canvas>,
 
   ~Canvas() override;
 
-  void save();
   void saveLayerWithoutBounds(const Paint& paint, const PaintData& paint_data);
   void saveLayer(double left,
                  double top,
@@ -45,61 +44,13 @@ class Canvas : public ftl::RefCountedThreadSafe<Canvas>,
                  double bottom,
                  const Paint& paint,
                  const PaintData& paint_data);
-  void restore();
   int getSaveCount();
 
-  void translate(double dx, double dy);
-  void scale(double sx, double sy);
-  void rotate(double radians);
-  void skew(double sx, double sy);
   void transform(const tonic::Float64List& matrix4);
   void setMatrix(const tonic::Float64List& matrix4);
 
-  void clipRect(double left, double top, double right, double bottom);
-  void clipRRect(const RRect& rrect);
   void clipPath(const CanvasPath* path);
 
-  void drawColor(SkColor color, SkBlendMode blend_mode);
-  void drawLine(double x1,
-                double y1,
-                double x2,
-                double y2,
-                const Paint& paint,
-                const PaintData& paint_data);
-  void drawPaint(const Paint& paint, const PaintData& paint_data);
-  void drawRect(double left,
-                double top,
-                double right,
-                double bottom,
-                const Paint& paint,
-                const PaintData& paint_data);
-  void drawRRect(const RRect& rrect,
-                 const Paint& paint,
-                 const PaintData& paint_data);
-  void drawDRRect(const RRect& outer,
-                  const RRect& inner,
-                  const Paint& paint,
-                  const PaintData& paint_data);
-  void drawOval(double left,
-                double top,
-                double right,
-                double bottom,
-                const Paint& paint,
-                const PaintData& paint_data);
-  void drawCircle(double x,
-                  double y,
-                  double radius,
-                  const Paint& paint,
-                  const PaintData& paint_data);
-  void drawArc(double left,
-               double top,
-               double right,
-               double bottom,
-               double startAngle,
-               double sweepAngle,
-               bool useCenter,
-               const Paint& paint,
-               const PaintData& paint_data);
   void drawPath(const CanvasPath* path,
                 const Paint& paint,
                 const PaintData& paint_data);
@@ -160,6 +111,14 @@ class Canvas : public ftl::RefCountedThreadSafe<Canvas>,
                  SkXfermode::Mode transfer_mode,
                  const tonic::Float32List& cull_rect);
 
+  // Plays back the first |byte_count| bytes of a command buffer encoded by
+  // the Dart Canvas (see _CanvasCommand in painting.dart). Paint objects are
+  // referenced by their index in |paint_objects|, which is why that argument
+  // comes first.
+  void replay(const PaintObjectList& paint_objects,
+              const tonic::DartByteData& commands,
+              int byte_count);
+
   SkCanvas* canvas() const { return canvas_; }
   void Clear();
   bool IsRecording() const;
@@ -9,6 +9,9 @@
 #include "lib/tonic/dart_binding_macros.h"
 #include "lib/tonic/converter/dart_converter.h"
 #include "lib/tonic/dart_library_natives.h"
+#include "lib/tonic/dart_persistent_value.h"
+#include "lib/tonic/dart_state.h"
+#include "lib/tonic/logging/dart_invoke.h"
 
 namespace blink {
 
@@ -40,4 +43,19 @@ void CanvasImage::dispose() {
   ClearDartWrapper();
 }
 
+void InvokeImageCallback(sk_sp<SkImage> image,
+                         std::unique_ptr<tonic::DartPersistentValue> callback) {
+  tonic::DartState* dart_state = callback->dart_state().get();
+  if (!dart_state)
+    return;
+  tonic::DartState::Scope scope(dart_state);
+  if (!image) {
+    tonic::DartInvoke(callback->value(), {Dart_Null()});
+  } else {
+    ftl::RefPtr<CanvasImage> result_image = CanvasImage::Create();
+    result_image->set_image(std::move(image));
+    tonic::DartInvoke(callback->value(), {tonic::ToDart(result_image)});
+  }
+}
+
 }  // namespace blink
@@ -5,11 +5,14 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_H_
 
+#include <memory>
+
 #include "lib/tonic/dart_wrappable.h"
 #include "third_party/skia/include/core/SkImage.h"
 
 namespace tonic {
 class DartLibraryNatives;
+class DartPersistentValue;
 }  // namespace tonic
 
 namespace blink {
@@ -40,6 +43,12 @@ class CanvasImage final : public ftl::RefCountedThreadSafe<CanvasImage>,
   sk_sp<SkImage> image_;
 };
 
+// Invokes |callback|, an ImageDecoderCallback, with |image| wrapped in an
+// Image, or with null if |image| is null. Does nothing if the callback's
+// isolate has shut down. Must be called on the UI thread.
+void InvokeImageCallback(sk_sp<SkImage> image,
+                         std::unique_ptr<tonic::DartPersistentValue> callback);
+
 }  // namespace blink
 
 #endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_H_
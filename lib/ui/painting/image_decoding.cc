@@ -10,14 +10,14 @@
 #include "flutter/glue/trace_event.h"
 #include "flutter/lib/ui/painting/image.h"
 #include "flutter/lib/ui/painting/resource_context.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 #include "lib/ftl/functional/make_copyable.h"
+#include "lib/tonic/converter/dart_converter.h"
 #include "lib/tonic/dart_persistent_value.h"
 #include "lib/tonic/dart_state.h"
-#include "lib/tonic/logging/dart_invoke.h"
 #include "lib/tonic/typed_data/uint8_list.h"
 #include "third_party/skia/include/core/SkImageGenerator.h"
 
-using tonic::DartInvoke;
 using tonic::DartPersistentValue;
 using tonic::ToDart;
 
@@ -30,6 +30,18 @@ sk_sp<SkImage> DecodeImage(std::vector<uint8_t> buffer) {
   if (buffer.empty())
     return nullptr;
 
+  GrContext* context = ResourceContext::Get();
+
+  // Pre-compressed textures go straight to the GPU. There is no CPU decoder
+  // for them, so they fail to load where the GPU cannot sample the format.
+  if (flow::TextureContainerIsKTX(buffer.data(), buffer.size())) {
+    flow::TextureContainer container;
+    if (!flow::TextureContainerParseKTX(buffer.data(), buffer.size(),
+                                        &container))
+      return nullptr;
+    return flow::TextureImageCreate(context, container);
+  }
+
   sk_sp<SkData> sk_data = SkData::MakeWithoutCopy(buffer.data(), buffer.size());
 
   if (sk_data == nullptr)
@@ -42,7 +54,6 @@ sk_sp<SkImage> DecodeImage(std::vector<uint8_t> buffer) {
     return nullptr;
 
   // First, try to create a texture image from the generator.
-  GrContext* context = ResourceContext::Get();
   if (sk_sp<SkImage> image = flow::TextureImageCreate(context, *generator))
     return image;
 
@@ -51,19 +62,47 @@ sk_sp<SkImage> DecodeImage(std::vector<uint8_t> buffer) {
   return flow::BitmapImageCreate(*generator);
 }
 
-void InvokeImageCallback(sk_sp<SkImage> image,
-                         std::unique_ptr<DartPersistentValue> callback) {
-  tonic::DartState* dart_state = callback->dart_state().get();
-  if (!dart_state)
+void ReleaseImageOnIOThread(sk_sp<SkImage> image) {
+  // Texture images belong to the IO thread's context.
+  if (!image)
+    return;
+  SkImage* raw_image = image.release();
+  Threads::IO()->PostTask([raw_image]() { raw_image->unref(); });
+}
+
+void TakeWarmupImage(Dart_NativeArguments args) {
+  if (UIDartState::Current()->is_background_isolate()) {
+    Dart_ThrowException(
+        ToDart("Warmup images cannot be taken in a background isolate"));
+    return;
+  }
+
+  Dart_Handle exception = nullptr;
+  std::string asset_name =
+      tonic::DartConverter<std::string>::FromArguments(args, 0, exception);
+  if (exception) {
+    Dart_ThrowException(exception);
+    return;
+  }
+
+  Dart_Handle callback_handle = Dart_GetNativeArgument(args, 1);
+  if (!Dart_IsClosure(callback_handle)) {
+    Dart_ThrowException(ToDart("Callback must be a function"));
+    return;
+  }
+
+  auto callback = std::make_unique<DartPersistentValue>(
+      tonic::DartState::Current(), callback_handle);
+
+  if (ImageWarmup* image_warmup = UIDartState::Current()->image_warmup()) {
+    image_warmup->Take(asset_name, std::move(callback));
     return;
-  tonic::DartState::Scope scope(dart_state);
-  if (!image) {
-    DartInvoke(callback->value(), {Dart_Null()});
-  } else {
-    ftl::RefPtr<CanvasImage> resultImage = CanvasImage::Create();
-    resultImage->set_image(std::move(image));
-    DartInvoke(callback->value(), {ToDart(resultImage)});
   }
+
+  Threads::UI()->PostTask(
+      ftl::MakeCopyable([callback = std::move(callback)]() mutable {
+        InvokeImageCallback(nullptr, std::move(callback));
+      }));
 }
 
 void DecodeImageAndInvokeImageCallback(
@@ -77,6 +116,12 @@ void DecodeImageAndInvokeImageCallback(
 }
 
 void DecodeImageFromList(Dart_NativeArguments args) {
+  if (UIDartState::Current()->is_background_isolate()) {
+    Dart_ThrowException(
+        ToDart("Images cannot be decoded in a background isolate"));
+    return;
+  }
+
   Dart_Handle exception = nullptr;
 
   tonic::Uint8List list =
@@ -106,9 +151,128 @@ void DecodeImageFromList(Dart_NativeArguments args) {
 
 }  // namespace
 
+ImageWarmup::ImageWarmup() : weak_factory_(this) {}
+
+ImageWarmup::~ImageWarmup() {
+  Purge();
+}
+
+void ImageWarmup::Start(const std::vector<std::string>& asset_names,
+                        AssetReader reader) {
+  TRACE_EVENT1("flutter", "ImageWarmup::Start", "count", asset_names.size());
+  for (auto& entry : images_) {
+    ReleaseImageOnIOThread(std::move(entry.second.image));
+    for (auto& callback : entry.second.callbacks) {
+      Threads::UI()->PostTask(
+          ftl::MakeCopyable([callback = std::move(callback)]() mutable {
+            InvokeImageCallback(nullptr, std::move(callback));
+          }));
+    }
+  }
+  images_.clear();
+  reader_ = reader;
+  int generation = ++generation_;
+  ftl::WeakPtr<ImageWarmup> weak_this = weak_factory_.GetWeakPtr();
+
+  // One task per image, so that decodes Dart requests in the meantime are
+  // not stuck behind the whole list.
+  for (const std::string& asset_name : asset_names) {
+    images_[asset_name];
+    Threads::IO()->PostTask([weak_this, generation, asset_name, reader]() {
+      TRACE_EVENT0("flutter", "DecodeWarmupImage");
+      std::vector<uint8_t> buffer;
+      sk_sp<SkImage> image;
+      if (reader(asset_name, &buffer))
+        image = DecodeImage(std::move(buffer));
+      Threads::UI()->PostTask(ftl::MakeCopyable([
+        weak_this, generation, asset_name, image = std::move(image)
+      ]() mutable {
+        if (weak_this)
+          weak_this->DidDecode(generation, asset_name, std::move(image));
+        else
+          ReleaseImageOnIOThread(std::move(image));
+      }));
+    });
+  }
+}
+
+void ImageWarmup::Take(const std::string& asset_name,
+                       std::unique_ptr<DartPersistentValue> callback) {
+  auto it = images_.find(asset_name);
+  if (it != images_.end() && !it->second.decoded) {
+    it->second.callbacks.push_back(std::move(callback));
+    return;
+  }
+
+  // Each image is handed out once, so that Dart owns it from then on.
+  sk_sp<SkImage> image;
+  if (it != images_.end()) {
+    image = std::move(it->second.image);
+    images_.erase(it);
+  }
+
+  // Like decodeImageFromList, never invoke the callback synchronously.
+  Threads::UI()->PostTask(ftl::MakeCopyable([
+    callback = std::move(callback), image = std::move(image)
+  ]() mutable { InvokeImageCallback(std::move(image), std::move(callback)); }));
+}
+
+void ImageWarmup::Purge() {
+  // Entries still decoding are kept, as callers may be waiting on them.
+  for (auto it = images_.begin(); it != images_.end();) {
+    if (it->second.decoded) {
+      ReleaseImageOnIOThread(std::move(it->second.image));
+      it = images_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ImageWarmup::DidDecode(int generation,
+                            const std::string& asset_name,
+                            sk_sp<SkImage> image) {
+  auto it = images_.find(asset_name);
+  if (generation != generation_ || it == images_.end()) {
+    ReleaseImageOnIOThread(std::move(image));
+    return;
+  }
+
+  Entry& entry = it->second;
+  if (entry.callbacks.empty()) {
+    entry.decoded = true;
+    entry.image = std::move(image);
+    return;
+  }
+
+  std::vector<std::unique_ptr<DartPersistentValue>> callbacks =
+      std::move(entry.callbacks);
+  images_.erase(it);
+
+  // The first caller gets the warmup image. The others each get their own,
+  // as Dart owns an image once it is handed out.
+  auto callback = callbacks.begin();
+  InvokeImageCallback(std::move(image), std::move(*callback));
+  for (++callback; callback != callbacks.end(); ++callback)
+    DecodeAgain(asset_name, std::move(*callback));
+}
+
+void ImageWarmup::DecodeAgain(const std::string& asset_name,
+                              std::unique_ptr<DartPersistentValue> callback) {
+  Threads::IO()->PostTask(ftl::MakeCopyable([
+    asset_name, reader = reader_, callback = std::move(callback)
+  ]() mutable {
+    std::vector<uint8_t> buffer;
+    if (!reader(asset_name, &buffer))
+      buffer.clear();
+    DecodeImageAndInvokeImageCallback(std::move(callback), std::move(buffer));
+  }));
+}
+
 void ImageDecoding::RegisterNatives(tonic::DartLibraryNatives* natives) {
   natives->Register({
       {"decodeImageFromList", DecodeImageFromList, 2, true},
+      {"takeWarmupImage", TakeWarmupImage, 2, true},
   });
 }
 
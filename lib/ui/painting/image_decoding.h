@@ -5,10 +5,74 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_DECODING_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODING_H_
 
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "lib/ftl/macros.h"
+#include "lib/ftl/memory/weak_ptr.h"
 #include "lib/tonic/dart_library_natives.h"
+#include "lib/tonic/dart_persistent_value.h"
+#include "third_party/skia/include/core/SkImage.h"
 
 namespace blink {
 
+// Images one engine decodes and uploads ahead of its first frames, so that
+// they are ready by the time Dart asks for them with takeWarmupImage(). Lives
+// on the UI thread.
+class ImageWarmup {
+ public:
+  // Reads an asset into |data|. Must be callable from the IO thread.
+  using AssetReader =
+      std::function<bool(const std::string& asset_name,
+                         std::vector<uint8_t>* data)>;
+
+  ImageWarmup();
+  ~ImageWarmup();
+
+  // Starts decoding the given assets on the IO thread. Called before the
+  // isolate starts. Images from an earlier warmup that were never taken are
+  // dropped.
+  void Start(const std::vector<std::string>& asset_names, AssetReader reader);
+
+  // Hands the image for |asset_name| to |callback| on a later UI task, once
+  // it is decoded. Each image is handed out once; the callback receives null
+  // if the asset was not listed, has been taken or has been purged.
+  void Take(const std::string& asset_name,
+            std::unique_ptr<tonic::DartPersistentValue> callback);
+
+  // Drops the images that are ready but not taken yet, e.g. on memory
+  // pressure.
+  void Purge();
+
+ private:
+  struct Entry {
+    bool decoded = false;
+    sk_sp<SkImage> image;
+    // Callers that asked before the image was ready.
+    std::vector<std::unique_ptr<tonic::DartPersistentValue>> callbacks;
+  };
+
+  void DidDecode(int generation,
+                 const std::string& asset_name,
+                 sk_sp<SkImage> image);
+  // Decodes |asset_name| once more, for a caller that waited alongside the
+  // one that got the warmup image.
+  void DecodeAgain(const std::string& asset_name,
+                   std::unique_ptr<tonic::DartPersistentValue> callback);
+
+  AssetReader reader_;
+  std::unordered_map<std::string, Entry> images_;
+  // Distinguishes the current warmup from earlier ones still decoding.
+  int generation_ = 0;
+
+  ftl::WeakPtrFactory<ImageWarmup> weak_factory_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(ImageWarmup);
+};
+
 class ImageDecoding {
  public:
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
@@ -4,7 +4,7 @@
 
 #include "flutter/lib/ui/painting/mask_filter.h"
 
-#include "flutter/common/threads.h"
+#include "flutter/common/worker_pool.h"
 #include "lib/tonic/dart_args.h"
 #include "lib/tonic/dart_binding_macros.h"
 #include "lib/tonic/converter/dart_converter.h"
@@ -36,10 +36,12 @@ MaskFilter::MaskFilter(sk_sp<SkMaskFilter> filter)
     : filter_(std::move(filter)) {}
 
 MaskFilter::~MaskFilter() {
-  // Skia objects must be deleted on the IO thread so that any associated GL
-  // objects will be cleaned up through the IO thread's GL context.
+  // Mask filters hold no GL objects, so unlike other Skia objects they need
+  // not wait behind image uploads on the IO thread to be deleted.
   SkMaskFilter* filter = filter_.release();
-  Threads::IO()->PostTask([filter]() { filter->unref(); });
+  WorkerPool::Get().PostTask(WorkerPool::Priority::kBackground,
+                             "MaskFilter::unref",
+                             [filter]() { filter->unref(); });
 }
 
 }  // namespace blink
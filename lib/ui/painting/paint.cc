@@ -13,9 +13,8 @@
 #include "third_party/skia/include/core/SkShader.h"
 #include "third_party/skia/include/core/SkString.h"
 
-using namespace blink;
-
-namespace tonic {
+namespace blink {
+namespace {
 
 constexpr int kIsAntiAliasIndex = 0;
 constexpr int kColorIndex = 1;
@@ -27,91 +26,137 @@ constexpr int kFilterQualityIndex = 6;
 constexpr int kColorFilterIndex = 7;
 constexpr int kColorFilterColorIndex = 8;
 constexpr int kColorFilterTransferModeIndex = 9;
-constexpr size_t kDataByteCount = 40;
 
 constexpr int kMaskFilterIndex = 0;
 constexpr int kShaderIndex = 1;
-constexpr int kObjectCount = 2;  // Must be one larger than the largest index
-
-Paint DartConverter<Paint>::FromArguments(Dart_NativeArguments args,
-                                          int index,
-                                          Dart_Handle& exception) {
-  Dart_Handle paint_objects = Dart_GetNativeArgument(args, index);
-  FTL_DCHECK(!LogIfError(paint_objects));
-
-  Dart_Handle paint_data = Dart_GetNativeArgument(args, index + 1);
-  FTL_DCHECK(!LogIfError(paint_data));
-
-  Paint result;
-  SkPaint& paint = result.paint_;
-
-  if (!Dart_IsNull(paint_objects)) {
-    FTL_DCHECK(Dart_IsList(paint_objects));
-    intptr_t length = 0;
-    Dart_ListLength(paint_objects, &length);
-
-    FTL_CHECK(length == kObjectCount);
-    Dart_Handle values[kObjectCount];
-    if (Dart_IsError(Dart_ListGetRange(paint_objects, 0, kObjectCount, values)))
-      return result;
-
-    Dart_Handle mask_filter = values[kMaskFilterIndex];
-    if (!Dart_IsNull(mask_filter)) {
-      MaskFilter* decoded = DartConverter<MaskFilter*>::FromDart(mask_filter);
-      paint.setMaskFilter(decoded->filter());
-    }
+static_assert(kPaintObjectCount == kShaderIndex + 1,
+              "kPaintObjectCount must be one larger than the largest index");
+
+// Unwraps one paint's kPaintObjectCount entries. Returns false if any of them
+// is neither null nor of the expected type.
+bool DecodePaintObjects(const Dart_Handle* values,
+                        sk_sp<SkMaskFilter>* mask_filter,
+                        sk_sp<SkShader>* shader) {
+  Dart_Handle mask_filter_handle = values[kMaskFilterIndex];
+  if (!Dart_IsNull(mask_filter_handle)) {
+    MaskFilter* decoded =
+        tonic::DartConverter<MaskFilter*>::FromDart(mask_filter_handle);
+    if (!decoded)
+      return false;
+    *mask_filter = decoded->filter();
+  }
 
-    Dart_Handle shader = values[kShaderIndex];
-    if (!Dart_IsNull(shader)) {
-      Shader* decoded = DartConverter<Shader*>::FromDart(shader);
-      paint.setShader(decoded->shader());
-    }
+  Dart_Handle shader_handle = values[kShaderIndex];
+  if (!Dart_IsNull(shader_handle)) {
+    Shader* decoded = tonic::DartConverter<Shader*>::FromDart(shader_handle);
+    if (!decoded)
+      return false;
+    *shader = decoded->shader();
   }
+  return true;
+}
 
-  tonic::DartByteData byte_data(paint_data);
-  FTL_CHECK(byte_data.length_in_bytes() == kDataByteCount);
+}  // namespace
 
-  const uint32_t* uint_data = static_cast<const uint32_t*>(byte_data.data());
-  const float* float_data = static_cast<const float*>(byte_data.data());
+void DecodePaintData(const void* data, SkPaint* paint) {
+  const uint32_t* uint_data = static_cast<const uint32_t*>(data);
+  const float* float_data = static_cast<const float*>(data);
 
-  paint.setAntiAlias(uint_data[kIsAntiAliasIndex] == 0);
+  paint->setAntiAlias(uint_data[kIsAntiAliasIndex] == 0);
 
   uint32_t encoded_color = uint_data[kColorIndex];
   if (encoded_color) {
     SkColor color = encoded_color ^ 0xFF000000;
-    paint.setColor(color);
+    paint->setColor(color);
   }
 
   uint32_t encoded_blend_mode = uint_data[kBlendModeIndex];
   if (encoded_blend_mode) {
     uint32_t transfer_mode =
         encoded_blend_mode ^ static_cast<uint32_t>(SkBlendMode::kSrcOver);
-    paint.setBlendMode(static_cast<SkBlendMode>(transfer_mode));
+    paint->setBlendMode(static_cast<SkBlendMode>(transfer_mode));
   }
 
   uint32_t style = uint_data[kStyleIndex];
   if (style)
-    paint.setStyle(static_cast<SkPaint::Style>(style));
+    paint->setStyle(static_cast<SkPaint::Style>(style));
 
   float stroke_width = float_data[kStrokeWidthIndex];
   if (stroke_width != 0.0)
-    paint.setStrokeWidth(stroke_width);
+    paint->setStrokeWidth(stroke_width);
 
   uint32_t stroke_cap = uint_data[kStrokeCapIndex];
   if (stroke_cap)
-    paint.setStrokeCap(static_cast<SkPaint::Cap>(stroke_cap));
+    paint->setStrokeCap(static_cast<SkPaint::Cap>(stroke_cap));
 
   uint32_t filter_quality = uint_data[kFilterQualityIndex];
   if (filter_quality)
-    paint.setFilterQuality(static_cast<SkFilterQuality>(filter_quality));
+    paint->setFilterQuality(static_cast<SkFilterQuality>(filter_quality));
 
   if (uint_data[kColorFilterIndex]) {
     SkColor color = uint_data[kColorFilterColorIndex];
     SkXfermode::Mode transfer_mode =
         static_cast<SkXfermode::Mode>(uint_data[kColorFilterTransferModeIndex]);
-    paint.setColorFilter(SkColorFilter::MakeModeFilter(color, transfer_mode));
+    paint->setColorFilter(SkColorFilter::MakeModeFilter(color, transfer_mode));
+  }
+}
+
+void PaintObjectList::Apply(size_t index, SkPaint* paint) const {
+  FTL_DCHECK(index % kPaintObjectCount == 0);
+  FTL_DCHECK(index < size());
+  size_t paint_index = index / kPaintObjectCount;
+  paint->setMaskFilter(mask_filters_[paint_index]);
+  paint->setShader(shaders_[paint_index]);
+}
+
+}  // namespace blink
+
+using namespace blink;
+
+namespace tonic {
+
+Paint DartConverter<Paint>::FromArguments(Dart_NativeArguments args,
+                                          int index,
+                                          Dart_Handle& exception) {
+  Dart_Handle paint_objects = Dart_GetNativeArgument(args, index);
+  FTL_DCHECK(!LogIfError(paint_objects));
+
+  Dart_Handle paint_data = Dart_GetNativeArgument(args, index + 1);
+  FTL_DCHECK(!LogIfError(paint_data));
+
+  Paint result;
+  SkPaint& paint = result.paint_;
+
+  if (!Dart_IsNull(paint_objects)) {
+    intptr_t length = 0;
+    if (!Dart_IsList(paint_objects) ||
+        Dart_IsError(Dart_ListLength(paint_objects, &length)) ||
+        length != kPaintObjectCount) {
+      exception = ToDart("Invalid paint objects");
+      return result;
+    }
+
+    Dart_Handle values[kPaintObjectCount];
+    if (Dart_IsError(
+            Dart_ListGetRange(paint_objects, 0, kPaintObjectCount, values)))
+      return result;
+
+    sk_sp<SkMaskFilter> mask_filter;
+    sk_sp<SkShader> shader;
+    if (!DecodePaintObjects(values, &mask_filter, &shader)) {
+      exception = ToDart("Invalid paint objects");
+      return result;
+    }
+    if (mask_filter)
+      paint.setMaskFilter(std::move(mask_filter));
+    if (shader)
+      paint.setShader(std::move(shader));
   }
 
+  tonic::DartByteData byte_data(paint_data);
+  FTL_CHECK(byte_data.length_in_bytes() == kPaintDataByteCount);
+  DecodePaintData(byte_data.data(), &paint);
+
   result.is_null_ = false;
   return result;
 }
@@ -122,4 +167,42 @@ PaintData DartConverter<PaintData>::FromArguments(Dart_NativeArguments args,
   return PaintData();
 }
 
+PaintObjectList DartConverter<PaintObjectList>::FromArguments(
+    Dart_NativeArguments args,
+    int index,
+    Dart_Handle& exception) {
+  Dart_Handle objects = Dart_GetNativeArgument(args, index);
+  FTL_DCHECK(!LogIfError(objects));
+
+  PaintObjectList result;
+  if (Dart_IsNull(objects))
+    return result;
+
+  // The list is built by Canvas in painting.dart, but a malformed one must not
+  // take the engine down.
+  intptr_t length = 0;
+  if (!Dart_IsList(objects) ||
+      Dart_IsError(Dart_ListLength(objects, &length)) ||
+      length % kPaintObjectCount != 0) {
+    exception = ToDart("Invalid paint object list");
+    return result;
+  }
+
+  size_t paint_count = length / kPaintObjectCount;
+  result.mask_filters_.resize(paint_count);
+  result.shaders_.resize(paint_count);
+  for (size_t i = 0; i < paint_count; ++i) {
+    Dart_Handle values[kPaintObjectCount];
+    if (Dart_IsError(Dart_ListGetRange(objects, i * kPaintObjectCount,
+                                       kPaintObjectCount, values)))
+      return PaintObjectList();
+    if (!DecodePaintObjects(values, &result.mask_filters_[i],
+                            &result.shaders_[i])) {
+      exception = ToDart("Invalid paint object list");
+      return PaintObjectList();
+    }
+  }
+  return result;
+}
+
 }  // namespace tonic
@@ -5,11 +5,25 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PAINT_H_
 #define FLUTTER_LIB_UI_PAINTING_PAINT_H_
 
+#include <vector>
+
 #include "lib/tonic/converter/dart_converter.h"
+#include "third_party/skia/include/core/SkMaskFilter.h"
 #include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkShader.h"
 
 namespace blink {
 
+// The size of a Paint's binary data and the number of entries in its object
+// list. Must match _kDataByteCount and the length of _objects in Paint in
+// painting.dart.
+constexpr size_t kPaintDataByteCount = 40;
+constexpr int kPaintObjectCount = 2;
+
+// Applies one Paint's binary data, which must be kPaintDataByteCount long, on
+// top of the defaults in |paint|.
+void DecodePaintData(const void* data, SkPaint* paint);
+
 class Paint {
  public:
   const SkPaint* paint() const { return is_null_ ? nullptr : &paint_; }
@@ -27,6 +41,24 @@ class Paint {
 // data for a Paint object).
 class PaintData {};
 
+// The object lists of several Paints, concatenated. Canvas command buffers
+// refer to a paint's objects by the index of its first entry in this list.
+// The objects are unwrapped when the list is converted, so that the command
+// buffer can be read afterwards without re-entering the VM.
+class PaintObjectList {
+ public:
+  // Applies the objects starting at |index| to |paint|.
+  void Apply(size_t index, SkPaint* paint) const;
+
+  size_t size() const { return mask_filters_.size() * kPaintObjectCount; }
+
+ private:
+  friend struct tonic::DartConverter<PaintObjectList>;
+
+  std::vector<sk_sp<SkMaskFilter>> mask_filters_;
+  std::vector<sk_sp<SkShader>> shaders_;
+};
+
 }  // namespace blink
 
 namespace tonic {
@@ -45,6 +77,13 @@ struct DartConverter<blink::PaintData> {
                                         Dart_Handle& exception);
 };
 
+template <>
+struct DartConverter<blink::PaintObjectList> {
+  static blink::PaintObjectList FromArguments(Dart_NativeArguments args,
+                                              int index,
+                                              Dart_Handle& exception);
+};
+
 }  // namespace tonic
 
 #endif  // FLUTTER_LIB_UI_PAINTING_PAINT_H_
@@ -5,17 +5,90 @@
 #include "flutter/lib/ui/painting/picture.h"
 
 #include "flutter/common/threads.h"
+#include "flutter/flow/bitmap_image.h"
+#include "flutter/flow/texture_image.h"
+#include "flutter/glue/trace_event.h"
 #include "flutter/lib/ui/painting/canvas.h"
+#include "flutter/lib/ui/painting/image.h"
+#include "flutter/lib/ui/painting/resource_context.h"
+#include "flutter/lib/ui/ui_dart_state.h"
+#include "lib/ftl/functional/make_copyable.h"
 #include "lib/tonic/dart_args.h"
 #include "lib/tonic/dart_binding_macros.h"
 #include "lib/tonic/converter/dart_converter.h"
 #include "lib/tonic/dart_library_natives.h"
+#include "lib/tonic/dart_persistent_value.h"
+#include "lib/tonic/dart_state.h"
+#include "third_party/skia/include/core/SkImageGenerator.h"
+
+using tonic::DartPersistentValue;
+using tonic::ToDart;
 
 namespace blink {
+namespace {
+
+sk_sp<SkImage> RasterizePicture(sk_sp<SkPicture> picture,
+                                uint32_t width,
+                                uint32_t height) {
+  TRACE_EVENT2("flutter", "RasterizePicture", "width", width, "height",
+               height);
+
+  if (!picture || !width || !height)
+    return nullptr;
+
+  // The generator plays the picture back into a bitmap when asked for its
+  // pixels, which lets us share the upload path with decoded images.
+  std::unique_ptr<SkImageGenerator> generator(SkImageGenerator::NewFromPicture(
+      SkISize::Make(width, height), picture.get(), nullptr, nullptr));
+  if (!generator)
+    return nullptr;
+
+  // First, try to create a texture image from the generator.
+  GrContext* context = ResourceContext::Get();
+  if (sk_sp<SkImage> image = flow::TextureImageCreate(context, *generator))
+    return image;
+
+  // Then, as a fallback, try to create a regular Skia managed image.
+  return flow::BitmapImageCreate(*generator);
+}
+
+}  // namespace
+
+Dart_Handle RasterizeToImage(sk_sp<SkPicture> picture,
+                             uint32_t width,
+                             uint32_t height,
+                             Dart_Handle callback) {
+  if (!Dart_IsClosure(callback))
+    return ToDart("Callback must be a function");
+  if (UIDartState::Current()->is_background_isolate())
+    return ToDart("Images cannot be created in a background isolate");
+
+  RasterizeToImage(std::move(picture), width, height,
+                   std::make_unique<DartPersistentValue>(
+                       tonic::DartState::Current(), callback));
+  return Dart_Null();
+}
+
+void RasterizeToImage(sk_sp<SkPicture> picture,
+                      uint32_t width,
+                      uint32_t height,
+                      std::unique_ptr<DartPersistentValue> callback) {
+  Threads::IO()->PostTask(ftl::MakeCopyable([
+    picture = std::move(picture), width, height, callback = std::move(callback)
+  ]() mutable {
+    sk_sp<SkImage> image = RasterizePicture(std::move(picture), width, height);
+    Threads::UI()->PostTask(
+        ftl::MakeCopyable([ callback = std::move(callback), image ]() mutable {
+          InvokeImageCallback(image, std::move(callback));
+        }));
+  }));
+}
 
 IMPLEMENT_WRAPPERTYPEINFO(ui, Picture);
 
-#define FOR_EACH_BINDING(V) V(Picture, dispose)
+#define FOR_EACH_BINDING(V) \
+  V(Picture, toImage)       \
+  V(Picture, dispose)
 
 DART_BIND_ALL(Picture, FOR_EACH_BINDING)
 
@@ -32,6 +105,12 @@ Picture::~Picture() {
   Threads::IO()->PostTask([picture]() { picture->unref(); });
 }
 
+Dart_Handle Picture::toImage(uint32_t width,
+                             uint32_t height,
+                             Dart_Handle callback) {
+  return RasterizeToImage(picture_, width, height, callback);
+}
+
 void Picture::dispose() {
   ClearDartWrapper();
 }
@@ -5,16 +5,35 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PICTURE_H_
 #define FLUTTER_LIB_UI_PAINTING_PICTURE_H_
 
+#include <memory>
+
 #include "lib/tonic/dart_wrappable.h"
 #include "third_party/skia/include/core/SkPicture.h"
 
 namespace tonic {
 class DartLibraryNatives;
+class DartPersistentValue;
 }  // namespace tonic
 
 namespace blink {
 class Canvas;
 
+// Rasterizes |picture| into a |width| by |height| image on the IO thread,
+// texture-backed when a resource context is available, and then invokes
+// |callback| on the UI thread with the resulting Image, or null on failure.
+// Returns null, or a message for an ArgumentError if |callback| is not a
+// function or the caller is a background isolate.
+Dart_Handle RasterizeToImage(sk_sp<SkPicture> picture,
+                             uint32_t width,
+                             uint32_t height,
+                             Dart_Handle callback);
+
+// Like the above, for a callback that has already been checked.
+void RasterizeToImage(sk_sp<SkPicture> picture,
+                      uint32_t width,
+                      uint32_t height,
+                      std::unique_ptr<tonic::DartPersistentValue> callback);
+
 class Picture : public ftl::RefCountedThreadSafe<Picture>,
                 public tonic::DartWrappable {
   DEFINE_WRAPPERTYPEINFO();
@@ -26,6 +45,8 @@ class Picture : public ftl::RefCountedThreadSafe<Picture>,
 
   const sk_sp<SkPicture>& picture() const { return picture_; }
 
+  Dart_Handle toImage(uint32_t width, uint32_t height, Dart_Handle callback);
+
   void dispose();
 
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
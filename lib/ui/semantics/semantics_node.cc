@@ -20,4 +20,12 @@ bool SemanticsNode::HasFlag(SemanticsFlags flag) {
   return (flags & static_cast<int32_t>(flag)) != 0;
 }
 
+bool SemanticsNode::operator==(const SemanticsNode& other) const {
+  // Cheapest comparisons first; most nodes in an update differ, if at all,
+  // only in their geometry.
+  return id == other.id && flags == other.flags && actions == other.actions &&
+         rect == other.rect && children == other.children &&
+         transform == other.transform && label == other.label;
+}
+
 }  // namespace blink
@@ -40,6 +40,12 @@ struct SemanticsNode {
   bool HasAction(SemanticsAction action);
   bool HasFlag(SemanticsFlags flag);
 
+  // Whether the two nodes would look the same to the platform.
+  bool operator==(const SemanticsNode& other) const;
+  bool operator!=(const SemanticsNode& other) const {
+    return !(*this == other);
+  }
+
   int32_t id = 0;
   int32_t flags = 0;
   int32_t actions = 0;
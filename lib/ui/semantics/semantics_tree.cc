@@ -0,0 +1,88 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/semantics/semantics_tree.h"
+
+#include "flutter/glue/trace_event.h"
+
+namespace blink {
+namespace {
+
+// Must match the id of the root node created by the framework.
+constexpr int32_t kRootNodeId = 0;
+
+}  // namespace
+
+SemanticsTree::SemanticsTree() = default;
+
+SemanticsTree::~SemanticsTree() = default;
+
+void SemanticsTree::Update(std::vector<SemanticsNode> nodes) {
+  TRACE_EVENT1("flutter", "SemanticsTree::Update", "nodes", nodes.size());
+  for (SemanticsNode& node : nodes) {
+    auto result = nodes_.emplace(node.id, SemanticsNode());
+    SemanticsNode& current = result.first->second;
+    bool is_new = result.second;
+    if (!is_new && current == node)
+      continue;
+
+    if (is_new || current.children != node.children)
+      children_changed_ = true;
+    current = std::move(node);
+    // A node already queued by an earlier update is sent only once, with its
+    // latest contents.
+    if (pending_ids_.insert(current.id).second)
+      pending_.push_back(current.id);
+  }
+}
+
+std::vector<SemanticsNode> SemanticsTree::TakePendingUpdate() {
+  if (children_changed_)
+    RemoveUnreachableNodes();
+
+  std::vector<SemanticsNode> update;
+  update.reserve(pending_.size());
+  for (int32_t id : pending_) {
+    auto it = nodes_.find(id);
+    if (it != nodes_.end())
+      update.push_back(it->second);
+  }
+  pending_.clear();
+  pending_ids_.clear();
+  return update;
+}
+
+void SemanticsTree::Clear() {
+  nodes_.clear();
+  pending_.clear();
+  pending_ids_.clear();
+  children_changed_ = false;
+}
+
+void SemanticsTree::RemoveUnreachableNodes() {
+  children_changed_ = false;
+  if (nodes_.find(kRootNodeId) == nodes_.end())
+    return;
+
+  std::unordered_set<int32_t> reachable;
+  std::vector<int32_t> stack(1, kRootNodeId);
+  while (!stack.empty()) {
+    int32_t id = stack.back();
+    stack.pop_back();
+    auto it = nodes_.find(id);
+    if (it == nodes_.end() || !reachable.insert(id).second)
+      continue;
+    stack.insert(stack.end(), it->second.children.begin(),
+                 it->second.children.end());
+  }
+
+  for (auto it = nodes_.begin(); it != nodes_.end();) {
+    if (reachable.count(it->first))
+      ++it;
+    else
+      it = nodes_.erase(it);
+  }
+}
+
+}  // namespace blink
@@ -0,0 +1,58 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_TREE_H_
+#define FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_TREE_H_
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/lib/ui/semantics/semantics_node.h"
+#include "lib/ftl/macros.h"
+
+namespace blink {
+
+// Mirrors the semantics tree the platform has been sent, so that updates from
+// the framework can be reduced to the nodes that actually changed.
+//
+// Updates are applied as they arrive and the changed nodes accumulate until
+// they are taken, so several updates in one frame reach the platform as one,
+// with at most one copy of each node.
+class SemanticsTree {
+ public:
+  SemanticsTree();
+  ~SemanticsTree();
+
+  // Applies |nodes| and queues those that differ from the current tree.
+  void Update(std::vector<SemanticsNode> nodes);
+
+  bool HasPendingUpdate() const { return !pending_.empty(); }
+
+  // Returns the nodes changed since the last call, and drops nodes that are
+  // no longer reachable from the root.
+  std::vector<SemanticsNode> TakePendingUpdate();
+
+  // Forgets the tree, so that the next update is forwarded in full. Used
+  // when the platform side starts over, for example when semantics are
+  // re-enabled.
+  void Clear();
+
+  size_t size() const { return nodes_.size(); }
+
+ private:
+  void RemoveUnreachableNodes();
+
+  std::unordered_map<int32_t, SemanticsNode> nodes_;
+  // Ids of changed nodes, in the order they were first changed.
+  std::vector<int32_t> pending_;
+  std::unordered_set<int32_t> pending_ids_;
+  bool children_changed_ = false;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(SemanticsTree);
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_LIB_UI_SEMANTICS_SEMANTICS_TREE_H_
@@ -0,0 +1,121 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/semantics/semantics_tree.h"
+
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace blink {
+namespace {
+
+SemanticsNode Node(int32_t id,
+                   std::vector<int32_t> children = std::vector<int32_t>(),
+                   std::string label = std::string()) {
+  SemanticsNode node;
+  node.id = id;
+  node.children = std::move(children);
+  node.label = std::move(label);
+  return node;
+}
+
+std::vector<int32_t> Ids(const std::vector<SemanticsNode>& nodes) {
+  std::vector<int32_t> ids;
+  for (const SemanticsNode& node : nodes)
+    ids.push_back(node.id);
+  return ids;
+}
+
+// A root with two leaves, already sent to the platform.
+void SendInitialTree(SemanticsTree* tree) {
+  tree->Update({Node(0, {1, 2}), Node(1), Node(2)});
+  tree->TakePendingUpdate();
+}
+
+}  // namespace
+
+TEST(SemanticsTreeTest, SendsAddedNodes) {
+  SemanticsTree tree;
+  SendInitialTree(&tree);
+
+  tree.Update({Node(0, {1, 2, 3}), Node(3, {}, "added")});
+  ASSERT_TRUE(tree.HasPendingUpdate());
+
+  std::vector<SemanticsNode> update = tree.TakePendingUpdate();
+  EXPECT_EQ((std::vector<int32_t>{0, 3}), Ids(update));
+  EXPECT_EQ("added", update[1].label);
+  EXPECT_EQ(4u, tree.size());
+  EXPECT_FALSE(tree.HasPendingUpdate());
+}
+
+TEST(SemanticsTreeTest, DropsRemovedNodes) {
+  SemanticsTree tree;
+  tree.Update({Node(0, {1}), Node(1, {2}), Node(2)});
+  tree.TakePendingUpdate();
+
+  // Detaching a node also drops the subtree below it.
+  tree.Update({Node(0)});
+  EXPECT_EQ((std::vector<int32_t>{0}), Ids(tree.TakePendingUpdate()));
+  EXPECT_EQ(1u, tree.size());
+
+  // A node that comes back is new again, and sent in full.
+  tree.Update({Node(0, {1}), Node(1)});
+  EXPECT_EQ((std::vector<int32_t>{0, 1}), Ids(tree.TakePendingUpdate()));
+}
+
+TEST(SemanticsTreeTest, PrunesUnchangedNodes) {
+  SemanticsTree tree;
+  SendInitialTree(&tree);
+
+  // Resending the same tree sends nothing.
+  tree.Update({Node(0, {1, 2}), Node(1), Node(2)});
+  EXPECT_FALSE(tree.HasPendingUpdate());
+  EXPECT_TRUE(tree.TakePendingUpdate().empty());
+
+  // Only the node that changed is sent, not its unchanged parent or sibling.
+  tree.Update({Node(0, {1, 2}), Node(1), Node(2, {}, "changed")});
+  std::vector<SemanticsNode> update = tree.TakePendingUpdate();
+  EXPECT_EQ((std::vector<int32_t>{2}), Ids(update));
+  EXPECT_EQ("changed", update[0].label);
+}
+
+TEST(SemanticsTreeTest, CoalescesUpdatesInOneFrame) {
+  SemanticsTree tree;
+  SendInitialTree(&tree);
+
+  tree.Update({Node(2, {}, "first")});
+  tree.Update({Node(1, {}, "other")});
+  tree.Update({Node(2, {}, "second")});
+
+  // Each node is sent once, with its latest contents, in the order it first
+  // changed.
+  std::vector<SemanticsNode> update = tree.TakePendingUpdate();
+  EXPECT_EQ((std::vector<int32_t>{2, 1}), Ids(update));
+  EXPECT_EQ("second", update[0].label);
+  EXPECT_EQ("other", update[1].label);
+}
+
+TEST(SemanticsTreeTest, DoesNotSendNodesAddedAndRemovedInOneFrame) {
+  SemanticsTree tree;
+  SendInitialTree(&tree);
+
+  tree.Update({Node(0, {1, 2, 3}), Node(3)});
+  tree.Update({Node(0, {1, 2})});
+
+  EXPECT_EQ((std::vector<int32_t>{0}), Ids(tree.TakePendingUpdate()));
+  EXPECT_EQ(3u, tree.size());
+}
+
+TEST(SemanticsTreeTest, SendsEverythingAfterClear) {
+  SemanticsTree tree;
+  SendInitialTree(&tree);
+
+  tree.Clear();
+  tree.Update({Node(0, {1, 2}), Node(1), Node(2)});
+  EXPECT_EQ((std::vector<int32_t>{0, 1, 2}), Ids(tree.TakePendingUpdate()));
+}
+
+}  // namespace blink
@@ -44,16 +44,16 @@ void SemanticsUpdateBuilder::updateNode(int id,
                                         std::string label,
                                         const tonic::Float64List& transform,
                                         const tonic::Int32List& children) {
-  SemanticsNode node;
+  nodes_.emplace_back();
+  SemanticsNode& node = nodes_.back();
   node.id = id;
   node.flags = flags;
   node.actions = actions;
   node.rect = SkRect::MakeLTRB(left, top, right, bottom);
-  node.label = label;
+  node.label = std::move(label);
   node.transform.setColMajord(transform.data());
-  node.children = std::vector<int32_t>(
-      children.data(), children.data() + children.num_elements());
-  nodes_.push_back(node);
+  node.children.assign(children.data(),
+                       children.data() + children.num_elements());
 }
 
 ftl::RefPtr<SemanticsUpdate> SemanticsUpdateBuilder::build() {
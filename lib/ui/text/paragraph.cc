@@ -38,14 +38,19 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Paragraph);
 
 DART_BIND_ALL(Paragraph, FOR_EACH_BINDING)
 
-Paragraph::Paragraph(PassOwnPtr<RenderView> renderView)
-    : m_renderView(renderView) {}
+Paragraph::Paragraph(PassOwnPtr<RenderView> renderView,
+                     PassRefPtr<RenderArena> arena)
+    : m_renderView(renderView), m_arena(arena) {}
 
 Paragraph::~Paragraph() {
   if (m_renderView) {
+    // The arena is not thread-safe, so release it on the UI thread too.
     RenderView* renderView = m_renderView.leakPtr();
-    Threads::UI()->PostTask(
-        [renderView]() { renderView->destroy(); });
+    RenderArena* arena = m_arena.release().leakRef();
+    Threads::UI()->PostTask([renderView, arena]() {
+      renderView->destroy();
+      arena->deref();
+    });
   }
 }
 
@@ -77,6 +82,7 @@ double Paragraph::ideographicBaseline() {
 
 void Paragraph::layout(double width) {
   FontCachePurgePreventer fontCachePurgePreventer;
+  RenderArena::Scope arenaScope(m_arena.get());
 
   int maxWidth = LayoutUnit(width);  // Handles infinity properly.
   m_renderView->setFrameViewSize(IntSize(maxWidth, intMaxForLayoutUnit));
@@ -89,6 +95,7 @@ void Paragraph::paint(Canvas* canvas, double x, double y) {
     return;
 
   FontCachePurgePreventer fontCachePurgePreventer;
+  RenderArena::Scope arenaScope(m_arena.get());
 
   // Very simplified painting to allow painting an arbitrary (layer-less)
   // subtree.
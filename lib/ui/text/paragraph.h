@@ -7,6 +7,7 @@
 
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/text/text_box.h"
+#include "flutter/sky/engine/core/rendering/RenderArena.h"
 #include "flutter/sky/engine/core/rendering/RenderView.h"
 #include "lib/tonic/dart_wrappable.h"
 
@@ -22,8 +23,9 @@ class Paragraph : public ftl::RefCountedThreadSafe<Paragraph>,
   FRIEND_MAKE_REF_COUNTED(Paragraph);
 
  public:
-  static ftl::RefPtr<Paragraph> create(PassOwnPtr<RenderView> renderView) {
-    return ftl::MakeRefCounted<Paragraph>(renderView);
+  static ftl::RefPtr<Paragraph> create(PassOwnPtr<RenderView> renderView,
+                                       PassRefPtr<RenderArena> arena) {
+    return ftl::MakeRefCounted<Paragraph>(renderView, arena);
   }
 
   ~Paragraph() override;
@@ -51,9 +53,11 @@ class Paragraph : public ftl::RefCountedThreadSafe<Paragraph>,
 
   int absoluteOffsetForPosition(const PositionWithAffinity& position);
 
-  explicit Paragraph(PassOwnPtr<RenderView> renderView);
+  Paragraph(PassOwnPtr<RenderView> renderView, PassRefPtr<RenderArena> arena);
 
   OwnPtr<RenderView> m_renderView;
+  // Backs m_renderView's objects and any created while laying it out.
+  RefPtr<RenderArena> m_arena;
 };
 
 }  // namespace blink
@@ -160,6 +160,11 @@ Color getColorFromARGB(int argb) {
 }  // namespace
 
 static void ParagraphBuilder_constructor(Dart_NativeArguments args) {
+  if (UIDartState::Current()->is_background_isolate()) {
+    Dart_ThrowException(
+        tonic::ToDart("Text cannot be laid out in a background isolate"));
+    return;
+  }
   DartCallConstructor(&ParagraphBuilder::create, args);
 }
 
@@ -193,7 +198,9 @@ ParagraphBuilder::ParagraphBuilder(tonic::Int32List& encoded,
                                    const std::string& fontFamily,
                                    double fontSize,
                                    double lineHeight,
-                                   const std::string& ellipsis) {
+                                   const std::string& ellipsis)
+    : m_arena(RenderArena::create()) {
+  RenderArena::Scope arenaScope(m_arena.get());
   createRenderView();
 
   RefPtr<RenderStyle> paragraphStyle = decodeParagraphStyle(
@@ -210,8 +217,11 @@ ParagraphBuilder::ParagraphBuilder(tonic::Int32List& encoded,
 ParagraphBuilder::~ParagraphBuilder() {
   if (m_renderView) {
     RenderView* renderView = m_renderView.leakPtr();
-    Threads::UI()->PostTask(
-        [renderView]() { renderView->destroy(); });
+    RenderArena* arena = m_arena.release().leakRef();
+    Threads::UI()->PostTask([renderView, arena]() {
+      renderView->destroy();
+      arena->deref();
+    });
   }
 }
 
@@ -222,6 +232,7 @@ void ParagraphBuilder::pushStyle(tonic::Int32List& encoded,
                                  double wordSpacing,
                                  double height) {
   FTL_DCHECK(encoded.num_elements() == 8);
+  RenderArena::Scope arenaScope(m_arena.get());
   RefPtr<RenderStyle> style = RenderStyle::create();
   style->inheritFrom(m_currentRenderObject->style());
 
@@ -304,6 +315,7 @@ void ParagraphBuilder::pop() {
 void ParagraphBuilder::addText(const std::string& text) {
   if (!m_currentRenderObject)
     return;
+  RenderArena::Scope arenaScope(m_arena.get());
   RenderText* renderText = new RenderText(String::fromUTF8(text).impl());
   RefPtr<RenderStyle> style = RenderStyle::create();
   style->inheritFrom(m_currentRenderObject->style());
@@ -313,7 +325,7 @@ void ParagraphBuilder::addText(const std::string& text) {
 
 ftl::RefPtr<Paragraph> ParagraphBuilder::build() {
   m_currentRenderObject = nullptr;
-  return Paragraph::create(m_renderView.release());
+  return Paragraph::create(m_renderView.release(), m_arena.release());
 }
 
 void ParagraphBuilder::createRenderView() {
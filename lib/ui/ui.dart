@@ -15,6 +15,7 @@ import 'dart:_internal';
 import 'dart:async';
 import 'dart:convert';
 import 'dart:developer' as developer;
+import 'dart:isolate';
 import 'dart:math' as math;
 import 'dart:nativewrappers';
 import 'dart:typed_data';
@@ -38,7 +38,9 @@ UIDartState::~UIDartState() {
 }
 
 UIDartState* UIDartState::CreateForChildIsolate() {
-  return new UIDartState(isolate_client_, nullptr);
+  UIDartState* child = new UIDartState(isolate_client_, nullptr);
+  child->set_is_background_isolate(is_background_isolate_);
+  return child;
 }
 
 void UIDartState::DidSetIsolate() {
@@ -16,6 +16,7 @@
 namespace blink {
 struct DartJniIsolateData;
 class FontSelector;
+class ImageWarmup;
 class Window;
 
 class IsolateClient {
@@ -47,6 +48,19 @@ class UIDartState : public tonic::DartState {
   void set_font_selector(PassRefPtr<FontSelector> selector);
   PassRefPtr<FontSelector> font_selector();
 
+  // The engine's startup images. Not owned; outlives this state.
+  void set_image_warmup(ImageWarmup* image_warmup) {
+    image_warmup_ = image_warmup;
+  }
+  ImageWarmup* image_warmup() const { return image_warmup_; }
+
+  // Background isolates run on worker threads. The natives that call back on
+  // the UI thread, or lay out text with the caches it owns, throw there.
+  bool is_background_isolate() const { return is_background_isolate_; }
+  void set_is_background_isolate(bool is_background_isolate) {
+    is_background_isolate_ = is_background_isolate;
+  }
+
  private:
   void DidSetIsolate() override;
 
@@ -55,6 +69,8 @@ class UIDartState : public tonic::DartState {
   std::string debug_name_;
   std::unique_ptr<Window> window_;
   RefPtr<FontSelector> font_selector_;
+  ImageWarmup* image_warmup_ = nullptr;
+  bool is_background_isolate_ = false;
 
 #if defined(OS_ANDROID)
   std::unique_ptr<DartJniIsolateData> jni_data_;
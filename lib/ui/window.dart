@@ -25,6 +25,9 @@ typedef void PlatformMessageResponseCallback(ByteData data);
 /// Signature for [Window.onPlatformMessage].
 typedef void PlatformMessageCallback(String name, ByteData data, PlatformMessageResponseCallback callback);
 
+/// Signature for functions run by [Window.runInBackground].
+typedef void BackgroundEntryPoint(SendPort port);
+
 /// States that an application can be in.
 enum AppLifecycleState {
   /// The application is not currently visible to the user. When the
@@ -237,6 +240,34 @@ class Window {
   /// Called by [_dispatchPlatformMessage].
   void _respondToPlatformMessage(int responseId, ByteData data)
       native "Window_respondToPlatformMessage";
+
+  /// Calls `entryPoint(port)` on one of the engine's background isolates.
+  ///
+  /// Use this for CPU-heavy work, such as parsing large JSON documents, that
+  /// would otherwise make the UI isolate miss frames.
+  /// The `entryPoint` parameter must be a top-level function; the background
+  /// isolate runs the same program as this one but shares none of its state,
+  /// so the work and its results are exchanged as messages through `port` and
+  /// any ports sent over it.
+  ///
+  /// The engine starts background isolates as they are needed, up to one fewer
+  /// than it has worker threads, and gives each call to the least busy one.
+  /// They live as long as the application, so top-level variables they set are
+  /// still there for later calls that run on the same isolate. Their messages
+  /// are handled on the engine's worker threads, ahead of the engine's own
+  /// background work.
+  ///
+  /// If the background isolate cannot be started, `entryPoint` is not called
+  /// and the error message is sent to `port` as a [String] instead.
+  ///
+  /// Background isolates cannot decode images, turn pictures or scenes into
+  /// images, or build paragraphs; those calls throw there. Send the data to the
+  /// UI isolate for that.
+  ///
+  /// Can only be called from the UI isolate. In precompiled applications,
+  /// `entryPoint` must be listed as an entry point so that it is not removed.
+  void runInBackground(BackgroundEntryPoint entryPoint, SendPort port)
+      native "Window_runInBackground";
 }
 
 /// The [Window] singleton. This object exposes the size of the display, the
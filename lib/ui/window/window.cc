@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/window/window.h"
 
+#include "dart/runtime/include/dart_mirrors_api.h"
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
@@ -41,6 +42,33 @@ Dart_Handle ToByteData(const std::vector<uint8_t>& buffer) {
   return data_handle;
 }
 
+Dart_Handle ToInt32List(const std::vector<int32_t>& values) {
+  Dart_Handle list_handle =
+      Dart_NewTypedData(Dart_TypedData_kInt32, values.size());
+  if (Dart_IsError(list_handle) || values.empty())
+    return list_handle;
+
+  Dart_TypedData_Type type;
+  void* data = nullptr;
+  intptr_t length = 0;
+  FTL_CHECK(!Dart_IsError(
+      Dart_TypedDataAcquireData(list_handle, &type, &data, &length)));
+
+  memcpy(data, values.data(), values.size() * sizeof(int32_t));
+  Dart_TypedDataReleaseData(list_handle);
+  return list_handle;
+}
+
+// Fails the messages that could not be handed to the framework, so that their
+// senders are not left waiting.
+void CompleteWithError(
+    const std::vector<ftl::RefPtr<PlatformMessage>>& messages) {
+  for (const auto& message : messages) {
+    if (message->response())
+      message->response()->CompleteWithError();
+  }
+}
+
 void ScheduleFrame(Dart_NativeArguments args) {
   UIDartState::Current()->window()->client()->ScheduleFrame();
 }
@@ -103,6 +131,36 @@ void _RespondToPlatformMessage(Dart_NativeArguments args) {
   tonic::DartCallStatic(&RespondToPlatformMessage, args);
 }
 
+void RunInBackground(Dart_NativeArguments args) {
+  Window* window = UIDartState::Current()->window();
+  if (!window) {
+    Dart_ThrowException(
+        ToDart("Only the UI isolate can run functions in the background"));
+    return;
+  }
+
+  // The closure cannot be sent to another isolate, but a top-level function
+  // can be found there by name.
+  Dart_Handle function = Dart_ClosureFunction(Dart_GetNativeArgument(args, 1));
+  Dart_Handle owner =
+      Dart_IsError(function) ? function : Dart_FunctionOwner(function);
+  if (Dart_IsError(owner) || !Dart_IsLibrary(owner)) {
+    Dart_ThrowException(ToDart("The entry point must be a top-level function"));
+    return;
+  }
+
+  Dart_Port port = ILLEGAL_PORT;
+  if (Dart_IsError(
+          Dart_SendPortGetId(Dart_GetNativeArgument(args, 2), &port))) {
+    Dart_ThrowException(ToDart("Expected a SendPort"));
+    return;
+  }
+
+  window->client()->RunInBackground(
+      tonic::StdStringFromDart(Dart_LibraryUrl(owner)),
+      tonic::StdStringFromDart(Dart_FunctionName(function)), port);
+}
+
 }  // namespace
 
 WindowClient::~WindowClient() {}
@@ -167,17 +225,68 @@ void Window::DispatchPlatformMessage(ftl::RefPtr<PlatformMessage> message) {
   if (Dart_IsError(data_handle))
     return;
 
-  int response_id = 0;
-  if (auto response = message->response()) {
-    response_id = next_response_id_++;
-    pending_responses_[response_id] = response;
-  }
+  int response_id = RegisterResponse(*message);
 
   DartInvokeField(
       library_.value(), "_dispatchPlatformMessage",
       {ToDart(message->channel()), data_handle, ToDart(response_id)});
 }
 
+void Window::DispatchPlatformMessages(
+    std::vector<ftl::RefPtr<PlatformMessage>> messages) {
+  if (messages.size() == 1) {
+    DispatchPlatformMessage(std::move(messages.front()));
+    return;
+  }
+
+  tonic::DartState* dart_state = library_.dart_state().get();
+  if (!dart_state)
+    return;
+  tonic::DartState::Scope scope(dart_state);
+
+  // Response ids are handed out up front but only registered once every
+  // handle is built, so that a failure leaves no response waiting on a
+  // framework that never heard of it.
+  std::vector<uint8_t> data;
+  std::vector<int32_t> lengths;
+  std::vector<int32_t> response_ids;
+  int next_response_id = next_response_id_;
+  Dart_Handle channels = Dart_NewList(messages.size());
+  if (Dart_IsError(channels)) {
+    CompleteWithError(messages);
+    return;
+  }
+  for (size_t i = 0; i < messages.size(); ++i) {
+    const PlatformMessage& message = *messages[i];
+    if (Dart_IsError(Dart_ListSetAt(channels, i, ToDart(message.channel())))) {
+      CompleteWithError(messages);
+      return;
+    }
+    data.insert(data.end(), message.data().begin(), message.data().end());
+    lengths.push_back(static_cast<int32_t>(message.data().size()));
+    response_ids.push_back(message.response() ? next_response_id++ : 0);
+  }
+
+  Dart_Handle data_handle = ToByteData(data);
+  Dart_Handle lengths_handle = ToInt32List(lengths);
+  Dart_Handle response_ids_handle = ToInt32List(response_ids);
+  if (Dart_IsError(data_handle) || Dart_IsError(lengths_handle) ||
+      Dart_IsError(response_ids_handle)) {
+    CompleteWithError(messages);
+    return;
+  }
+
+  for (size_t i = 0; i < messages.size(); ++i) {
+    if (response_ids[i])
+      pending_responses_[response_ids[i]] = messages[i]->response();
+  }
+  next_response_id_ = next_response_id;
+
+  DartInvokeField(library_.value(), "_dispatchPlatformMessages",
+                  {channels, data_handle, lengths_handle,
+                   response_ids_handle});
+}
+
 void Window::DispatchPointerDataPacket(const PointerDataPacket& packet) {
   tonic::DartState* dart_state = library_.dart_state().get();
   if (!dart_state)
@@ -215,6 +324,15 @@ void Window::BeginFrame(ftl::TimePoint frameTime) {
                   });
 }
 
+int Window::RegisterResponse(const PlatformMessage& message) {
+  auto response = message.response();
+  if (!response)
+    return 0;
+  int response_id = next_response_id_++;
+  pending_responses_[response_id] = response;
+  return response_id;
+}
+
 void Window::CompletePlatformMessageResponse(int response_id,
                                              std::vector<uint8_t> data) {
   if (!response_id)
@@ -234,6 +352,7 @@ void Window::RegisterNatives(tonic::DartLibraryNatives* natives) {
       {"Window_respondToPlatformMessage", _RespondToPlatformMessage, 3, true},
       {"Window_render", Render, 2, true},
       {"Window_updateSemantics", UpdateSemantics, 2, true},
+      {"Window_runInBackground", RunInBackground, 3, true},
   });
 }
 
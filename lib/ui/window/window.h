@@ -6,6 +6,7 @@
 #define FLUTTER_LIB_UI_WINDOW_WINDOW_H_
 
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/lib/ui/semantics/semantics_update.h"
 #include "flutter/lib/ui/window/platform_message.h"
@@ -27,6 +28,9 @@ class WindowClient {
   virtual void Render(Scene* scene) = 0;
   virtual void UpdateSemantics(SemanticsUpdate* update) = 0;
   virtual void HandlePlatformMessage(ftl::RefPtr<PlatformMessage> message) = 0;
+  virtual void RunInBackground(const std::string& library_url,
+                               const std::string& function_name,
+                               Dart_Port port) = 0;
 
  protected:
   virtual ~WindowClient();
@@ -45,6 +49,10 @@ class Window {
                     const std::string& country_code);
   void UpdateSemanticsEnabled(bool enabled);
   void DispatchPlatformMessage(ftl::RefPtr<PlatformMessage> message);
+  // Hands |messages| to the framework in a single call, with their payloads
+  // copied into one buffer.
+  void DispatchPlatformMessages(
+      std::vector<ftl::RefPtr<PlatformMessage>> messages);
   void DispatchPointerDataPacket(const PointerDataPacket& packet);
   void DispatchSemanticsAction(int32_t id, SemanticsAction action);
   void BeginFrame(ftl::TimePoint frameTime);
@@ -55,6 +63,8 @@ class Window {
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
+  int RegisterResponse(const PlatformMessage& message);
+
   WindowClient* client_;
   tonic::DartPersistentValue library_;
 
@@ -4,13 +4,22 @@
 
 #include "flutter/runtime/asset_font_selector.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "flutter/assets/zip_asset_store.h"
+#include "flutter/common/threads.h"
+#include "flutter/common/worker_pool.h"
+#include "flutter/glue/trace_event.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/sky/engine/platform/fonts/FontData.h"
 #include "flutter/sky/engine/platform/fonts/FontFaceCreationParams.h"
+#include "flutter/sky/engine/platform/fonts/GlyphPageTreeNode.h"
 #include "flutter/sky/engine/platform/fonts/SimpleFontData.h"
 #include "lib/ftl/arraysize.h"
+#include "lib/ftl/synchronization/mutex.h"
 #include "third_party/rapidjson/rapidjson/document.h"
+#include "third_party/skia/include/core/SkPaint.h"
 #include "third_party/skia/include/core/SkStream.h"
 #include "third_party/skia/include/core/SkTypeface.h"
 #include "third_party/skia/include/ports/SkFontMgr.h"
@@ -26,17 +35,42 @@ struct AssetFontSelector::FlutterFontAttributes {
   FontStyle style;
 };
 
-// A Skia typeface along with a buffer holding the raw typeface asset data.
+// A Skia typeface along with a buffer holding the raw typeface asset data,
+// unless the typeface reads it from the mapped FLX.
 struct AssetFontSelector::TypefaceAsset {
   TypefaceAsset();
   ~TypefaceAsset();
   sk_sp<SkTypeface> typeface;
   std::vector<uint8_t> data;
+  // When the typeface was last looked up, for eviction.
+  uint64_t last_use = 0;
+};
+
+// Typefaces loaded ahead of time for the selector of |asset_store|. Each
+// engine prewarms on its own, so engines never drop each other's typefaces.
+struct AssetFontSelector::PrewarmState {
+  explicit PrewarmState(ftl::RefPtr<ZipAssetStore> store)
+      : asset_store(std::move(store)) {}
+
+  const ftl::RefPtr<ZipAssetStore> asset_store;
+
+  ftl::Mutex mutex;
+  // Guarded by |mutex|.
+  bool done = false;
+  std::unordered_map<std::string, std::unique_ptr<TypefaceAsset>> typefaces;
+
+  // A selector installed before the typefaces were loaded. Only used on the
+  // UI thread.
+  RefPtr<AssetFontSelector> waiting_selector;
 };
 
 namespace {
 const char kFontManifestAssetPath[] = "FontManifest.json";
 
+// How much memory font files inflated from the FLX may take before unused
+// ones are evicted. A single CJK font can be larger than this.
+const size_t kTypefaceHeapBudget = 8 * 1024 * 1024;
+
 // Weight values corresponding to the members of the FontWeight enum.
 const int kFontWeightValue[] = {100, 200, 300, 400, 500, 600, 700, 800, 900};
 
@@ -49,6 +83,37 @@ int getFontWeightValue(FontWeight weight) {
              : kFontWeightNormal;
 }
 
+FontWeight getFontWeight(int weight_value) {
+  int weight_index = std::min<int>(std::max(weight_value / 100 - 1, 0),
+                                   arraysize(kFontWeightValue) - 1);
+  return static_cast<FontWeight>(weight_index);
+}
+
+// The text size prewarmed fonts are prepared for, the framework's default.
+const float kPrewarmFontSize = 14.0f;
+
+// Fills Skia's glyph cache with the Latin-1 metrics of |typeface|.
+void warmGlyphCache(const sk_sp<SkTypeface>& typeface) {
+  const int kFirstCharacter = 0x20;
+  const int kCharacterCount = 0x100 - kFirstCharacter;
+  SkUnichar characters[kCharacterCount];
+  for (int i = 0; i < kCharacterCount; ++i)
+    characters[i] = kFirstCharacter + i;
+
+  uint16_t glyphs[kCharacterCount];
+  typeface->charsToGlyphs(characters, SkTypeface::kUTF32_Encoding, glyphs,
+                          kCharacterCount);
+
+  SkPaint paint;
+  paint.setTypeface(typeface);
+  paint.setTextSize(kPrewarmFontSize);
+  paint.setAntiAlias(true);
+  paint.setSubpixelText(true);
+  paint.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+  SkScalar widths[kCharacterCount];
+  paint.getTextWidths(glyphs, sizeof(glyphs), widths);
+}
+
 // Compares fonts within a family to determine which one most closely matches
 // a FontDescription.
 struct FontMatcher {
@@ -76,35 +141,18 @@ struct FontMatcher {
   const FontDescription& description_;
   int target_weight_;
 };
-}
-
-void AssetFontSelector::Install(ftl::RefPtr<ZipAssetStore> asset_store) {
-  RefPtr<AssetFontSelector> font_selector =
-      adoptRef(new AssetFontSelector(std::move(asset_store)));
-  font_selector->parseFontManifest();
-  UIDartState::Current()->set_font_selector(font_selector);
-}
-
-AssetFontSelector::AssetFontSelector(ftl::RefPtr<ZipAssetStore> asset_store)
-    : asset_store_(std::move(asset_store)) {}
 
-AssetFontSelector::~AssetFontSelector() {}
-
-AssetFontSelector::TypefaceAsset::TypefaceAsset() {}
-
-AssetFontSelector::TypefaceAsset::~TypefaceAsset() {}
-
-AssetFontSelector::FlutterFontAttributes::FlutterFontAttributes(
-    const std::string& path)
-    : asset_path(path),
-      weight(kFontWeightNormal),
-      style(FontStyle::FontStyleNormal) {}
-
-AssetFontSelector::FlutterFontAttributes::~FlutterFontAttributes() {}
+// A family declared in the font manifest. Unlike the selector's own map,
+// this can be built on any thread.
+struct ManifestFamily {
+  std::string name;
+  std::vector<AssetFontSelector::FlutterFontAttributes> fonts;
+};
 
-void AssetFontSelector::parseFontManifest() {
+void readFontManifest(ZipAssetStore* asset_store,
+                      std::vector<ManifestFamily>* families) {
   std::vector<uint8_t> font_manifest_data;
-  if (!asset_store_->GetAsBuffer(kFontManifestAssetPath, &font_manifest_data))
+  if (!asset_store->GetAsBuffer(kFontManifestAssetPath, &font_manifest_data))
     return;
 
   rapidjson::Document document;
@@ -129,12 +177,9 @@ void AssetFontSelector::parseFontManifest() {
     if (font_list == family.MemberEnd() || !font_list->value.IsArray())
       continue;
 
-    AtomicString family_key =
-        AtomicString::fromUTF8(family_name->value.GetString());
-    auto set_result =
-        font_family_map_.set(family_key, std::vector<FlutterFontAttributes>());
-    std::vector<FlutterFontAttributes>& family_assets =
-        set_result.storedValue->value;
+    families->push_back(ManifestFamily());
+    ManifestFamily& manifest_family = families->back();
+    manifest_family.name = family_name->value.GetString();
 
     for (auto& list_entry : font_list->value.GetArray()) {
       if (!list_entry.IsObject())
@@ -144,7 +189,8 @@ void AssetFontSelector::parseFontManifest() {
       if (asset_path == list_entry.MemberEnd() || !asset_path->value.IsString())
         continue;
 
-      FlutterFontAttributes attributes(asset_path->value.GetString());
+      AssetFontSelector::FlutterFontAttributes attributes(
+          asset_path->value.GetString());
 
       auto weight = list_entry.FindMember("weight");
       if (weight != list_entry.MemberEnd() && weight->value.IsInt())
@@ -156,9 +202,161 @@ void AssetFontSelector::parseFontManifest() {
           attributes.style = FontStyle::FontStyleItalic;
       }
 
-      family_assets.push_back(attributes);
+      manifest_family.fonts.push_back(attributes);
+    }
+  }
+}
+}
+
+void AssetFontSelector::Install(ftl::RefPtr<ZipAssetStore> asset_store,
+                                std::shared_ptr<PrewarmState> prewarm_state) {
+  if (prewarm_state && prewarm_state->asset_store.get() != asset_store.get())
+    prewarm_state = nullptr;
+  RefPtr<AssetFontSelector> font_selector = adoptRef(
+      new AssetFontSelector(std::move(asset_store), prewarm_state));
+  UIDartState::Current()->set_font_selector(font_selector);
+  if (!prewarm_state)
+    return;
+
+  bool prewarm_done;
+  {
+    ftl::MutexLocker lock(&prewarm_state->mutex);
+    prewarm_done = prewarm_state->done;
+  }
+
+  if (prewarm_done) {
+    Threads::UI()->PostTask([font_selector]() {
+      font_selector->warmFontData();
+    });
+  } else {
+    prewarm_state->waiting_selector = font_selector;
+  }
+}
+
+std::shared_ptr<AssetFontSelector::PrewarmState> AssetFontSelector::Prewarm(
+    ftl::RefPtr<ZipAssetStore> asset_store) {
+  auto state = std::make_shared<PrewarmState>(std::move(asset_store));
+  WorkerPool::Get().PostTask(WorkerPool::Priority::kUserBlocking,
+                             "AssetFontSelector::Prewarm",
+                             [state]() { prewarmTypefaces(state); });
+  return state;
+}
+
+void AssetFontSelector::prewarmTypefaces(std::shared_ptr<PrewarmState> state) {
+  ZipAssetStore* asset_store = state->asset_store.get();
+  std::vector<ManifestFamily> families;
+  readFontManifest(asset_store, &families);
+
+  sk_sp<SkData> bundle_mapping;
+  std::unordered_map<std::string, std::unique_ptr<TypefaceAsset>> typefaces;
+  for (const ManifestFamily& family : families) {
+    for (const FlutterFontAttributes& font : family.fonts) {
+      if (typefaces.count(font.asset_path))
+        continue;
+      std::unique_ptr<TypefaceAsset> typeface_asset =
+          loadTypefaceAsset(asset_store, &bundle_mapping, font.asset_path);
+      if (!typeface_asset)
+        continue;
+      warmGlyphCache(typeface_asset->typeface);
+      typefaces[font.asset_path] = std::move(typeface_asset);
+    }
+  }
+
+  {
+    ftl::MutexLocker lock(&state->mutex);
+    state->typefaces = std::move(typefaces);
+    state->done = true;
+  }
+  // Always answered, so that a waiting selector is released even when its
+  // engine has moved on to another bundle.
+  Threads::UI()->PostTask([state]() { didPrewarmTypefaces(state); });
+}
+
+void AssetFontSelector::didPrewarmTypefaces(
+    std::shared_ptr<PrewarmState> state) {
+  RefPtr<AssetFontSelector> font_selector = state->waiting_selector.release();
+  if (font_selector)
+    font_selector->warmFontData();
+}
+
+std::unique_ptr<AssetFontSelector::TypefaceAsset>
+AssetFontSelector::takePrewarmedTypeface(const std::string& asset_path) {
+  if (!prewarm_state_)
+    return nullptr;
+  ftl::MutexLocker lock(&prewarm_state_->mutex);
+  if (!prewarm_state_->done)
+    return nullptr;
+  auto typeface_iter = prewarm_state_->typefaces.find(asset_path);
+  if (typeface_iter == prewarm_state_->typefaces.end())
+    return nullptr;
+  std::unique_ptr<TypefaceAsset> typeface_asset =
+      std::move(typeface_iter->second);
+  prewarm_state_->typefaces.erase(typeface_iter);
+  return typeface_asset;
+}
+
+void AssetFontSelector::warmFontData() {
+  TRACE_EVENT0("flutter", "AssetFontSelector::warmFontData");
+  if (!font_manifest_parsed_) {
+    font_manifest_parsed_ = true;
+    parseFontManifest();
+  }
+
+  for (const auto& family : font_family_map_) {
+    for (const FlutterFontAttributes& font : family.value) {
+      FontDescription font_description;
+      font_description.setSpecifiedSize(kPrewarmFontSize);
+      font_description.setComputedSize(kPrewarmFontSize);
+      font_description.setWeight(getFontWeight(font.weight));
+      font_description.setStyle(font.style);
+
+      RefPtr<FontData> font_data = getFontData(font_description, family.key);
+      if (!font_data)
+        continue;
+
+      // Latin-1 is the first glyph page.
+      GlyphPageTreeNode::getRootChild(font_data.get(), 0);
+      static_cast<SimpleFontData*>(font_data.get())
+          ->platformData()
+          .harfBuzzFace();
     }
   }
+
+  // Release the fonts no description picked.
+  if (prewarm_state_) {
+    ftl::MutexLocker lock(&prewarm_state_->mutex);
+    prewarm_state_->typefaces.clear();
+  }
+  prewarm_state_ = nullptr;
+}
+
+AssetFontSelector::AssetFontSelector(
+    ftl::RefPtr<ZipAssetStore> asset_store,
+    std::shared_ptr<PrewarmState> prewarm_state)
+    : asset_store_(std::move(asset_store)),
+      prewarm_state_(std::move(prewarm_state)) {}
+
+AssetFontSelector::~AssetFontSelector() {}
+
+AssetFontSelector::TypefaceAsset::TypefaceAsset() {}
+
+AssetFontSelector::TypefaceAsset::~TypefaceAsset() {}
+
+AssetFontSelector::FlutterFontAttributes::FlutterFontAttributes(
+    const std::string& path)
+    : asset_path(path),
+      weight(kFontWeightNormal),
+      style(FontStyle::FontStyleNormal) {}
+
+AssetFontSelector::FlutterFontAttributes::~FlutterFontAttributes() {}
+
+void AssetFontSelector::parseFontManifest() {
+  std::vector<ManifestFamily> families;
+  readFontManifest(asset_store_.get(), &families);
+  for (ManifestFamily& family : families) {
+    font_family_map_.set(AtomicString::fromUTF8(family.name.c_str()),
+                         std::move(family.fonts));
+  }
 }
 
 PassRefPtr<FontData> AssetFontSelector::getFontData(
@@ -196,6 +394,11 @@ PassRefPtr<FontData> AssetFontSelector::getFontData(
 sk_sp<SkTypeface> AssetFontSelector::getTypefaceAsset(
     const FontDescription& font_description,
     const AtomicString& family_name) {
+  if (!font_manifest_parsed_) {
+    font_manifest_parsed_ = true;
+    parseFontManifest();
+  }
+
   auto family_iter = font_family_map_.find(family_name);
   if (family_iter == font_family_map_.end())
     return nullptr;
@@ -215,30 +418,113 @@ sk_sp<SkTypeface> AssetFontSelector::getTypefaceAsset(
   const std::string& asset_path = font_iter->asset_path;
   auto typeface_iter = typeface_cache_.find(asset_path);
   if (typeface_iter != typeface_cache_.end()) {
-    const TypefaceAsset* cache_asset = typeface_iter->second.get();
-    return cache_asset ? cache_asset->typeface : nullptr;
+    TypefaceAsset* cache_asset = typeface_iter->second.get();
+    if (!cache_asset)
+      return nullptr;
+    cache_asset->last_use = ++typeface_use_count_;
+    return cache_asset->typeface;
   }
 
-  std::unique_ptr<TypefaceAsset> typeface_asset(new TypefaceAsset);
-  if (!asset_store_->GetAsBuffer(asset_path, &typeface_asset->data)) {
+  std::unique_ptr<TypefaceAsset> typeface_asset =
+      takePrewarmedTypeface(asset_path);
+  if (!typeface_asset) {
+    typeface_asset = loadTypefaceAsset(asset_store_.get(), &bundle_mapping_,
+                                       asset_path);
+  }
+  if (!typeface_asset) {
     typeface_cache_.insert(std::make_pair(asset_path, nullptr));
     return nullptr;
   }
 
+  typeface_asset->last_use = ++typeface_use_count_;
+  typeface_heap_bytes_ += typeface_asset->data.size();
+  sk_sp<SkTypeface> result = typeface_asset->typeface;
+  typeface_cache_.insert(std::make_pair(asset_path, std::move(typeface_asset)));
+
+  // |result| keeps the new typeface from being evicted.
+  if (typeface_heap_bytes_ > kTypefaceHeapBudget)
+    purgeUnusedTypefaces(kTypefaceHeapBudget);
+
+  return result;
+}
+
+std::unique_ptr<AssetFontSelector::TypefaceAsset>
+AssetFontSelector::loadTypefaceAsset(ZipAssetStore* asset_store,
+                                     sk_sp<SkData>* bundle_mapping,
+                                     const std::string& asset_path) {
+  std::unique_ptr<TypefaceAsset> typeface_asset(new TypefaceAsset);
   SkAutoTUnref<SkFontMgr> font_mgr(SkFontMgr::RefDefault());
-  SkMemoryStream* typeface_stream = new SkMemoryStream(
-      typeface_asset->data.data(), typeface_asset->data.size());
+
+  SkMemoryStream* typeface_stream;
+  if (sk_sp<SkData> mapped_data =
+          mapStoredAsset(asset_store, bundle_mapping, asset_path)) {
+    typeface_stream = new SkMemoryStream(std::move(mapped_data));
+  } else {
+    if (!asset_store->GetAsBuffer(asset_path, &typeface_asset->data))
+      return nullptr;
+    typeface_stream = new SkMemoryStream(typeface_asset->data.data(),
+                                         typeface_asset->data.size());
+  }
+
   typeface_asset->typeface =
       sk_sp<SkTypeface>(font_mgr->createFromStream(typeface_stream));
-  if (typeface_asset->typeface == nullptr) {
-    typeface_cache_.insert(std::make_pair(asset_path, nullptr));
+  if (typeface_asset->typeface == nullptr)
     return nullptr;
+
+  return typeface_asset;
+}
+
+sk_sp<SkData> AssetFontSelector::mapStoredAsset(ZipAssetStore* asset_store,
+                                                sk_sp<SkData>* bundle_mapping,
+                                                const std::string& asset_path) {
+  if (asset_store->zip_path().empty())
+    return nullptr;
+
+  size_t offset;
+  size_t length;
+  if (!asset_store->GetStoredAssetLocation(asset_path, &offset, &length))
+    return nullptr;
+
+  if (!*bundle_mapping) {
+    *bundle_mapping = SkData::MakeFromFileName(asset_store->zip_path().c_str());
+    if (!*bundle_mapping)
+      return nullptr;
   }
 
-  sk_sp<SkTypeface> result = typeface_asset->typeface;
-  typeface_cache_.insert(std::make_pair(asset_path, std::move(typeface_asset)));
+  if (offset > (*bundle_mapping)->size() ||
+      length > (*bundle_mapping)->size() - offset)
+    return nullptr;
 
-  return result;
+  // The subset keeps the mapping alive for as long as the typeface uses it.
+  return SkData::MakeSubset(bundle_mapping->get(), offset, length);
+}
+
+void AssetFontSelector::purgeUnusedTypefaces(size_t heap_budget) {
+  // Font data that only this cache refers to is not used by any text, and
+  // holds on to its typeface.
+  Vector<FontCacheKey> unused_font_data;
+  for (const auto& entry : font_platform_data_cache_) {
+    if (entry.value->hasOneRef())
+      unused_font_data.append(entry.key);
+  }
+  for (const FontCacheKey& key : unused_font_data)
+    font_platform_data_cache_.remove(key);
+
+  std::vector<std::pair<uint64_t, std::string>> candidates;
+  for (const auto& entry : typeface_cache_) {
+    const TypefaceAsset* asset = entry.second.get();
+    if (asset && asset->typeface->unique())
+      candidates.push_back(std::make_pair(asset->last_use, entry.first));
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  for (const auto& candidate : candidates) {
+    if (typeface_heap_bytes_ <= heap_budget)
+      break;
+    auto typeface_iter = typeface_cache_.find(candidate.second);
+    typeface_heap_bytes_ -= typeface_iter->second->data.size();
+    typeface_cache_.erase(typeface_iter);
+  }
 }
 
 void AssetFontSelector::willUseFontData(const FontDescription& font_description,
@@ -249,6 +535,8 @@ unsigned AssetFontSelector::version() const {
   return 0;
 }
 
-void AssetFontSelector::fontCacheInvalidated() {}
+void AssetFontSelector::fontCacheInvalidated() {
+  purgeUnusedTypefaces(0);
+}
 
 }  // namespace blink
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_RUNTIME_ASSET_FONT_SELECTOR_H_
 #define FLUTTER_RUNTIME_ASSET_FONT_SELECTOR_H_
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -12,18 +13,38 @@
 #include "flutter/sky/engine/platform/fonts/FontCacheKey.h"
 #include "flutter/sky/engine/platform/fonts/FontSelector.h"
 #include "flutter/sky/engine/platform/fonts/SimpleFontData.h"
+#include "third_party/skia/include/core/SkData.h"
 
 namespace blink {
 
 // A FontSelector implementation that resolves custon font names to assets
 // loaded from the FLX.
+//
+// The font manifest is read when a custom font is first asked for, and each
+// font file when text first uses it. Fonts stored uncompressed in the FLX are
+// mapped from the file, so their glyphs are paged in as needed; others are
+// inflated into memory, which is bounded by evicting fonts no text uses.
 class AssetFontSelector : public FontSelector {
  public:
   struct FlutterFontAttributes;
+  // Typefaces loaded ahead of time for one engine.
+  struct PrewarmState;
 
   ~AssetFontSelector() override;
 
-  static void Install(ftl::RefPtr<ZipAssetStore> asset_store);
+  // Installs a selector for |asset_store| in the current isolate. It takes
+  // its typefaces from |prewarm_state|, if not null and made for the same
+  // store.
+  static void Install(ftl::RefPtr<ZipAssetStore> asset_store,
+                      std::shared_ptr<PrewarmState> prewarm_state);
+
+  // Starts loading the fonts |asset_store| declares on the worker pool, so
+  // that they are ready by the time a selector is installed with the
+  // returned state. The selector then also builds their font data and Latin
+  // glyph pages for the default text size ahead of the first frame. Costs the
+  // memory of all declared fonts, so it is opt-in.
+  static std::shared_ptr<PrewarmState> Prewarm(
+      ftl::RefPtr<ZipAssetStore> asset_store);
 
   PassRefPtr<FontData> getFontData(const FontDescription& font_description,
                                    const AtomicString& family_name) override;
@@ -39,19 +60,48 @@ class AssetFontSelector : public FontSelector {
  private:
   struct TypefaceAsset;
 
-  explicit AssetFontSelector(ftl::RefPtr<ZipAssetStore> asset_store);
+  AssetFontSelector(ftl::RefPtr<ZipAssetStore> asset_store,
+                    std::shared_ptr<PrewarmState> prewarm_state);
 
   void parseFontManifest();
 
   sk_sp<SkTypeface> getTypefaceAsset(const FontDescription& font_description,
                                      const AtomicString& family_name);
 
+  // Thread safe. |bundle_mapping| caches the mapped FLX across calls.
+  static std::unique_ptr<TypefaceAsset> loadTypefaceAsset(
+      ZipAssetStore* asset_store,
+      sk_sp<SkData>* bundle_mapping,
+      const std::string& asset_path);
+  static sk_sp<SkData> mapStoredAsset(ZipAssetStore* asset_store,
+                                      sk_sp<SkData>* bundle_mapping,
+                                      const std::string& asset_path);
+
+  static void prewarmTypefaces(std::shared_ptr<PrewarmState> state);
+  static void didPrewarmTypefaces(std::shared_ptr<PrewarmState> state);
+  std::unique_ptr<TypefaceAsset> takePrewarmedTypeface(
+      const std::string& asset_path);
+  void warmFontData();
+
+  // Drops the fonts no text uses, least recently used first, until the font
+  // files held in memory take at most |heap_budget| bytes.
+  void purgeUnusedTypefaces(size_t heap_budget);
+
   ftl::RefPtr<ZipAssetStore> asset_store_;
+  // Dropped once the prewarmed typefaces have been picked over.
+  std::shared_ptr<PrewarmState> prewarm_state_;
 
+  bool font_manifest_parsed_ = false;
   HashMap<AtomicString, std::vector<FlutterFontAttributes>> font_family_map_;
 
+  // The FLX file mapped into memory, once a font is found stored in it.
+  sk_sp<SkData> bundle_mapping_;
+
   std::unordered_map<std::string, std::unique_ptr<TypefaceAsset>>
       typeface_cache_;
+  // The size of the font files copied into |typeface_cache_|.
+  size_t typeface_heap_bytes_ = 0;
+  uint64_t typeface_use_count_ = 0;
 
   typedef HashMap<FontCacheKey,
                   RefPtr<SimpleFontData>,
@@ -0,0 +1,191 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/background_isolate_pool.h"
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <utility>
+
+#include "dart/runtime/include/dart_native_api.h"
+#include "flutter/common/worker_pool.h"
+#include "flutter/common/worker_task_runner.h"
+#include "flutter/glue/trace_event.h"
+#include "flutter/lib/ui/ui_dart_state.h"
+#include "flutter/runtime/dart_init.h"
+#include "lib/ftl/arraysize.h"
+#include "lib/ftl/logging.h"
+#include "lib/ftl/memory/weak_ptr.h"
+#include "lib/tonic/converter/dart_converter.h"
+#include "lib/tonic/logging/dart_error.h"
+
+using tonic::LogIfError;
+using tonic::ToDart;
+
+namespace blink {
+namespace {
+
+// An isolate runs on one worker at a time, so leaving out one worker keeps a
+// worker free for the engine's own tasks however busy the isolates are.
+size_t GetMaxIsolateCount() {
+  size_t worker_count = WorkerPool::Get().worker_count();
+  return worker_count > 1 ? worker_count - 1 : 1;
+}
+
+}  // namespace
+
+// The isolate is started by the first call run on it, and started again if
+// it has exited since. Everything but the task runner and the call count is
+// only touched by tasks on the runner.
+class BackgroundIsolatePool::BackgroundIsolate
+    : public std::enable_shared_from_this<BackgroundIsolate> {
+ public:
+  BackgroundIsolate()
+      : runner_(ftl::MakeRefCounted<WorkerTaskRunner>(
+            WorkerPool::Priority::kUserBlocking,
+            "BackgroundIsolate")),
+        isolate_(nullptr),
+        call_count_(0) {}
+
+  const ftl::RefPtr<WorkerTaskRunner>& runner() const { return runner_; }
+
+  // The calls posted to the isolate whose entry point has not yet returned.
+  // The isolate's runner may have no task pending while one of them runs.
+  size_t call_count() const {
+    return call_count_.load(std::memory_order_relaxed);
+  }
+
+  void PostCall(const std::string& script_uri,
+                const std::string& packages,
+                const std::string& library_url,
+                const std::string& function_name,
+                Dart_Port port) {
+    call_count_.fetch_add(1, std::memory_order_relaxed);
+    std::shared_ptr<BackgroundIsolate> self = shared_from_this();
+    runner_->PostTask(
+        [self, script_uri, packages, library_url, function_name, port]() {
+          self->Call(script_uri, packages, library_url, function_name, port);
+        });
+  }
+
+  void Shutdown() {
+    if (!dart_state_)
+      return;
+    // Don't use a tonic::DartIsolateScope here since we never exit the
+    // isolate.
+    Dart_EnterIsolate(isolate_);
+    Dart_SetMessageNotifyCallback(nullptr);
+    Dart_ShutdownIsolate();  // deletes the UIDartState
+    isolate_ = nullptr;
+  }
+
+ private:
+  void Call(const std::string& script_uri,
+            const std::string& packages,
+            const std::string& library_url,
+            const std::string& function_name,
+            Dart_Port port) {
+    TRACE_EVENT0("flutter", "BackgroundIsolate::Call");
+    if (!dart_state_ && !Start(script_uri, packages, port)) {
+      call_count_.fetch_sub(1, std::memory_order_relaxed);
+      return;
+    }
+
+    {
+      tonic::DartState::Scope scope(dart_state_.get());
+      Dart_Handle ui_library = Dart_LookupLibrary(ToDart("dart:ui"));
+      Dart_Handle args[] = {ToDart(library_url), ToDart(function_name),
+                            Dart_NewSendPort(port)};
+      LogIfError(Dart_Invoke(ui_library, ToDart("_runInBackground"),
+                             arraysize(args), args));
+    }
+
+    // _runInBackground calls the entry point from a message it sends to the
+    // isolate, which the message handler has already posted to the runner, so
+    // this runs once the entry point has returned.
+    std::shared_ptr<BackgroundIsolate> self = shared_from_this();
+    runner_->PostTask([self]() {
+      self->call_count_.fetch_sub(1, std::memory_order_relaxed);
+    });
+  }
+
+  bool Start(const std::string& script_uri,
+             const std::string& packages,
+             Dart_Port port) {
+    UIDartState* dart_state = new UIDartState(nullptr, nullptr);
+    dart_state->set_is_background_isolate(true);
+    char* error = nullptr;
+    isolate_ = CreateBackgroundIsolate(script_uri, packages, dart_state,
+                                       runner_, &error);
+    if (!isolate_) {
+      const char* message_text = error ? error : "Unknown error";
+      FTL_LOG(ERROR) << "Could not start a background isolate: "
+                     << message_text;
+      Dart_CObject message;
+      message.type = Dart_CObject_kString;
+      message.value.as_string = const_cast<char*>(message_text);
+      Dart_PostCObject(port, &message);
+      free(error);
+      delete dart_state;
+      return false;
+    }
+    dart_state_ = dart_state->GetWeakPtr();
+    return true;
+  }
+
+  ftl::RefPtr<WorkerTaskRunner> runner_;
+  Dart_Isolate isolate_;
+  // Invalidated when the isolate shuts down, which it may do by itself.
+  ftl::WeakPtr<tonic::DartState> dart_state_;
+  std::atomic<size_t> call_count_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(BackgroundIsolate);
+};
+
+BackgroundIsolatePool::BackgroundIsolatePool(std::string script_uri,
+                                             std::string packages)
+    : script_uri_(std::move(script_uri)), packages_(std::move(packages)) {}
+
+BackgroundIsolatePool::~BackgroundIsolatePool() {
+  // Calls already posted to an isolate run before it shuts down.
+  for (const auto& isolate : isolates_) {
+    std::shared_ptr<BackgroundIsolate> shutting_down = isolate;
+    isolate->runner()->PostTask(
+        [shutting_down]() { shutting_down->Shutdown(); });
+  }
+}
+
+void BackgroundIsolatePool::Run(const std::string& library_url,
+                                const std::string& function_name,
+                                Dart_Port port) {
+  std::vector<size_t> call_counts;
+  call_counts.reserve(isolates_.size());
+  for (const auto& isolate : isolates_)
+    call_counts.push_back(isolate->call_count());
+
+  size_t index = SelectIsolateIndex(call_counts, GetMaxIsolateCount());
+  if (index == isolates_.size())
+    isolates_.push_back(std::make_shared<BackgroundIsolate>());
+  isolates_[index]->PostCall(script_uri_, packages_, library_url,
+                             function_name, port);
+}
+
+size_t BackgroundIsolatePool::SelectIsolateIndex(
+    const std::vector<size_t>& call_counts,
+    size_t max_isolate_count) {
+  size_t selected = call_counts.size();
+  for (size_t i = 0; i < call_counts.size(); ++i) {
+    if (selected == call_counts.size() ||
+        call_counts[i] < call_counts[selected])
+      selected = i;
+  }
+
+  if ((selected == call_counts.size() || call_counts[selected] > 0) &&
+      call_counts.size() < max_isolate_count)
+    return call_counts.size();
+  return selected;
+}
+
+}  // namespace blink
@@ -0,0 +1,56 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_BACKGROUND_ISOLATE_POOL_H_
+#define FLUTTER_RUNTIME_BACKGROUND_ISOLATE_POOL_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dart/runtime/include/dart_api.h"
+#include "lib/ftl/macros.h"
+
+namespace blink {
+
+// The isolates an application runs its background work on. They run the
+// application's script and are started as they are needed, up to one fewer
+// than there are worker threads. Each handles its messages on a
+// WorkerTaskRunner of its own, so an isolate never runs on two workers at once
+// but does not hold a worker while it waits for messages. Used on the UI
+// thread.
+class BackgroundIsolatePool {
+ public:
+  // |packages| maps package imports when |script_uri| is a source file.
+  BackgroundIsolatePool(std::string script_uri, std::string packages);
+  ~BackgroundIsolatePool();
+
+  // Calls the top-level function |function_name| of the library at
+  // |library_url| with a SendPort for |port| on the least busy isolate. If
+  // that isolate cannot be started, the error message is sent to |port|
+  // instead.
+  void Run(const std::string& library_url,
+           const std::string& function_name,
+           Dart_Port port);
+
+  // Where the next call goes, given the calls in flight on each of the
+  // running isolates: the index of the one with the fewest, or
+  // |call_counts.size()| to start another isolate while all are busy and
+  // fewer than |max_isolate_count| are running.
+  static size_t SelectIsolateIndex(const std::vector<size_t>& call_counts,
+                                   size_t max_isolate_count);
+
+ private:
+  class BackgroundIsolate;
+
+  const std::string script_uri_;
+  const std::string packages_;
+  std::vector<std::shared_ptr<BackgroundIsolate>> isolates_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(BackgroundIsolatePool);
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_RUNTIME_BACKGROUND_ISOLATE_POOL_H_
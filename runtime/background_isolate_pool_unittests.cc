@@ -0,0 +1,37 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/background_isolate_pool.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace blink {
+
+TEST(BackgroundIsolatePoolTest, StartsFirstIsolate) {
+  EXPECT_EQ(0u, BackgroundIsolatePool::SelectIsolateIndex({}, 3));
+}
+
+TEST(BackgroundIsolatePoolTest, ReusesIdleIsolate) {
+  EXPECT_EQ(1u, BackgroundIsolatePool::SelectIsolateIndex({2, 0}, 3));
+}
+
+TEST(BackgroundIsolatePoolTest, StartsIsolateWhileAllAreBusy) {
+  // An isolate running a long call has no task pending but is still busy.
+  EXPECT_EQ(2u, BackgroundIsolatePool::SelectIsolateIndex({1, 1}, 3));
+}
+
+TEST(BackgroundIsolatePoolTest, PicksLeastBusyIsolateAtLimit) {
+  EXPECT_EQ(1u, BackgroundIsolatePool::SelectIsolateIndex({3, 1, 2}, 3));
+  // Ties go to the first.
+  EXPECT_EQ(0u, BackgroundIsolatePool::SelectIsolateIndex({2, 2, 2}, 3));
+}
+
+TEST(BackgroundIsolatePoolTest, KeepsOneIsolateWithOneWorker) {
+  EXPECT_EQ(0u, BackgroundIsolatePool::SelectIsolateIndex({}, 1));
+  EXPECT_EQ(0u, BackgroundIsolatePool::SelectIsolateIndex({5}, 1));
+}
+
+}  // namespace blink
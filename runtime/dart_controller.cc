@@ -131,8 +131,9 @@ void DartController::RunFromSource(const std::string& main,
     exit(1);
 }
 
-void DartController::CreateIsolateFor(const std::string& script_uri,
-                                      std::unique_ptr<UIDartState> state) {
+void DartController::CreateIsolate(const std::string& script_uri,
+                                   std::unique_ptr<UIDartState> state) {
+  TRACE_EVENT0("flutter", "DartController::CreateIsolate");
   char* error = nullptr;
   Dart_Isolate isolate = Dart_CreateIsolate(
       script_uri.c_str(), "main",
@@ -152,7 +153,6 @@ void DartController::CreateIsolateFor(const std::string& script_uri,
     tonic::DartApiScope dart_api_scope;
     DartIO::InitForIsolate();
     DartUI::InitForIsolate();
-    DartRuntimeHooks::Install(DartRuntimeHooks::MainIsolate, script_uri);
 
     std::unique_ptr<tonic::DartClassProvider> ui_class_provider(
         new tonic::DartClassProvider(dart_state(), "dart:ui"));
@@ -170,4 +170,9 @@ void DartController::CreateIsolateFor(const std::string& script_uri,
   Dart_ExitIsolate();
 }
 
+void DartController::PrepareForScript(const std::string& script_uri) {
+  tonic::DartState::Scope scope(dart_state());
+  DartRuntimeHooks::Install(DartRuntimeHooks::MainIsolate, script_uri);
+}
+
 }  // namespace blink
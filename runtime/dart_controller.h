@@ -22,8 +22,14 @@ class DartController {
   void RunFromSnapshot(const uint8_t* buffer, size_t size);
   void RunFromSource(const std::string& main, const std::string& packages);
 
-  void CreateIsolateFor(const std::string& script_uri,
-                        std::unique_ptr<UIDartState> ui_dart_state);
+  // Creates the main isolate from the isolate snapshot. The parts of the
+  // runtime that depend on the script are only set up by PrepareForScript(),
+  // so the isolate can be created before the script is known.
+  void CreateIsolate(const std::string& script_uri,
+                     std::unique_ptr<UIDartState> ui_dart_state);
+
+  // Must be called once before running |script_uri| in the isolate.
+  void PrepareForScript(const std::string& script_uri);
 
   UIDartState* dart_state() const { return ui_dart_state_; }
 
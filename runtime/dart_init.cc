@@ -37,6 +37,7 @@
 #include "lib/ftl/time/time_delta.h"
 #include "lib/tonic/converter/dart_converter.h"
 #include "lib/tonic/dart_class_library.h"
+#include "lib/tonic/dart_message_handler.h"
 #include "lib/tonic/dart_state.h"
 #include "lib/tonic/dart_sticky_error.h"
 #include "lib/tonic/dart_wrappable.h"
@@ -245,19 +246,15 @@ Dart_Isolate ServiceIsolateCreateCallback(const char* script_uri,
 
 #endif  // FLUTTER_RUNTIME_MODE
 
-Dart_Isolate IsolateCreateCallback(const char* script_uri,
-                                   const char* main,
-                                   const char* package_root,
-                                   const char* package_config,
-                                   Dart_IsolateFlags* flags,
-                                   void* callback_data,
-                                   char** error) {
-  TRACE_EVENT0("flutter", __func__);
-
-  if (IsServiceIsolateURL(script_uri)) {
-    return ServiceIsolateCreateCallback(script_uri, error);
-  }
-
+// Creates an isolate for |dart_state| that loads the script at |script_uri|
+// the way the main isolate did. |packages| maps package imports when running
+// from source. Returns with the isolate entered, or null with |error| set if
+// the isolate could not be created.
+Dart_Isolate CreateIsolateForScript(const char* script_uri,
+                                    const char* main,
+                                    const std::string& packages,
+                                    UIDartState* dart_state,
+                                    char** error) {
   std::string entry_uri = script_uri;
   // Are we running from a Dart source file?
   const bool running_from_source = StringEndsWith(entry_uri, ".dart");
@@ -279,14 +276,12 @@ Dart_Isolate IsolateCreateCallback(const char* script_uri,
     }
   }
 
-  UIDartState* parent_dart_state = static_cast<UIDartState*>(callback_data);
-  UIDartState* dart_state = parent_dart_state->CreateForChildIsolate();
-
   Dart_Isolate isolate = Dart_CreateIsolate(
       script_uri, main,
       reinterpret_cast<uint8_t*>(DART_SYMBOL(kIsolateSnapshot)), nullptr,
       dart_state, error);
-  FTL_CHECK(isolate) << error;
+  if (!isolate)
+    return nullptr;
   dart_state->SetIsolate(isolate);
   FTL_CHECK(!LogIfError(
       Dart_SetLibraryTagHandler(tonic::DartState::HandleLibraryTag)));
@@ -316,10 +311,6 @@ Dart_Isolate IsolateCreateCallback(const char* script_uri,
                                                         snapshot_data.size())));
     } else if (running_from_source) {
       // We are running from source.
-      // Forward the .packages configuration from the parent isolate to the
-      // child isolate.
-      tonic::FileLoader& parent_loader = parent_dart_state->file_loader();
-      const std::string& packages = parent_loader.packages();
       tonic::FileLoader& loader = dart_state->file_loader();
       if (!packages.empty() && !loader.LoadPackagesMap(packages)) {
         FTL_LOG(WARNING) << "Failed to load package map: " << packages;
@@ -327,8 +318,41 @@ Dart_Isolate IsolateCreateCallback(const char* script_uri,
       // Load the script.
       FTL_CHECK(!LogIfError(loader.LoadScript(entry_path)));
     }
+  }
 
-    dart_state->isolate_client()->DidCreateSecondaryIsolate(isolate);
+  return isolate;
+}
+
+Dart_Isolate IsolateCreateCallback(const char* script_uri,
+                                   const char* main,
+                                   const char* package_root,
+                                   const char* package_config,
+                                   Dart_IsolateFlags* flags,
+                                   void* callback_data,
+                                   char** error) {
+  TRACE_EVENT0("flutter", __func__);
+
+  if (IsServiceIsolateURL(script_uri)) {
+    return ServiceIsolateCreateCallback(script_uri, error);
+  }
+
+  UIDartState* parent_dart_state = static_cast<UIDartState*>(callback_data);
+  UIDartState* dart_state = parent_dart_state->CreateForChildIsolate();
+
+  // Forward the .packages configuration from the parent isolate to the child
+  // isolate.
+  Dart_Isolate isolate = CreateIsolateForScript(
+      script_uri, main, parent_dart_state->file_loader().packages(),
+      dart_state, error);
+  if (!isolate) {
+    delete dart_state;
+    return nullptr;
+  }
+
+  // The engine's background isolates have no client.
+  if (IsolateClient* isolate_client = dart_state->isolate_client()) {
+    tonic::DartApiScope dart_api_scope;
+    isolate_client->DidCreateSecondaryIsolate(isolate);
   }
 
   Dart_ExitIsolate();
@@ -560,6 +584,24 @@ void SetRegisterNativeServiceProtocolExtensionHook(
   g_register_native_service_protocol_extensions_hook = hook;
 }
 
+Dart_Isolate CreateBackgroundIsolate(
+    const std::string& script_uri,
+    const std::string& packages,
+    UIDartState* dart_state,
+    ftl::RefPtr<ftl::TaskRunner> message_runner,
+    char** error) {
+  TRACE_EVENT0("flutter", __func__);
+  Dart_Isolate isolate = CreateIsolateForScript(script_uri.c_str(), "main",
+                                                packages, dart_state, error);
+  if (!isolate)
+    return nullptr;
+  dart_state->message_handler().Initialize(std::move(message_runner));
+  Dart_ExitIsolate();
+
+  FTL_CHECK(Dart_IsolateMakeRunnable(isolate));
+  return isolate;
+}
+
 void PushBackAll(std::vector<const char*>* args,
                  const char** argv,
                  size_t argc) {
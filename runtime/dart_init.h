@@ -8,11 +8,13 @@
 #include "dart/runtime/include/dart_api.h"
 #include "lib/ftl/functional/closure.h"
 #include "lib/ftl/build_config.h"
+#include "lib/ftl/tasks/task_runner.h"
 
 #include <memory>
 #include <string>
 
 namespace blink {
+class UIDartState;
 
 #define DART_ALLOW_DYNAMIC_RESOLUTION (OS_IOS || FLUTTER_AOT)
 
@@ -70,6 +72,20 @@ void SetServiceIsolateHook(ServiceIsolateHook hook);
 void SetRegisterNativeServiceProtocolExtensionHook(
     RegisterNativeServiceProtocolExtensionHook hook);
 
+// Creates an isolate for the engine's own use that loads the script at
+// |script_uri| the way the main isolate did, with |packages| mapping package
+// imports when running from source. The isolate takes ownership of
+// |dart_state| and handles its messages on |message_runner| rather than on
+// the VM's threads. Returns with the isolate runnable and not entered. On
+// failure, returns null with |error| set to a message the caller must free(),
+// and |dart_state| still owned by the caller.
+Dart_Isolate CreateBackgroundIsolate(
+    const std::string& script_uri,
+    const std::string& packages,
+    UIDartState* dart_state,
+    ftl::RefPtr<ftl::TaskRunner> message_runner,
+    char** error);
+
 }  // namespace blink
 
 #endif  // FLUTTER_RUNTIME_DART_INIT_H_
@@ -8,12 +8,21 @@
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/window.h"
+#include "flutter/runtime/background_isolate_pool.h"
 #include "flutter/runtime/dart_controller.h"
 #include "flutter/runtime/runtime_delegate.h"
+#include "lib/tonic/file_loader/file_loader.h"
 
 using tonic::DartState;
 
 namespace blink {
+namespace {
+
+// Names the isolate until it is given a script. The isolate keeps the name,
+// as the VM has no way to rename an isolate.
+constexpr char kPrecreatedScriptUri[] = "main.dart";
+
+}  // namespace
 
 std::unique_ptr<RuntimeController> RuntimeController::Create(
     RuntimeDelegate* client) {
@@ -25,13 +34,24 @@ RuntimeController::RuntimeController(RuntimeDelegate* client)
 
 RuntimeController::~RuntimeController() {}
 
-void RuntimeController::CreateDartController(const std::string& script_uri) {
+void RuntimeController::PrecreateDartController() {
   FTL_DCHECK(!dart_controller_);
 
   dart_controller_.reset(new DartController());
-  dart_controller_->CreateIsolateFor(
-      script_uri,
+  dart_controller_->CreateIsolate(
+      kPrecreatedScriptUri,
       std::make_unique<UIDartState>(this, std::make_unique<Window>(this)));
+}
+
+void RuntimeController::CreateDartController(const std::string& script_uri) {
+  script_uri_ = script_uri;
+  if (!dart_controller_) {
+    dart_controller_.reset(new DartController());
+    dart_controller_->CreateIsolate(
+        script_uri,
+        std::make_unique<UIDartState>(this, std::make_unique<Window>(this)));
+  }
+  dart_controller_->PrepareForScript(script_uri);
 
   UIDartState* dart_state = dart_controller_->dart_state();
   DartState::Scope scope(dart_state);
@@ -79,6 +99,12 @@ void RuntimeController::DispatchPlatformMessage(
   GetWindow()->DispatchPlatformMessage(std::move(message));
 }
 
+void RuntimeController::DispatchPlatformMessages(
+    std::vector<ftl::RefPtr<PlatformMessage>> messages) {
+  TRACE_EVENT0("flutter", "RuntimeController::DispatchPlatformMessages");
+  GetWindow()->DispatchPlatformMessages(std::move(messages));
+}
+
 void RuntimeController::DispatchPointerDataPacket(
     const PointerDataPacket& packet) {
   TRACE_EVENT0("flutter", "RuntimeController::DispatchPointerDataPacket");
@@ -113,6 +139,17 @@ void RuntimeController::HandlePlatformMessage(
   client_->HandlePlatformMessage(std::move(message));
 }
 
+void RuntimeController::RunInBackground(const std::string& library_url,
+                                        const std::string& function_name,
+                                        Dart_Port port) {
+  if (!background_isolates_) {
+    UIDartState* dart_state = dart_controller_->dart_state();
+    background_isolates_ = std::make_unique<BackgroundIsolatePool>(
+        script_uri_, dart_state->file_loader().packages());
+  }
+  background_isolates_->Run(library_url, function_name, port);
+}
+
 void RuntimeController::DidCreateSecondaryIsolate(Dart_Isolate isolate) {
   client_->DidCreateSecondaryIsolate(isolate);
 }
@@ -14,6 +14,7 @@
 #include "lib/ftl/macros.h"
 
 namespace blink {
+class BackgroundIsolatePool;
 class DartController;
 class DartLibraryProvider;
 class Scene;
@@ -26,6 +27,10 @@ class RuntimeController : public WindowClient, public IsolateClient {
   static std::unique_ptr<RuntimeController> Create(RuntimeDelegate* client);
   ~RuntimeController();
 
+  // Creates the main isolate ahead of time, before the script to run is
+  // known. CreateDartController() then only has to prepare it for the script.
+  void PrecreateDartController();
+
   void CreateDartController(const std::string& script_uri);
   DartController* dart_controller() const { return dart_controller_.get(); }
 
@@ -37,6 +42,8 @@ class RuntimeController : public WindowClient, public IsolateClient {
   void BeginFrame(ftl::TimePoint frame_time);
 
   void DispatchPlatformMessage(ftl::RefPtr<PlatformMessage> message);
+  void DispatchPlatformMessages(
+      std::vector<ftl::RefPtr<PlatformMessage>> messages);
   void DispatchPointerDataPacket(const PointerDataPacket& packet);
   void DispatchSemanticsAction(int32_t id, SemanticsAction action);
 
@@ -53,6 +60,9 @@ class RuntimeController : public WindowClient, public IsolateClient {
   void Render(Scene* scene) override;
   void UpdateSemantics(SemanticsUpdate* update) override;
   void HandlePlatformMessage(ftl::RefPtr<PlatformMessage> message) override;
+  void RunInBackground(const std::string& library_url,
+                       const std::string& function_name,
+                       Dart_Port port) override;
 
   void DidCreateSecondaryIsolate(Dart_Isolate isolate) override;
 
@@ -61,7 +71,11 @@ class RuntimeController : public WindowClient, public IsolateClient {
   std::string language_code_;
   std::string country_code_;
   bool semantics_enabled_ = false;
+  std::string script_uri_;
   std::unique_ptr<DartController> dart_controller_;
+  // Started by the first call to RunInBackground(). Shut down before the main
+  // isolate.
+  std::unique_ptr<BackgroundIsolatePool> background_isolates_;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(RuntimeController);
 };
@@ -6,18 +6,20 @@
 
 #include "base/bind.h"
 #include "base/message_loop/message_loop.h"
-#include "base/trace_event/trace_event.h"
 #include "flutter/common/threads.h"
+#include "flutter/glue/trace_event.h"
 #include "lib/ftl/time/stopwatch.h"
 
 namespace shell {
 
 Animator::Animator(ftl::WeakPtr<Rasterizer> rasterizer,
                    VsyncWaiter* waiter,
-                   Engine* engine)
+                   Engine* engine,
+                   const blink::Threads& threads)
     : rasterizer_(rasterizer),
       waiter_(waiter),
       engine_(engine),
+      threads_(threads),
       layer_tree_pipeline_(ftl::MakeRefCounted<LayerTreePipeline>(3)),
       pending_frame_semaphore_(1),
       paused_(false),
@@ -62,10 +64,19 @@ void Animator::BeginFrame(ftl::TimePoint frame_time) {
   // to service potential frame.
   DCHECK(producer_continuation_);
 
-  // TODO(abarth): We should use |frame_time| instead, but the frame time we get
-  // on Android appears to be unstable.
+  // The frame's construction time is measured from when it actually began.
   last_begin_frame_time_ = ftl::TimePoint::Now();
-  engine_->BeginFrame(last_begin_frame_time_);
+
+  // TODO(abarth): We should use |frame_time| instead, but the frame time we get
+  // on Android appears to be unstable. Only waiters that inject frame times,
+  // e.g. for benchmarks, are trusted.
+  if (!waiter_->InjectsFrameTimes())
+    frame_time = last_begin_frame_time_;
+
+  // The UI thread is shared by all views. Let the frame's code find this
+  // view's GPU thread, e.g. for releasing retained layers.
+  blink::Threads::Scope scope(&threads_);
+  engine_->BeginFrame(frame_time);
 }
 
 void Animator::Render(std::unique_ptr<flow::LayerTree> layer_tree) {
@@ -78,7 +89,7 @@ void Animator::Render(std::unique_ptr<flow::LayerTree> layer_tree) {
   // Commit the pending continuation.
   producer_continuation_.Complete(std::move(layer_tree));
 
-  blink::Threads::Gpu()->PostTask(
+  threads_.gpu()->PostTask(
       [ rasterizer = rasterizer_, pipeline = layer_tree_pipeline_ ]() {
         if (!rasterizer.get())
           return;
@@ -104,7 +115,7 @@ void Animator::RequestFrame() {
   // started an expensive operation right after posting this message however.
   // To support that, we need edge triggered wakes on VSync.
 
-  blink::Threads::UI()->PostTask([self = weak_factory_.GetWeakPtr()]() {
+  threads_.ui()->PostTask([self = weak_factory_.GetWeakPtr()]() {
     if (!self.get())
       return;
     TRACE_EVENT_INSTANT0("flutter", "RequestFrame", TRACE_EVENT_SCOPE_PROCESS);
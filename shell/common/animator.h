@@ -5,6 +5,7 @@
 #ifndef FLUTTER_SHELL_COMMON_ANIMATOR_H_
 #define FLUTTER_SHELL_COMMON_ANIMATOR_H_
 
+#include "flutter/common/threads.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -20,7 +21,8 @@ class Animator {
  public:
   Animator(ftl::WeakPtr<Rasterizer> rasterizer,
            VsyncWaiter* waiter,
-           Engine* engine);
+           Engine* engine,
+           const blink::Threads& threads);
 
   ~Animator();
 
@@ -42,6 +44,7 @@ class Animator {
   ftl::WeakPtr<Rasterizer> rasterizer_;
   VsyncWaiter* waiter_;
   Engine* engine_;
+  const blink::Threads& threads_;
 
   ftl::TimePoint last_begin_frame_time_;
   ftl::RefPtr<LayerTreePipeline> layer_tree_pipeline_;
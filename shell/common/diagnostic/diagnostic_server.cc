@@ -98,18 +98,22 @@ void DiagnosticServer::HandleSkiaPictureRequest(Dart_Handle send_port) {
   Dart_Port port_id;
   FTL_CHECK(!LogIfError(Dart_SendPortGetId(send_port, &port_id)));
 
-  blink::Threads::Gpu()->PostTask([port_id]() { SkiaPictureTask(port_id); });
-}
-
-void DiagnosticServer::SkiaPictureTask(Dart_Port port_id) {
-  std::vector<ftl::WeakPtr<Rasterizer>> rasterizers;
+  std::vector<Shell::RasterizerInfo> rasterizers;
   Shell::Shared().GetRasterizers(&rasterizers);
   if (rasterizers.size() != 1) {
     SendNull(port_id);
     return;
   }
 
-  Rasterizer* rasterizer = rasterizers[0].get();
+  ftl::WeakPtr<Rasterizer> rasterizer = rasterizers[0].rasterizer;
+  rasterizers[0].gpu_task_runner->PostTask(
+      [rasterizer, port_id]() { SkiaPictureTask(rasterizer, port_id); });
+}
+
+void DiagnosticServer::SkiaPictureTask(
+    const ftl::WeakPtr<Rasterizer>& weak_rasterizer,
+    Dart_Port port_id) {
+  Rasterizer* rasterizer = weak_rasterizer.get();
   if (rasterizer == nullptr) {
     SendNull(port_id);
     return;
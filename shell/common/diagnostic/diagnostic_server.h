@@ -6,16 +6,20 @@
 #define SKY_ENGINE_CORE_DIAGNOSTIC_DIAGNOSTIC_SERVER_H_
 
 #include "dart/runtime/include/dart_api.h"
+#include "lib/ftl/memory/weak_ptr.h"
 
 namespace shell {
 
+class Rasterizer;
+
 class DiagnosticServer {
  public:
   static void Start();
   static void HandleSkiaPictureRequest(Dart_Handle send_port);
 
  private:
-  static void SkiaPictureTask(Dart_Port port_id);
+  static void SkiaPictureTask(const ftl::WeakPtr<Rasterizer>& rasterizer,
+                              Dart_Port port_id);
 };
 
 }  // namespace shell
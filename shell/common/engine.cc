@@ -11,14 +11,20 @@
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/assets/unzipper_provider.h"
 #include "flutter/assets/zip_asset_store.h"
+#include "flutter/common/settings.h"
 #include "flutter/common/threads.h"
+#include "flutter/common/worker_pool.h"
 #include "flutter/glue/trace_event.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/runtime/asset_font_selector.h"
 #include "flutter/runtime/dart_controller.h"
 #include "flutter/runtime/dart_init.h"
 #include "flutter/runtime/runtime_init.h"
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/platform_view.h"
+#include "flutter/shell/common/platform_view_service_protocol.h"
+#include "flutter/shell/common/shell.h"
+#include "flutter/sky/engine/platform/Partitions.h"
 #include "flutter/sky/engine/public/web/Sky.h"
 #include "lib/ftl/files/file.h"
 #include "lib/ftl/files/path.h"
@@ -34,6 +40,14 @@ constexpr char kAssetChannel[] = "flutter/assets";
 constexpr char kLifecycleChannel[] = "flutter/lifecycle";
 constexpr char kNavigationChannel[] = "flutter/navigation";
 constexpr char kLocalizationChannel[] = "flutter/localization";
+constexpr char kSystemChannel[] = "flutter/system";
+constexpr char kImageWarmupManifestAssetPath[] = "ImageWarmupManifest.json";
+
+// How often the partitions return their empty slot spans to the system while
+// the app runs. Spans emptied by a burst of layout are kept for reuse until
+// then.
+constexpr ftl::TimeDelta kPartitionPurgeInterval =
+    ftl::TimeDelta::FromSeconds(10);
 
 bool PathExists(const std::string& path) {
   return access(path.c_str(), R_OK) == 0;
@@ -51,18 +65,46 @@ std::string FindPackagesPath(const std::string& main_dart) {
   return packages_path;
 }
 
+// Whether the engine looks at |message| before the framework gets it.
+bool IsEnginePlatformMessage(const blink::PlatformMessage& message) {
+  return message.channel() == kLifecycleChannel ||
+         message.channel() == kLocalizationChannel ||
+         message.channel() == kSystemChannel;
+}
+
 std::string GetScriptUriFromPath(const std::string& path) {
   return "file://" + path;
 }
 
+// Safe to call from any thread.
+bool GetAssetFromBundles(blink::DirectoryAssetBundle* directory_asset_bundle,
+                         blink::ZipAssetStore* asset_store,
+                         const std::string& name,
+                         std::vector<uint8_t>* data) {
+  return (directory_asset_bundle &&
+          directory_asset_bundle->GetAsBuffer(name, data)) ||
+         (asset_store && asset_store->GetAsBuffer(name, data));
+}
+
 }  // namespace
 
 Engine::Engine(PlatformView* platform_view)
     : platform_view_(platform_view->GetWeakPtr()),
+      threads_(platform_view->threads()),
       animator_(std::make_unique<Animator>(
           platform_view->rasterizer().GetWeakRasterizerPtr(),
           platform_view->GetVsyncWaiter(),
-          this)),
+          this,
+          threads_)),
+      platform_message_sender_(
+          Shell::Shared().platform_task_runner(),
+          [platform_view = platform_view_](
+              std::vector<ftl::RefPtr<blink::PlatformMessage>> messages) {
+            if (!platform_view)
+              return;
+            for (auto& message : messages)
+              platform_view->HandlePlatformMessage(std::move(message));
+          }),
       activity_running_(false),
       have_surface_(false),
       weak_factory_(this) {}
@@ -77,6 +119,14 @@ void Engine::Init() {
   blink::InitRuntime();
 }
 
+void Engine::PrecreateRuntime() {
+  TRACE_EVENT0("flutter", "Engine::PrecreateRuntime");
+  if (runtime_ || precreated_runtime_)
+    return;
+  precreated_runtime_ = blink::RuntimeController::Create(this);
+  precreated_runtime_->PrecreateDartController();
+}
+
 void Engine::RunBundle(const std::string& bundle_path) {
   TRACE_EVENT0("flutter", "Engine::RunBundle");
   ConfigureAssetBundle(bundle_path);
@@ -153,7 +203,7 @@ std::string Engine::GetUIIsolateName() {
 }
 
 void Engine::OnOutputSurfaceCreated(const ftl::Closure& gpu_continuation) {
-  blink::Threads::Gpu()->PostTask(gpu_continuation);
+  threads_.gpu()->PostTask(gpu_continuation);
   have_surface_ = true;
   StartAnimatorIfPossible();
   if (runtime_)
@@ -163,7 +213,7 @@ void Engine::OnOutputSurfaceCreated(const ftl::Closure& gpu_continuation) {
 void Engine::OnOutputSurfaceDestroyed(const ftl::Closure& gpu_continuation) {
   have_surface_ = false;
   StopAnimator();
-  blink::Threads::Gpu()->PostTask(gpu_continuation);
+  threads_.gpu()->PostTask(gpu_continuation);
 }
 
 void Engine::SetViewportMetrics(const blink::ViewportMetrics& metrics) {
@@ -180,6 +230,8 @@ void Engine::DispatchPlatformMessage(
   } else if (message->channel() == kLocalizationChannel) {
     if (HandleLocalizationPlatformMessage(std::move(message)))
       return;
+  } else if (message->channel() == kSystemChannel) {
+    HandleSystemPlatformMessage(message.get());
   }
 
   if (runtime_) {
@@ -192,19 +244,86 @@ void Engine::DispatchPlatformMessage(
     HandleNavigationPlatformMessage(std::move(message));
 }
 
+void Engine::DispatchPlatformMessages(
+    std::vector<ftl::RefPtr<blink::PlatformMessage>> messages) {
+  TRACE_EVENT1("flutter", "Engine::DispatchPlatformMessages", "messages",
+               messages.size());
+  std::vector<ftl::RefPtr<blink::PlatformMessage>> batch;
+  for (auto& message : messages) {
+    if (runtime_ && !IsEnginePlatformMessage(*message)) {
+      batch.push_back(std::move(message));
+      continue;
+    }
+    // Messages the engine looks at first are dispatched on their own, after
+    // the ones before them.
+    if (!batch.empty()) {
+      runtime_->DispatchPlatformMessages(std::move(batch));
+      batch.clear();
+    }
+    DispatchPlatformMessage(std::move(message));
+  }
+  if (!batch.empty())
+    runtime_->DispatchPlatformMessages(std::move(batch));
+}
+
 bool Engine::HandleLifecyclePlatformMessage(blink::PlatformMessage* message) {
   const auto& data = message->data();
   std::string state(reinterpret_cast<const char*>(data.data()), data.size());
   if (state == "AppLifecycleState.paused") {
     activity_running_ = false;
     StopAnimator();
+    // Nothing is drawn while paused, and backgrounded apps are the first to
+    // be killed for memory.
+    blink::Partitions::decommitFreeableMemory();
+    PlatformViewServiceProtocol::SnapshotPartitionStats();
   } else if (state == "AppLifecycleState.resumed") {
     activity_running_ = true;
     StartAnimatorIfPossible();
+    PlatformViewServiceProtocol::SnapshotPartitionStats();
+    SchedulePartitionPurge();
   }
   return false;
 }
 
+void Engine::SchedulePartitionPurge() {
+  if (partition_purge_scheduled_)
+    return;
+  partition_purge_scheduled_ = true;
+  threads_.ui()->PostDelayedTask(
+      [self = GetWeakPtr()]() {
+        if (!self)
+          return;
+        self->partition_purge_scheduled_ = false;
+        // Pausing purges, and a resume schedules the next one.
+        if (!self->activity_running_)
+          return;
+        TRACE_EVENT0("flutter", "Engine::PurgePartitions");
+        blink::Partitions::decommitFreeableMemory();
+        PlatformViewServiceProtocol::SnapshotPartitionStats();
+        self->SchedulePartitionPurge();
+      },
+      kPartitionPurgeInterval);
+}
+
+void Engine::HandleSystemPlatformMessage(blink::PlatformMessage* message) {
+  const auto& data = message->data();
+
+  rapidjson::Document document;
+  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  if (document.HasParseError() || !document.IsObject())
+    return;
+  auto root = document.GetObject();
+  auto type = root.FindMember("type");
+  if (type == root.MemberEnd() || type->value != "memoryPressure")
+    return;
+
+  TRACE_EVENT0("flutter", "Engine::DecommitFreeableMemory");
+  blink::PurgeEngineCaches();
+  image_warmup_.Purge();
+  blink::Partitions::decommitFreeableMemory();
+  PlatformViewServiceProtocol::SnapshotPartitionStats();
+}
+
 bool Engine::HandleNavigationPlatformMessage(
     ftl::RefPtr<blink::PlatformMessage> message) {
   FTL_DCHECK(!runtime_);
@@ -265,6 +384,9 @@ void Engine::DispatchSemanticsAction(int id, blink::SemanticsAction action) {
 
 void Engine::SetSemanticsEnabled(bool enabled) {
   semantics_enabled_ = enabled;
+  // The platform drops its tree when semantics are toggled, and the framework
+  // answers with a full update, which must not be diffed away.
+  semantics_tree_.Clear();
   if (runtime_)
     runtime_->SetSemanticsEnabled(semantics_enabled_);
 }
@@ -283,19 +405,52 @@ void Engine::ConfigureAssetBundle(const std::string& path) {
 
   if (S_ISDIR(stat_result.st_mode)) {
     directory_asset_bundle_ =
-        std::make_unique<blink::DirectoryAssetBundle>(path);
+        std::make_shared<blink::DirectoryAssetBundle>(path);
     return;
   }
 
   if (S_ISREG(stat_result.st_mode)) {
     asset_store_ = ftl::MakeRefCounted<blink::ZipAssetStore>(
-        blink::GetUnzipperProviderForPath(path));
+        blink::GetUnzipperProviderForPath(path), path);
+    // Runs while the isolate starts; ConfigureRuntime installs the font
+    // selector that picks up the fonts.
+    font_prewarm_state_ = nullptr;
+    if (blink::Settings::Get().prewarm_fonts)
+      font_prewarm_state_ = blink::AssetFontSelector::Prewarm(asset_store_);
+    StartImageWarmup();
     return;
   }
 }
 
+void Engine::StartImageWarmup() {
+  std::vector<uint8_t> data;
+  if (!asset_store_->GetAsBuffer(kImageWarmupManifestAssetPath, &data))
+    return;
+
+  rapidjson::Document document;
+  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  if (document.HasParseError() || !document.IsArray())
+    return;
+
+  std::vector<std::string> asset_names;
+  for (auto& entry : document.GetArray()) {
+    if (entry.IsString())
+      asset_names.push_back(entry.GetString());
+  }
+
+  // The images decode on the IO thread while the isolate is created here.
+  image_warmup_.Start(
+      asset_names, [asset_store = asset_store_](const std::string& name,
+                                                std::vector<uint8_t>* data) {
+        return asset_store->GetAsBuffer(name, data);
+      });
+}
+
 void Engine::ConfigureRuntime(const std::string& script_uri) {
-  runtime_ = blink::RuntimeController::Create(this);
+  if (precreated_runtime_)
+    runtime_ = std::move(precreated_runtime_);
+  else
+    runtime_ = blink::RuntimeController::Create(this);
   runtime_->CreateDartController(std::move(script_uri));
   runtime_->SetViewportMetrics(viewport_metrics_);
   runtime_->SetLocale(language_code_, country_code_);
@@ -305,8 +460,10 @@ void Engine::ConfigureRuntime(const std::string& script_uri) {
 }
 
 void Engine::DidCreateMainIsolate(Dart_Isolate isolate) {
+  blink::UIDartState::Current()->set_image_warmup(&image_warmup_);
   if (asset_store_)
-    blink::AssetFontSelector::Install(asset_store_);
+    blink::AssetFontSelector::Install(asset_store_,
+                                      std::move(font_prewarm_state_));
 }
 
 void Engine::DidCreateSecondaryIsolate(Dart_Isolate isolate) {}
@@ -338,6 +495,27 @@ void Engine::Render(std::unique_ptr<flow::LayerTree> layer_tree) {
 }
 
 void Engine::UpdateSemantics(std::vector<blink::SemanticsNode> update) {
+  semantics_tree_.Update(std::move(update));
+  if (!semantics_tree_.HasPendingUpdate() || semantics_flush_scheduled_)
+    return;
+
+  // Let any further updates queued behind this one coalesce into a single
+  // delivery to the platform thread.
+  semantics_flush_scheduled_ = true;
+  blink::Threads::UI()->PostTask([engine = GetWeakPtr()]() {
+    if (engine)
+      engine->FlushSemantics();
+  });
+}
+
+void Engine::FlushSemantics() {
+  semantics_flush_scheduled_ = false;
+  std::vector<blink::SemanticsNode> update =
+      semantics_tree_.TakePendingUpdate();
+  if (update.empty())
+    return;
+
+  TRACE_EVENT1("flutter", "Engine::FlushSemantics", "nodes", update.size());
   blink::Threads::Platform()->PostTask(ftl::MakeCopyable(
       [ platform_view = platform_view_, update = std::move(update) ]() mutable {
         if (platform_view)
@@ -351,12 +529,7 @@ void Engine::HandlePlatformMessage(
     HandleAssetPlatformMessage(std::move(message));
     return;
   }
-  blink::Threads::Platform()->PostTask([
-    platform_view = platform_view_, message = std::move(message)
-  ]() mutable {
-    if (platform_view)
-      platform_view->HandlePlatformMessage(std::move(message));
-  });
+  platform_message_sender_.Send(std::move(message));
 }
 
 void Engine::HandleAssetPlatformMessage(
@@ -367,19 +540,28 @@ void Engine::HandleAssetPlatformMessage(
   const auto& data = message->data();
   std::string asset_name(reinterpret_cast<const char*>(data.data()),
                          data.size());
-  std::vector<uint8_t> asset_data;
-  if (GetAssetAsBuffer(asset_name, &asset_data)) {
-    response->Complete(std::move(asset_data));
-  } else {
-    response->CompleteWithError();
-  }
+
+  // Inflating an asset can take a while, and responses may be completed on
+  // any thread, so keep the UI thread free of it.
+  blink::WorkerPool::Get().PostTask(
+      blink::WorkerPool::Priority::kUserBlocking, "Engine::InflateAsset", [
+        directory_asset_bundle = directory_asset_bundle_,
+        asset_store = asset_store_, asset_name, response
+      ]() {
+        std::vector<uint8_t> asset_data;
+        if (GetAssetFromBundles(directory_asset_bundle.get(), asset_store.get(),
+                                asset_name, &asset_data)) {
+          response->Complete(std::move(asset_data));
+        } else {
+          response->CompleteWithError();
+        }
+      });
 }
 
 bool Engine::GetAssetAsBuffer(const std::string& name,
                               std::vector<uint8_t>* data) {
-  return (directory_asset_bundle_ &&
-          directory_asset_bundle_->GetAsBuffer(name, data)) ||
-         (asset_store_ && asset_store_->GetAsBuffer(name, data));
+  return GetAssetFromBundles(directory_asset_bundle_.get(), asset_store_.get(),
+                             name, data);
 }
 
 }  // namespace shell
@@ -6,10 +6,15 @@
 #define SHELL_COMMON_ENGINE_H_
 
 #include "flutter/assets/zip_asset_store.h"
+#include "flutter/common/threads.h"
+#include "flutter/lib/ui/painting/image_decoding.h"
+#include "flutter/lib/ui/semantics/semantics_tree.h"
 #include "flutter/lib/ui/window/platform_message.h"
 #include "flutter/lib/ui/window/viewport_metrics.h"
+#include "flutter/runtime/asset_font_selector.h"
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/runtime/runtime_delegate.h"
+#include "flutter/shell/common/platform_message_sender.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "lib/ftl/macros.h"
 #include "lib/ftl/memory/weak_ptr.h"
@@ -35,6 +40,10 @@ class Engine : public blink::RuntimeDelegate {
 
   static void Init();
 
+  // Creates the UI isolate ahead of time. The next bundle or source to run
+  // uses it instead of creating one.
+  void PrecreateRuntime();
+
   void RunBundle(const std::string& bundle_path);
 
   // Uses the given snapshot instead of looking inside the bundle for the
@@ -63,6 +72,10 @@ class Engine : public blink::RuntimeDelegate {
   void OnOutputSurfaceDestroyed(const ftl::Closure& gpu_continuation);
   void SetViewportMetrics(const blink::ViewportMetrics& metrics);
   void DispatchPlatformMessage(ftl::RefPtr<blink::PlatformMessage> message);
+  // Dispatches |messages| in order, handing the ones for the framework to it
+  // together.
+  void DispatchPlatformMessages(
+      std::vector<ftl::RefPtr<blink::PlatformMessage>> messages);
   void DispatchPointerDataPacket(const PointerDataPacket& packet);
   void DispatchSemanticsAction(int id, blink::SemanticsAction action);
   void SetSemanticsEnabled(bool enabled);
@@ -77,13 +90,18 @@ class Engine : public blink::RuntimeDelegate {
   void DidCreateMainIsolate(Dart_Isolate isolate) override;
   void DidCreateSecondaryIsolate(Dart_Isolate isolate) override;
 
+  void FlushSemantics();
+
   void StopAnimator();
   void StartAnimatorIfPossible();
 
   void ConfigureAssetBundle(const std::string& path);
+  void StartImageWarmup();
   void ConfigureRuntime(const std::string& script_uri);
 
   bool HandleLifecyclePlatformMessage(blink::PlatformMessage* message);
+  void SchedulePartitionPurge();
+  void HandleSystemPlatformMessage(blink::PlatformMessage* message);
   bool HandleNavigationPlatformMessage(
       ftl::RefPtr<blink::PlatformMessage> message);
   bool HandleLocalizationPlatformMessage(
@@ -93,22 +111,38 @@ class Engine : public blink::RuntimeDelegate {
   bool GetAssetAsBuffer(const std::string& name, std::vector<uint8_t>* data);
 
   ftl::WeakPtr<PlatformView> platform_view_;
+  const blink::Threads& threads_;
+  // Outlives the runtimes, whose isolates take images from it.
+  blink::ImageWarmup image_warmup_;
   std::unique_ptr<Animator> animator_;
   std::unique_ptr<blink::RuntimeController> runtime_;
+  // Kept apart from |runtime_| until a script runs, as messages for the
+  // framework must be held back until then.
+  std::unique_ptr<blink::RuntimeController> precreated_runtime_;
 
   ftl::RefPtr<blink::PlatformMessage> pending_push_route_message_;
   blink::ViewportMetrics viewport_metrics_;
   std::string language_code_;
   std::string country_code_;
   bool semantics_enabled_ = false;
+  // What the platform view has been told about the semantics tree. Updates
+  // are diffed against it and delivered at most once per UI task batch.
+  blink::SemanticsTree semantics_tree_;
+  bool semantics_flush_scheduled_ = false;
+  // Sends messages to the platform view on the platform thread.
+  PlatformMessageSender platform_message_sender_;
 
   // TODO(abarth): Unify these two behind a common interface.
   ftl::RefPtr<blink::ZipAssetStore> asset_store_;
-  std::unique_ptr<blink::DirectoryAssetBundle> directory_asset_bundle_;
+  // Handed to the font selector of the next main isolate.
+  std::shared_ptr<blink::AssetFontSelector::PrewarmState> font_prewarm_state_;
+  // Shared with asset reads in flight on the worker pool.
+  std::shared_ptr<blink::DirectoryAssetBundle> directory_asset_bundle_;
 
   // TODO(eseidel): This should move into an AnimatorStateMachine.
   bool activity_running_;
   bool have_surface_;
+  bool partition_purge_scheduled_ = false;
 
   ftl::WeakPtrFactory<Engine> weak_factory_;
 
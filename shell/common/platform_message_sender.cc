@@ -0,0 +1,49 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/platform_message_sender.h"
+
+#include <mutex>
+#include <utility>
+
+namespace shell {
+
+struct PlatformMessageSender::Batch {
+  std::mutex mutex;
+  // Set once the task delivering the batch has taken its messages.
+  bool taken = false;
+  std::vector<ftl::RefPtr<blink::PlatformMessage>> messages;
+};
+
+PlatformMessageSender::PlatformMessageSender(
+    ftl::RefPtr<blink::CountingTaskRunner> task_runner,
+    Receiver receiver)
+    : task_runner_(std::move(task_runner)), receiver_(std::move(receiver)) {}
+
+PlatformMessageSender::~PlatformMessageSender() {}
+
+void PlatformMessageSender::Send(ftl::RefPtr<blink::PlatformMessage> message) {
+  if (batch_ && task_runner_->task_count() == batch_task_count_) {
+    std::lock_guard<std::mutex> lock(batch_->mutex);
+    if (!batch_->taken) {
+      batch_->messages.push_back(std::move(message));
+      return;
+    }
+  }
+
+  batch_ = std::make_shared<Batch>();
+  batch_->messages.push_back(std::move(message));
+  task_runner_->PostTask([ batch = batch_, receiver = receiver_ ]() {
+    std::vector<ftl::RefPtr<blink::PlatformMessage>> messages;
+    {
+      std::lock_guard<std::mutex> lock(batch->mutex);
+      batch->taken = true;
+      messages.swap(batch->messages);
+    }
+    receiver(std::move(messages));
+  });
+  batch_task_count_ = task_runner_->task_count();
+}
+
+}  // namespace shell
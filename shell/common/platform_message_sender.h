@@ -0,0 +1,53 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_PLATFORM_MESSAGE_SENDER_H_
+#define SHELL_COMMON_PLATFORM_MESSAGE_SENDER_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "flutter/common/counting_task_runner.h"
+#include "flutter/lib/ui/window/platform_message.h"
+#include "lib/ftl/macros.h"
+#include "lib/ftl/memory/ref_ptr.h"
+
+namespace shell {
+
+// Sends platform messages to another thread, letting messages sent back to
+// back share one task there. A message joins the task of the one sent before
+// it only while that task has not started and nothing else has been posted to
+// the thread since, so messages never overtake, nor are overtaken by, the
+// other tasks posted there.
+class PlatformMessageSender {
+ public:
+  using Receiver =
+      std::function<void(std::vector<ftl::RefPtr<blink::PlatformMessage>>)>;
+
+  // |receiver| is called on the thread of |task_runner|.
+  PlatformMessageSender(ftl::RefPtr<blink::CountingTaskRunner> task_runner,
+                        Receiver receiver);
+  ~PlatformMessageSender();
+
+  // Must always be called on the same thread.
+  void Send(ftl::RefPtr<blink::PlatformMessage> message);
+
+ private:
+  struct Batch;
+
+  const ftl::RefPtr<blink::CountingTaskRunner> task_runner_;
+  const Receiver receiver_;
+  // The batch last posted, and the task count of |task_runner_| right after.
+  std::shared_ptr<Batch> batch_;
+  uint64_t batch_task_count_ = 0;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(PlatformMessageSender);
+};
+
+}  // namespace shell
+
+#endif  // SHELL_COMMON_PLATFORM_MESSAGE_SENDER_H_
@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "flutter/common/settings.h"
 #include "flutter/common/threads.h"
 #include "flutter/lib/ui/painting/resource_context.h"
 #include "flutter/shell/common/rasterizer.h"
@@ -16,40 +17,56 @@
 namespace shell {
 
 PlatformView::PlatformView(std::unique_ptr<Rasterizer> rasterizer)
-    : rasterizer_(std::move(rasterizer)),
+    : threads_(Shell::Shared().AcquireThreadGroup()),
+      rasterizer_(std::move(rasterizer)),
       size_(SkISize::Make(0, 0)),
       weak_factory_(this) {
-  blink::Threads::UI()->PostTask(
+  Shell::Shared().AddRasterizer(rasterizer_->GetWeakRasterizerPtr(),
+                                threads_->gpu());
+  threads_->ui()->PostTask(
       [self = GetWeakPtr()] { Shell::Shared().AddPlatformView(self); });
 }
 
 PlatformView::~PlatformView() {
-  blink::Threads::UI()->PostTask([] { Shell::Shared().PurgePlatformViews(); });
+  threads_->ui()->PostTask([] { Shell::Shared().PurgePlatformViews(); });
 
   Rasterizer* rasterizer = rasterizer_.release();
-  blink::Threads::Gpu()->PostTask([rasterizer]() { delete rasterizer; });
+  threads_->gpu()->PostTask([rasterizer]() { delete rasterizer; });
 
   Engine* engine = engine_.release();
-  blink::Threads::UI()->PostTask([engine]() { delete engine; });
+  threads_->ui()->PostTask([engine]() { delete engine; });
+
+  Shell::Shared().ReleaseThreadGroup(threads_);
 }
 
 void PlatformView::CreateEngine() {
   engine_.reset(new Engine(this));
+  platform_message_sender_ = std::make_unique<PlatformMessageSender>(
+      Shell::Shared().ui_task_runner(),
+      [engine = engine_->GetWeakPtr()](
+          std::vector<ftl::RefPtr<blink::PlatformMessage>> messages) {
+        if (engine)
+          engine->DispatchPlatformMessages(std::move(messages));
+      });
+
+  // The isolate is created on the UI thread while this thread goes on to set
+  // up the surface.
+  if (blink::Settings::Get().precreate_isolate) {
+    threads_->ui()->PostTask([engine = engine_->GetWeakPtr()]() {
+      if (engine)
+        engine->PrecreateRuntime();
+    });
+  }
 }
 
 void PlatformView::DispatchPlatformMessage(
     ftl::RefPtr<blink::PlatformMessage> message) {
-  blink::Threads::UI()->PostTask(
-      [ engine = engine_->GetWeakPtr(), message = std::move(message) ] {
-        if (engine) {
-          engine->DispatchPlatformMessage(message);
-        }
-      });
+  platform_message_sender_->Send(std::move(message));
 }
 
 void PlatformView::DispatchSemanticsAction(int32_t id,
                                            blink::SemanticsAction action) {
-  blink::Threads::UI()->PostTask(
+  threads_->ui()->PostTask(
       [ engine = engine_->GetWeakPtr(), id, action ] {
         if (engine) {
           engine->DispatchSemanticsAction(
@@ -59,7 +76,7 @@ void PlatformView::DispatchSemanticsAction(int32_t id,
 }
 
 void PlatformView::SetSemanticsEnabled(bool enabled) {
-  blink::Threads::UI()->PostTask([ engine = engine_->GetWeakPtr(), enabled ] {
+  threads_->ui()->PostTask([ engine = engine_->GetWeakPtr(), enabled ] {
     if (engine)
       engine->SetSemanticsEnabled(enabled);
   });
@@ -94,7 +111,7 @@ void PlatformView::NotifyCreated(std::unique_ptr<Surface> surface,
   });
 
   // Runs on the Platform Thread.
-  blink::Threads::UI()->PostTask(std::move(ui_continuation));
+  threads_->ui()->PostTask(std::move(ui_continuation));
 
   latch.Wait();
 }
@@ -106,7 +123,7 @@ void PlatformView::NotifyDestroyed() {
     rasterizer_->Teardown(&latch);
   };
 
-  blink::Threads::UI()->PostTask([this, engine_continuation]() {
+  threads_->ui()->PostTask([this, engine_continuation]() {
     engine_->OnOutputSurfaceDestroyed(engine_continuation);
   });
 
@@ -134,7 +151,7 @@ void PlatformView::HandlePlatformMessage(
 void PlatformView::SetupResourceContextOnIOThread() {
   ftl::AutoResetWaitableEvent latch;
 
-  blink::Threads::IO()->PostTask(
+  threads_->io()->PostTask(
       [this, &latch]() { SetupResourceContextOnIOThreadPerform(&latch); });
 
   latch.Wait();
@@ -6,9 +6,11 @@
 #define COMMON_PLATFORM_VIEW_H_
 
 #include <memory>
+#include <vector>
 
 #include "flutter/lib/ui/semantics/semantics_node.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/platform_message_sender.h"
 #include "flutter/shell/common/shell.h"
 #include "flutter/shell/common/surface.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -62,6 +64,9 @@ class PlatformView {
   Rasterizer& rasterizer() { return *rasterizer_; }
   Engine& engine() { return *engine_; }
 
+  // The threads this view's engine and rasterizer run on.
+  const blink::Threads& threads() const { return *threads_; }
+
   virtual void RunFromSource(const std::string& assets_directory,
                              const std::string& main,
                              const std::string& packages) = 0;
@@ -74,11 +79,14 @@ class PlatformView {
   void SetupResourceContextOnIOThreadPerform(
       ftl::AutoResetWaitableEvent* event);
 
+  const blink::Threads* threads_;
   SurfaceConfig surface_config_;
   std::unique_ptr<Rasterizer> rasterizer_;
   std::unique_ptr<Engine> engine_;
   std::unique_ptr<VsyncWaiter> vsync_waiter_;
   SkISize size_;
+  // Sends messages to the engine on the UI thread.
+  std::unique_ptr<PlatformMessageSender> platform_message_sender_;
 
  private:
   ftl::WeakPtrFactory<PlatformView> weak_factory_;
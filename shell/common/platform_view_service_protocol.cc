@@ -11,9 +11,12 @@
 
 #include "base/base64.h"
 #include "flutter/common/threads.h"
+#include "flutter/glue/trace_recorder.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/shell.h"
+#include "flutter/sky/engine/platform/Partitions.h"
 #include "lib/ftl/memory/weak_ptr.h"
+#include "lib/ftl/synchronization/mutex.h"
 #include "third_party/skia/include/core/SkImageEncoder.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
@@ -113,6 +116,62 @@ static void AppendFlutterView(std::stringstream* stream,
   *stream << "}";
 }
 
+// Writes each partition as a JSON object with its totals and buckets.
+class PartitionStatsWriter : public PartitionStatsDumper {
+ public:
+  explicit PartitionStatsWriter(std::stringstream* stream) : stream_(stream) {}
+
+  void partitionDumpTotals(const char* partition_name,
+                           const PartitionMemoryStats& stats) override {
+    if (prefix_comma_)
+      *stream_ << ',';
+    prefix_comma_ = true;
+    *stream_ << "{\"name\":\"" << partition_name << "\","
+             << "\"mmappedBytes\":" << stats.totalMmappedBytes << ","
+             << "\"committedBytes\":" << stats.totalCommittedBytes << ","
+             << "\"residentBytes\":" << stats.totalResidentBytes << ","
+             << "\"activeBytes\":" << stats.totalActiveBytes << ","
+             << "\"freelistBytes\":" << stats.totalFreelistBytes << ","
+             << "\"decommittableBytes\":" << stats.totalDecommittableBytes
+             << ",\"buckets\":[" << buckets_.str() << "]}";
+    buckets_.str(std::string());
+  }
+
+  void partitionDumpBucketStats(
+      const char* partition_name,
+      const PartitionBucketMemoryStats& stats) override {
+    if (buckets_.tellp() > 0)
+      buckets_ << ',';
+    buckets_ << "{\"slotSize\":" << stats.bucketSlotSize << ","
+             << "\"slotSpanSize\":" << stats.allocatedPageSize << ","
+             << "\"activeBytes\":" << stats.activeBytes << ","
+             << "\"residentBytes\":" << stats.residentBytes << ","
+             << "\"freelistBytes\":" << stats.freelistBytes << ","
+             << "\"decommittableBytes\":" << stats.decommittableBytes << ","
+             << "\"fullSlotSpans\":" << stats.numFullPages << ","
+             << "\"activeSlotSpans\":" << stats.numActivePages << ","
+             << "\"emptySlotSpans\":" << stats.numEmptyPages << ","
+             << "\"decommittedSlotSpans\":" << stats.numDecommittedPages
+             << "}";
+  }
+
+ private:
+  std::stringstream* stream_;
+  std::stringstream buckets_;
+  bool prefix_comma_ = false;
+};
+
+// The last snapshot taken on the UI thread.
+ftl::Mutex& PartitionStatsMutex() {
+  static ftl::Mutex mutex;
+  return mutex;
+}
+
+std::string& PartitionStatsSnapshot() {
+  static std::string* snapshot = new std::string("[]");
+  return *snapshot;
+}
+
 }  // namespace
 
 void PlatformViewServiceProtocol::RegisterHook(bool running_precompiled_code) {
@@ -122,6 +181,12 @@ void PlatformViewServiceProtocol::RegisterHook(bool running_precompiled_code) {
   // Screenshot.
   Dart_RegisterRootServiceRequestCallback(kScreenshotExtensionName, &Screenshot,
                                           nullptr);
+  // Allocator statistics.
+  Dart_RegisterRootServiceRequestCallback(kPartitionStatsExtensionName,
+                                          &PartitionStats, nullptr);
+  // Events kept by the in-process trace recorder.
+  Dart_RegisterRootServiceRequestCallback(kRecordedTraceExtensionName,
+                                          &RecordedTrace, nullptr);
   // The following set of service protocol extensions require debug build
   if (running_precompiled_code) {
     return;
@@ -241,10 +306,16 @@ bool PlatformViewServiceProtocol::Screenshot(const char* method,
                                              intptr_t num_params,
                                              void* user_data,
                                              const char** json_object) {
+  std::vector<Shell::RasterizerInfo> rasterizers;
+  Shell::Shared().GetRasterizers(&rasterizers);
+  if (rasterizers.size() != 1)
+    return ErrorServer(json_object, "no screenshot available");
+
   ftl::AutoResetWaitableEvent latch;
   SkBitmap bitmap;
-  blink::Threads::Gpu()->PostTask([&latch, &bitmap]() {
-    ScreenshotGpuTask(&bitmap);
+  const Shell::RasterizerInfo& info = rasterizers[0];
+  info.gpu_task_runner->PostTask([&latch, &bitmap, &info]() {
+    ScreenshotGpuTask(info.rasterizer, &bitmap);
     latch.Signal();
   });
 
@@ -271,13 +342,66 @@ bool PlatformViewServiceProtocol::Screenshot(const char* method,
   return true;
 }
 
-void PlatformViewServiceProtocol::ScreenshotGpuTask(SkBitmap* bitmap) {
-  std::vector<ftl::WeakPtr<Rasterizer>> rasterizers;
-  Shell::Shared().GetRasterizers(&rasterizers);
-  if (rasterizers.size() != 1)
-    return;
+const char* PlatformViewServiceProtocol::kPartitionStatsExtensionName =
+    "_flutter.partitionStats";
+
+bool PlatformViewServiceProtocol::PartitionStats(const char* method,
+                                                 const char** param_keys,
+                                                 const char** param_values,
+                                                 intptr_t num_params,
+                                                 void* user_data,
+                                                 const char** json_object) {
+  // Served from the last snapshot, so the UI thread is neither waited on
+  // (it may be paused in the debugger) nor raced with.
+  std::stringstream response;
+  response << "{\"type\":\"PartitionStats\",\"partitions\":";
+  {
+    ftl::MutexLocker lock(&PartitionStatsMutex());
+    response << PartitionStatsSnapshot();
+  }
+  response << "}";
+
+  *json_object = strdup(response.str().c_str());
+  return true;
+}
+
+void PlatformViewServiceProtocol::SnapshotPartitionStats() {
+  std::stringstream partitions;
+  partitions << '[';
+  PartitionStatsWriter writer(&partitions);
+  blink::Partitions::dumpMemoryStats(&writer);
+  partitions << ']';
+
+  ftl::MutexLocker lock(&PartitionStatsMutex());
+  PartitionStatsSnapshot() = partitions.str();
+}
+
+const char* PlatformViewServiceProtocol::kRecordedTraceExtensionName =
+    "_flutter.recordedTrace";
+
+bool PlatformViewServiceProtocol::RecordedTrace(const char* method,
+                                                const char** param_keys,
+                                                const char** param_values,
+                                                intptr_t num_params,
+                                                void* user_data,
+                                                const char** json_object) {
+  // The events are in the Chrome trace format, so that saving the response
+  // gives a file that chrome://tracing can load.
+  std::stringstream response;
+  response << "{\"type\":\"RecordedTrace\",\"enabled\":"
+           << (glue::TraceRecorder::IsEnabled() ? "true" : "false")
+           << ",\"traceEvents\":";
+  glue::TraceRecorder::ExportChromeTraceEvents(response);
+  response << "}";
+
+  *json_object = strdup(response.str().c_str());
+  return true;
+}
 
-  Rasterizer* rasterizer = rasterizers[0].get();
+void PlatformViewServiceProtocol::ScreenshotGpuTask(
+    const ftl::WeakPtr<Rasterizer>& weak_rasterizer,
+    SkBitmap* bitmap) {
+  Rasterizer* rasterizer = weak_rasterizer.get();
   if (rasterizer == nullptr)
     return;
 
@@ -18,6 +18,11 @@ class PlatformViewServiceProtocol {
  public:
   static void RegisterHook(bool running_precompiled_code);
 
+  // Records the engine's partition stats for _flutter.partitionStats. The
+  // size specific partitions have no lock, so this must be called on the UI
+  // thread between tasks.
+  static void SnapshotPartitionStats();
+
  private:
   static const char* kRunInViewExtensionName;
   static bool RunInView(const char* method,
@@ -42,7 +47,24 @@ class PlatformViewServiceProtocol {
                          intptr_t num_params,
                          void* user_data,
                          const char** json_object);
-  static void ScreenshotGpuTask(SkBitmap* bitmap);
+  static void ScreenshotGpuTask(const ftl::WeakPtr<Rasterizer>& rasterizer,
+                                SkBitmap* bitmap);
+
+  static const char* kPartitionStatsExtensionName;
+  static bool PartitionStats(const char* method,
+                             const char** param_keys,
+                             const char** param_values,
+                             intptr_t num_params,
+                             void* user_data,
+                             const char** json_object);
+
+  static const char* kRecordedTraceExtensionName;
+  static bool RecordedTrace(const char* method,
+                            const char** param_keys,
+                            const char** param_values,
+                            intptr_t num_params,
+                            void* user_data,
+                            const char** json_object);
 };
 
 }  // namespace shell
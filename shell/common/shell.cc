@@ -16,11 +16,12 @@
 #include "base/memory/discardable_memory_allocator.h"
 #include "base/posix/eintr_wrapper.h"
 #include "base/single_thread_task_runner.h"
-#include "base/trace_event/trace_event.h"
 #include "dart/runtime/include/dart_tools_api.h"
 #include "flutter/common/settings.h"
 #include "flutter/common/threads.h"
 #include "flutter/glue/task_runner_adaptor.h"
+#include "flutter/glue/trace_event.h"
+#include "flutter/glue/trace_recorder.h"
 #include "flutter/runtime/dart_init.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/platform_view_service_protocol.h"
@@ -34,8 +35,8 @@ namespace {
 
 static Shell* g_shell = nullptr;
 
-bool IsInvalid(const ftl::WeakPtr<Rasterizer>& rasterizer) {
-  return !rasterizer;
+bool IsInvalid(const Shell::RasterizerInfo& info) {
+  return !info.rasterizer;
 }
 
 bool IsViewInvalid(const ftl::WeakPtr<PlatformView>& platform_view) {
@@ -87,17 +88,37 @@ Shell::Shell() {
   io_thread_.reset(new base::Thread("io_thread"));
   io_thread_->StartWithOptions(options);
 
-  blink::Threads threads(ftl::MakeRefCounted<glue::TaskRunnerAdaptor>(
-                             base::MessageLoop::current()->task_runner()),
+  platform_task_runner_ = ftl::MakeRefCounted<blink::CountingTaskRunner>(
+      ftl::MakeRefCounted<glue::TaskRunnerAdaptor>(
+          base::MessageLoop::current()->task_runner()));
+  ui_task_runner_ = ftl::MakeRefCounted<blink::CountingTaskRunner>(
+      ftl::MakeRefCounted<glue::TaskRunnerAdaptor>(
+          ui_thread_->message_loop()->task_runner()));
+
+  blink::Threads threads(platform_task_runner_,
                          ftl::MakeRefCounted<glue::TaskRunnerAdaptor>(
                              gpu_thread_->message_loop()->task_runner()),
-                         ftl::MakeRefCounted<glue::TaskRunnerAdaptor>(
-                             ui_thread_->message_loop()->task_runner()),
+                         ui_task_runner_,
                          ftl::MakeRefCounted<glue::TaskRunnerAdaptor>(
                              io_thread_->message_loop()->task_runner()));
   blink::Threads::Set(threads);
 
-  blink::Threads::Gpu()->PostTask([this]() { InitGpuThread(); });
+#if defined(FLUTTER_TRACE_RECORDER)
+  // Recorded events are exported through the service protocol.
+  glue::TraceRecorder::SetEnabled(true);
+  glue::TraceRecorder::SetCurrentThreadName("platform_thread");
+  blink::Threads::Gpu()->PostTask(
+      []() { glue::TraceRecorder::SetCurrentThreadName("gpu_thread"); });
+  blink::Threads::UI()->PostTask(
+      []() { glue::TraceRecorder::SetCurrentThreadName("ui_thread"); });
+  blink::Threads::IO()->PostTask(
+      []() { glue::TraceRecorder::SetCurrentThreadName("io_thread"); });
+#endif  // defined(FLUTTER_TRACE_RECORDER)
+
+  auto default_group = std::make_unique<ThreadGroup>();
+  default_group->threads = threads;
+  thread_groups_.push_back(std::move(default_group));
+
   blink::Threads::UI()->PostTask([this]() { InitUIThread(); });
 
   blink::SetServiceIsolateHook(ServiceIsolateHook);
@@ -147,6 +168,9 @@ void Shell::InitStandalone(std::string icu_data_path) {
   settings.endless_trace_buffer =
       command_line.HasSwitch(switches::kEndlessTraceBuffer);
   settings.trace_startup = command_line.HasSwitch(switches::kTraceStartup);
+  settings.prewarm_fonts = command_line.HasSwitch(switches::kPrewarmFonts);
+  settings.precreate_isolate =
+      command_line.HasSwitch(switches::kPrecreateIsolate);
   settings.aot_snapshot_path =
       command_line.GetSwitchValueASCII(switches::kAotSnapshotPath);
   settings.aot_isolate_snapshot_file_name =
@@ -159,6 +183,18 @@ void Shell::InitStandalone(std::string icu_data_path) {
       command_line.GetSwitchValueASCII(switches::kAotRodataBlob);
   settings.temp_directory_path =
       command_line.GetSwitchValueASCII(switches::kCacheDirPath);
+  if (command_line.HasSwitch(switches::kGpuThreadCount)) {
+    std::stringstream stream(
+        command_line.GetSwitchValueASCII(switches::kGpuThreadCount));
+    int count = 0;
+    if (stream >> count && count > 0) {
+      settings.gpu_thread_count = count;
+    } else {
+      FTL_LOG(INFO) << "GPU thread count specified was malformed. Will "
+                       "default to "
+                    << settings.gpu_thread_count;
+    }
+  }
 
   if (command_line.HasSwitch(switches::kDartFlags)) {
     std::stringstream stream(
@@ -194,28 +230,80 @@ TracingController& Shell::tracing_controller() {
   return tracing_controller_;
 }
 
-void Shell::InitGpuThread() {
-  gpu_thread_checker_.reset(new base::ThreadChecker());
-}
-
 void Shell::InitUIThread() {
   ui_thread_checker_.reset(new base::ThreadChecker());
 }
 
-void Shell::AddRasterizer(const ftl::WeakPtr<Rasterizer>& rasterizer) {
-  FTL_DCHECK(gpu_thread_checker_ && gpu_thread_checker_->CalledOnValidThread());
-  rasterizers_.push_back(rasterizer);
+const blink::Threads* Shell::AcquireThreadGroup() {
+  ftl::MutexLocker lock(&thread_groups_mutex_);
+
+  ThreadGroup* group = thread_groups_.front().get();
+  for (const auto& candidate : thread_groups_) {
+    if (candidate->view_count < group->view_count)
+      group = candidate.get();
+  }
+
+  int max_groups = blink::Settings::Get().gpu_thread_count;
+  if (group->view_count > 0 &&
+      static_cast<int>(thread_groups_.size()) < max_groups) {
+    auto new_group = std::make_unique<ThreadGroup>();
+    std::stringstream name;
+    name << "gpu_thread_" << thread_groups_.size();
+    new_group->gpu_thread.reset(new base::Thread(name.str()));
+    new_group->gpu_thread->StartWithOptions(base::Thread::Options());
+
+    const blink::Threads& defaults = thread_groups_.front()->threads;
+    new_group->threads = blink::Threads(
+        defaults.platform(),
+        ftl::MakeRefCounted<glue::TaskRunnerAdaptor>(
+            new_group->gpu_thread->message_loop()->task_runner()),
+        defaults.ui(), defaults.io());
+
+    // The thread only ever works for this group, so the group stays current
+    // on it for code that looks up blink::Threads::Gpu() there.
+    const blink::Threads* threads = &new_group->threads;
+    threads->gpu()->PostTask([threads]() {
+      blink::Threads::SetCurrent(threads);
+#if defined(FLUTTER_TRACE_RECORDER)
+      glue::TraceRecorder::SetCurrentThreadName("gpu_thread");
+#endif  // defined(FLUTTER_TRACE_RECORDER)
+    });
+
+    group = new_group.get();
+    thread_groups_.push_back(std::move(new_group));
+  }
+
+  ++group->view_count;
+  return &group->threads;
+}
+
+void Shell::ReleaseThreadGroup(const blink::Threads* threads) {
+  ftl::MutexLocker lock(&thread_groups_mutex_);
+  for (const auto& group : thread_groups_) {
+    if (&group->threads == threads) {
+      FTL_DCHECK(group->view_count > 0);
+      --group->view_count;
+      return;
+    }
+  }
+  FTL_NOTREACHED();
+}
+
+void Shell::AddRasterizer(const ftl::WeakPtr<Rasterizer>& rasterizer,
+                          ftl::RefPtr<ftl::TaskRunner> gpu_task_runner) {
+  ftl::MutexLocker lock(&rasterizers_mutex_);
+  rasterizers_.push_back({rasterizer, std::move(gpu_task_runner)});
 }
 
 void Shell::PurgeRasterizers() {
-  FTL_DCHECK(gpu_thread_checker_ && gpu_thread_checker_->CalledOnValidThread());
+  ftl::MutexLocker lock(&rasterizers_mutex_);
   rasterizers_.erase(
       std::remove_if(rasterizers_.begin(), rasterizers_.end(), IsInvalid),
       rasterizers_.end());
 }
 
-void Shell::GetRasterizers(std::vector<ftl::WeakPtr<Rasterizer>>* rasterizers) {
-  FTL_DCHECK(gpu_thread_checker_ && gpu_thread_checker_->CalledOnValidThread());
+void Shell::GetRasterizers(std::vector<RasterizerInfo>* rasterizers) {
+  ftl::MutexLocker lock(&rasterizers_mutex_);
   *rasterizers = rasterizers_;
 }
 
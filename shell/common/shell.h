@@ -6,10 +6,13 @@
 #define SHELL_COMMON_SHELL_H_
 
 #include "base/threading/thread.h"
+#include "flutter/common/counting_task_runner.h"
+#include "flutter/common/threads.h"
 #include "flutter/shell/common/tracing_controller.h"
 #include "lib/ftl/macros.h"
 #include "lib/ftl/memory/ref_ptr.h"
 #include "lib/ftl/memory/weak_ptr.h"
+#include "lib/ftl/synchronization/mutex.h"
 #include "lib/ftl/synchronization/waitable_event.h"
 #include "lib/ftl/tasks/task_runner.h"
 
@@ -29,11 +32,36 @@ class Shell {
 
   TracingController& tracing_controller();
 
+  // The runners of the platform and UI threads, which all thread groups share.
+  // Their task counts let messages sent across threads share a task without
+  // overtaking anything posted in between.
+  const ftl::RefPtr<blink::CountingTaskRunner>& platform_task_runner() const {
+    return platform_task_runner_;
+  }
+  const ftl::RefPtr<blink::CountingTaskRunner>& ui_task_runner() const {
+    return ui_task_runner_;
+  }
+
+  // Hands out the thread group a new platform view runs on. Groups share the
+  // platform, UI and IO threads; each has its own GPU thread. Up to
+  // |Settings::gpu_thread_count| groups are created, and views are spread
+  // over them, least loaded first. The returned group lives for the rest of
+  // the process. Can be called from any thread.
+  const blink::Threads* AcquireThreadGroup();
+  void ReleaseThreadGroup(const blink::Threads* threads);
+
+  struct RasterizerInfo {
+    ftl::WeakPtr<Rasterizer> rasterizer;
+    // The GPU thread the rasterizer must be used on.
+    ftl::RefPtr<ftl::TaskRunner> gpu_task_runner;
+  };
+
   // Maintain a list of rasterizers.
-  // These APIs must only be accessed on the GPU thread.
-  void AddRasterizer(const ftl::WeakPtr<Rasterizer>& rasterizer);
+  // These APIs can be called from any thread.
+  void AddRasterizer(const ftl::WeakPtr<Rasterizer>& rasterizer,
+                     ftl::RefPtr<ftl::TaskRunner> gpu_task_runner);
   void PurgeRasterizers();
-  void GetRasterizers(std::vector<ftl::WeakPtr<Rasterizer>>* rasterizer);
+  void GetRasterizers(std::vector<RasterizerInfo>* rasterizers);
 
   // List of PlatformViews.
 
@@ -66,7 +94,12 @@ class Shell {
  private:
   Shell();
 
-  void InitGpuThread();
+  struct ThreadGroup {
+    std::unique_ptr<base::Thread> gpu_thread;
+    blink::Threads threads;
+    int view_count = 0;
+  };
+
   void InitUIThread();
 
   void WaitForPlatformViewsIdsUIThread(
@@ -86,12 +119,19 @@ class Shell {
   std::unique_ptr<base::Thread> ui_thread_;
   std::unique_ptr<base::Thread> io_thread_;
 
-  std::unique_ptr<base::ThreadChecker> gpu_thread_checker_;
   std::unique_ptr<base::ThreadChecker> ui_thread_checker_;
 
+  ftl::RefPtr<blink::CountingTaskRunner> platform_task_runner_;
+  ftl::RefPtr<blink::CountingTaskRunner> ui_task_runner_;
+
   TracingController tracing_controller_;
 
-  std::vector<ftl::WeakPtr<Rasterizer>> rasterizers_;
+  ftl::Mutex thread_groups_mutex_;
+  // The first group runs on |gpu_thread_|.
+  std::vector<std::unique_ptr<ThreadGroup>> thread_groups_;
+
+  ftl::Mutex rasterizers_mutex_;
+  std::vector<RasterizerInfo> rasterizers_;
   std::vector<ftl::WeakPtr<PlatformView>> platform_views_;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(Shell);
@@ -14,17 +14,21 @@ const char kAotIsolateSnapshot[] = "isolate-snapshot";
 const char kAotRodataBlob[] = "rodata-blob";
 const char kAotSnapshotPath[] = "aot-snapshot-path";
 const char kAotVmIsolateSnapshot[] = "vm-isolate-snapshot";
+const char kBenchmarkFrames[] = "benchmark-frames";
 const char kCacheDirPath[] = "cache-dir-path";
 const char kDartFlags[] = "dart-flags";
 const char kDeviceObservatoryPort[] = "observatory-port";
 const char kDisableObservatory[] = "disable-observatory";
 const char kEndlessTraceBuffer[] = "endless-trace-buffer";
 const char kFLX[] = "flx";
+const char kGpuThreadCount[] = "gpu-thread-count";
 const char kHelp[] = "help";
 const char kMainDartFile[] = "dart-main";
 const char kNonInteractive[] = "non-interactive";
 const char kNoRedirectToSyslog[] = "no-redirect-to-syslog";
 const char kPackages[] = "packages";
+const char kPrecreateIsolate[] = "precreate-isolate";
+const char kPrewarmFonts[] = "prewarm-fonts";
 const char kStartPaused[] = "start-paused";
 const char kTraceStartup[] = "trace-startup";
 
@@ -34,9 +38,13 @@ void PrintUsage(const std::string& executable_name) {
             << " --" << kNonInteractive
             << " --" << kStartPaused
             << " --" << kTraceStartup
+            << " --" << kPrewarmFonts
+            << " --" << kPrecreateIsolate
             << " --" << kFLX << "=FLX"
             << " --" << kPackages << "=PACKAGES"
             << " --" << kDeviceObservatoryPort << "=8181"
+            << " --" << kGpuThreadCount << "=1"
+            << " --" << kBenchmarkFrames << "=FRAMES"
             << " [ MAIN_DART ]" << std::endl;
   // clang-format on
 }
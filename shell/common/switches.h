@@ -15,17 +15,21 @@ extern const char kAotIsolateSnapshot[];
 extern const char kAotRodataBlob[];
 extern const char kAotSnapshotPath[];
 extern const char kAotVmIsolateSnapshot[];
+extern const char kBenchmarkFrames[];
 extern const char kCacheDirPath[];
 extern const char kDartFlags[];
 extern const char kDeviceObservatoryPort[];
 extern const char kDisableObservatory[];
 extern const char kEndlessTraceBuffer[];
 extern const char kFLX[];
+extern const char kGpuThreadCount[];
 extern const char kHelp[];
 extern const char kMainDartFile[];
 extern const char kNonInteractive[];
 extern const char kNoRedirectToSyslog[];
 extern const char kPackages[];
+extern const char kPrecreateIsolate[];
+extern const char kPrewarmFonts[];
 extern const char kStartPaused[];
 extern const char kTraceStartup[];
 
@@ -6,9 +6,9 @@
 
 #include <string>
 
-#include "base/trace_event/trace_event.h"
 #include "dart/runtime/include/dart_tools_api.h"
 #include "flutter/common/threads.h"
+#include "flutter/glue/trace_event.h"
 #include "flutter/runtime/dart_init.h"
 #include "flutter/shell/common/shell.h"
 #include "lib/ftl/logging.h"
@@ -8,4 +8,8 @@ namespace shell {
 
 VsyncWaiter::~VsyncWaiter() = default;
 
+bool VsyncWaiter::InjectsFrameTimes() const {
+  return false;
+}
+
 }  // namespace shell
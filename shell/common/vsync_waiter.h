@@ -17,6 +17,12 @@ class VsyncWaiter {
 
   virtual void AsyncWaitForVsync(Callback callback) = 0;
 
+  // Whether the frame times passed to callbacks come from a clock that frames
+  // should be built against, e.g. a virtual clock stepped by a benchmark,
+  // rather than from a vsync signal that may be unstable. Only then does the
+  // animator hand them to the framework.
+  virtual bool InjectsFrameTimes() const;
+
   virtual ~VsyncWaiter();
 };
 
@@ -8,19 +8,15 @@
 #include <utility>
 
 #include "flutter/common/threads.h"
+#include "flutter/flow/frame_profile.h"
 #include "flutter/glue/trace_event.h"
-#include "flutter/shell/common/picture_serializer.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/shell.h"
 #include "third_party/skia/include/core/SkPicture.h"
 
 namespace shell {
 
-GPURasterizer::GPURasterizer() : weak_factory_(this) {
-  auto weak_ptr = weak_factory_.GetWeakPtr();
-  blink::Threads::Gpu()->PostTask(
-      [weak_ptr]() { Shell::Shared().AddRasterizer(weak_ptr); });
-}
+GPURasterizer::GPURasterizer() : weak_factory_(this) {}
 
 GPURasterizer::~GPURasterizer() {
   weak_factory_.InvalidateWeakPtrs();
@@ -109,34 +105,56 @@ void GPURasterizer::DoDraw(std::unique_ptr<flow::LayerTree> layer_tree) {
   // for instrumentation.
   compositor_context_.engine_time().SetLapTime(layer_tree->construction_time());
 
-  DrawToSurface(*layer_tree);
+  // While slow frames are being captured, every frame is profiled, so that a
+  // slow frame can be compared with the frames before it.
+  std::unique_ptr<flow::FrameProfile> profile;
+  if (ShouldProfileFrames(*layer_tree)) {
+    profile.reset(
+        new flow::FrameProfile(compositor_context_.frame_count().count() + 1));
+  }
 
-  DrawToTraceIfNecessary(*layer_tree);
+  if (DrawToSurface(*layer_tree, profile.get())) {
+    if (profile) {
+      profile->Finish(layer_tree->frame_size(), layer_tree->construction_time(),
+                      compositor_context_.frame_time().LastLap());
+      slow_frame_recorder_.AddFrame(std::move(profile));
+    }
+
+    DrawToTraceIfNecessary(*layer_tree);
+  }
 
   last_layer_tree_ = std::move(layer_tree);
 }
 
-void GPURasterizer::DrawToSurface(flow::LayerTree& layer_tree) {
+bool GPURasterizer::DrawToSurface(flow::LayerTree& layer_tree,
+                                  flow::FrameProfile* profile) {
   auto frame = surface_->AcquireFrame(layer_tree.frame_size());
 
   if (frame == nullptr) {
-    return;
+    return false;
   }
 
   auto canvas = frame->SkiaCanvas();
 
   if (canvas == nullptr) {
-    return;
+    return false;
   }
 
   auto compositor_frame =
       compositor_context_.AcquireFrame(surface_->GetContext(), *canvas);
+  compositor_frame.set_profile(profile);
 
   canvas->clear(SK_ColorBLACK);
 
   layer_tree.Raster(compositor_frame);
 
   frame->Submit();
+  return true;
+}
+
+bool GPURasterizer::ShouldProfileFrames(flow::LayerTree& layer_tree) {
+  return Shell::Shared().tracing_controller().picture_tracing_enabled() ||
+         layer_tree.rasterizer_tracing_threshold() != 0;
 }
 
 bool GPURasterizer::ShouldDrawToTrace(flow::LayerTree& layer_tree) {
@@ -164,6 +182,13 @@ void GPURasterizer::DrawToTraceIfNecessary(flow::LayerTree& layer_tree) {
 
   auto& tracing_controller = Shell::Shared().tracing_controller();
 
+  // Picture tracing asks for every frame; slow frames are only captured when
+  // the previous capture has been written.
+  if (!tracing_controller.picture_tracing_enabled() &&
+      slow_frame_recorder_.capture_pending()) {
+    return;
+  }
+
   std::string path = tracing_controller.PictureTracingPathForCurrentTime();
   LOG(INFO) << "Frame threshold exceeded. Capturing SKP to " << path;
 
@@ -178,7 +203,7 @@ void GPURasterizer::DrawToTraceIfNecessary(flow::LayerTree& layer_tree) {
 
   sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
 
-  SerializePicture(path, picture.get());
+  slow_frame_recorder_.Capture(path, std::move(picture));
 }
 
 }  // namespace shell
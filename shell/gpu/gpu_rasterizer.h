@@ -7,6 +7,7 @@
 
 #include "flutter/flow/compositor_context.h"
 #include "flutter/shell/common/rasterizer.h"
+#include "flutter/shell/gpu/slow_frame_recorder.h"
 #include "lib/ftl/memory/weak_ptr.h"
 #include "lib/ftl/synchronization/waitable_event.h"
 
@@ -39,11 +40,15 @@ class GPURasterizer : public Rasterizer {
   std::unique_ptr<Surface> surface_;
   flow::CompositorContext compositor_context_;
   std::unique_ptr<flow::LayerTree> last_layer_tree_;
+  SlowFrameRecorder slow_frame_recorder_;
   ftl::WeakPtrFactory<GPURasterizer> weak_factory_;
 
   void DoDraw(std::unique_ptr<flow::LayerTree> layer_tree);
 
-  void DrawToSurface(flow::LayerTree& layer_tree);
+  // Returns false if the surface could not provide a frame.
+  bool DrawToSurface(flow::LayerTree& layer_tree, flow::FrameProfile* profile);
+
+  bool ShouldProfileFrames(flow::LayerTree& layer_tree);
 
   bool ShouldDrawToTrace(flow::LayerTree& layer_tree);
 
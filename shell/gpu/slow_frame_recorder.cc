@@ -0,0 +1,126 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/gpu/slow_frame_recorder.h"
+
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include "flutter/common/worker_pool.h"
+#include "flutter/glue/trace_event.h"
+#include "flutter/shell/common/picture_serializer.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkStream.h"
+
+namespace shell {
+namespace {
+
+using FrameProfiles = std::vector<std::shared_ptr<const flow::FrameProfile>>;
+
+const char* RasterCacheResultName(flow::RasterCache::ImageResult result) {
+  switch (result) {
+    case flow::RasterCache::ImageResult::kEmpty:
+      return "empty";
+    case flow::RasterCache::ImageResult::kWarmingUp:
+      return "warmingUp";
+    case flow::RasterCache::ImageResult::kRejected:
+      return "rejected";
+    case flow::RasterCache::ImageResult::kRasterized:
+      return "rasterized";
+    case flow::RasterCache::ImageResult::kReused:
+      return "reused";
+  }
+  return "unknown";
+}
+
+void WriteLayer(std::ostream& out,
+                const flow::FrameProfile::LayerEntry& layer) {
+  const SkRect& bounds = layer.paint_bounds;
+  out << "{\"type\":\"" << layer.type_name << "\",\"depth\":" << layer.depth
+      << ",\"bounds\":[" << bounds.left() << "," << bounds.top() << ","
+      << bounds.right() << "," << bounds.bottom() << "]"
+      << ",\"culled\":" << (layer.culled ? "true" : "false")
+      << ",\"painted\":" << (layer.painted ? "true" : "false")
+      << ",\"prerollMs\":" << layer.preroll_time.ToMillisecondsF()
+      << ",\"paintMs\":" << layer.paint_time.ToMillisecondsF();
+  if (layer.has_raster_cache_result) {
+    out << ",\"rasterCache\":\""
+        << RasterCacheResultName(layer.raster_cache_result) << "\"";
+  }
+  out << "}";
+}
+
+void WriteProfile(std::ostream& out, const flow::FrameProfile& profile) {
+  out << "{\"frame\":" << profile.frame_number()
+      << ",\"width\":" << profile.frame_size().width()
+      << ",\"height\":" << profile.frame_size().height()
+      << ",\"buildMs\":" << profile.build_time().ToMillisecondsF()
+      << ",\"rasterMs\":" << profile.raster_time().ToMillisecondsF()
+      << ",\"layers\":[";
+  const auto& layers = profile.layers();
+  for (size_t i = 0; i < layers.size(); ++i) {
+    if (i > 0)
+      out << ",";
+    WriteLayer(out, layers[i]);
+  }
+  out << "]}";
+}
+
+// Frames are listed oldest first; the last one is the captured frame.
+void WriteProfiles(const std::string& path,
+                   const std::string& picture_path,
+                   const FrameProfiles& profiles) {
+  std::ofstream out(path);
+  out << "{\"picture\":\"" << picture_path << "\",\"frames\":[";
+  for (size_t i = 0; i < profiles.size(); ++i) {
+    if (i > 0)
+      out << ",";
+    WriteProfile(out, *profiles[i]);
+  }
+  out << "]}";
+}
+
+std::string ProfilePathForPicturePath(const std::string& picture_path) {
+  return picture_path.substr(0, picture_path.rfind('.')) + ".json";
+}
+
+}  // namespace
+
+SlowFrameRecorder::SlowFrameRecorder()
+    : capture_pending_(std::make_shared<std::atomic<bool>>(false)) {}
+
+SlowFrameRecorder::~SlowFrameRecorder() = default;
+
+void SlowFrameRecorder::AddFrame(std::unique_ptr<flow::FrameProfile> profile) {
+  profiles_.push_back(std::move(profile));
+  while (profiles_.size() > kPreviousFrameCount + 1)
+    profiles_.pop_front();
+}
+
+void SlowFrameRecorder::Capture(const std::string& picture_path,
+                                sk_sp<SkPicture> picture) {
+  TRACE_EVENT0("flutter", "SlowFrameRecorder::Capture");
+
+  SkDynamicMemoryWStream stream;
+  PngPixelSerializer serializer;
+  picture->serialize(&stream, &serializer);
+  sk_sp<SkData> picture_data(stream.snapshotAsData());
+
+  FrameProfiles profiles(profiles_.begin(), profiles_.end());
+  std::string profile_path = ProfilePathForPicturePath(picture_path);
+  auto capture_pending = capture_pending_;
+  capture_pending->store(true);
+
+  blink::WorkerPool::Get().PostTask(
+      blink::WorkerPool::Priority::kBackground, "SlowFrameRecorder::Write",
+      [picture_path, picture_data, profile_path, profiles, capture_pending]() {
+        SkFILEWStream picture_stream(picture_path.c_str());
+        picture_stream.write(picture_data->data(), picture_data->size());
+        WriteProfiles(profile_path, picture_path, profiles);
+        capture_pending->store(false);
+      });
+}
+
+}  // namespace shell
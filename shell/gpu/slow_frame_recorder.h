@@ -0,0 +1,52 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_GPU_SLOW_FRAME_RECORDER_H_
+#define SHELL_GPU_SLOW_FRAME_RECORDER_H_
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "flutter/flow/frame_profile.h"
+#include "lib/ftl/macros.h"
+#include "third_party/skia/include/core/SkPicture.h"
+
+namespace shell {
+
+// Keeps the profiles of the last few frames drawn by a rasterizer so that,
+// when a frame runs over budget, they can be written out along with a
+// picture of that frame. Used on the GPU thread; the files are written on the
+// worker pool.
+class SlowFrameRecorder {
+ public:
+  SlowFrameRecorder();
+  ~SlowFrameRecorder();
+
+  // Profiles kept besides the one of the frame being captured.
+  static const size_t kPreviousFrameCount = 4;
+
+  void AddFrame(std::unique_ptr<flow::FrameProfile> profile);
+
+  // Whether the last capture is still being written. Captures of slow frames
+  // are skipped meanwhile, so that a run of slow frames does not pile up
+  // writes.
+  bool capture_pending() const { return capture_pending_->load(); }
+
+  // Writes |picture| to |picture_path| and the recent frame profiles, as
+  // JSON, next to it. The picture is serialized before returning, as it may
+  // hold textures that can only be read on this thread.
+  void Capture(const std::string& picture_path, sk_sp<SkPicture> picture);
+
+ private:
+  std::deque<std::shared_ptr<const flow::FrameProfile>> profiles_;
+  std::shared_ptr<std::atomic<bool>> capture_pending_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(SlowFrameRecorder);
+};
+
+}  // namespace shell
+
+#endif  // SHELL_GPU_SLOW_FRAME_RECORDER_H_
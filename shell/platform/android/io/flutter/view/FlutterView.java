@@ -198,6 +198,16 @@ public class FlutterView extends SurfaceView
         sendPlatformMessage("flutter/lifecycle", "AppLifecycleState.resumed", null);
     }
 
+    public void onMemoryPressure() {
+        try {
+            final JSONObject message = new JSONObject();
+            message.put("type", "memoryPressure");
+            sendPlatformMessage("flutter/system", message.toString(), null);
+        } catch (JSONException e) {
+            Log.e(TAG, "Unexpected JSONException reporting memory pressure", e);
+        }
+    }
+
     public void pushRoute(String route) {
         try {
             final JSONArray args = new JSONArray();
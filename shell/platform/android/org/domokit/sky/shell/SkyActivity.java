@@ -100,6 +100,14 @@ public class SkyActivity extends Activity {
         }
     }
 
+    @Override
+    public void onTrimMemory(int level) {
+        super.onTrimMemory(level);
+        if (level >= TRIM_MEMORY_RUNNING_LOW && mView != null) {
+            mView.onMemoryPressure();
+        }
+    }
+
     /**
       * Override this function to customize startup behavior.
       */
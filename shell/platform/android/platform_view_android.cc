@@ -17,9 +17,9 @@
 #include "base/android/jni_string.h"
 #include "base/bind.h"
 #include "base/location.h"
-#include "base/trace_event/trace_event.h"
 #include "flutter/common/threads.h"
 #include "flutter/flow/compositor_context.h"
+#include "flutter/glue/trace_event.h"
 #include "flutter/runtime/dart_service_isolate.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/shell.h"
@@ -123,13 +123,13 @@ void PlatformViewAndroid::SurfaceChanged(JNIEnv* env,
     return;
   }
 
-  blink::Threads::Gpu()->PostTask([this, width, height]() {
+  threads_->gpu()->PostTask([this, width, height]() {
     surface_gl_->OnScreenSurfaceResize(SkISize::Make(width, height));
   });
 }
 
 void PlatformViewAndroid::UpdateThreadPriorities() {
-  blink::Threads::Gpu()->PostTask(
+  threads_->gpu()->PostTask(
       []() { ::setpriority(PRIO_PROCESS, gettid(), -2); });
 
   blink::Threads::UI()->PostTask(
@@ -427,7 +427,7 @@ base::android::ScopedJavaLocalRef<jobject> PlatformViewAndroid::GetBitmap(
   ftl::AutoResetWaitableEvent latch;
   jobject pixels_ref = nullptr;
   SkISize frame_size;
-  blink::Threads::Gpu()->PostTask([this, &latch, &pixels_ref, &frame_size]() {
+  threads_->gpu()->PostTask([this, &latch, &pixels_ref, &frame_size]() {
     GetBitmapGpuTask(&latch, &pixels_ref, &frame_size);
   });
 
@@ -8,8 +8,8 @@
 #include <Foundation/Foundation.h>
 
 #include "base/command_line.h"
-#include "base/trace_event/trace_event.h"
 #include "flutter/common/threads.h"
+#include "flutter/glue/trace_event.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/gpu/gpu_rasterizer.h"
 #include "flutter/shell/platform/darwin/common/platform_mac.h"
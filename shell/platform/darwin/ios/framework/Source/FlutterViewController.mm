@@ -150,6 +150,11 @@ void FlutterInit(int argc, const char* argv[]) {
                  name:UIApplicationWillResignActiveNotification
                object:nil];
 
+  [center addObserver:self
+             selector:@selector(applicationDidReceiveMemoryWarning:)
+                 name:UIApplicationDidReceiveMemoryWarningNotification
+               object:nil];
+
   [center addObserver:self
              selector:@selector(keyboardWasShown:)
                  name:UIKeyboardDidShowNotification
@@ -226,6 +231,11 @@ void FlutterInit(int argc, const char* argv[]) {
       withMessageName:@"flutter/lifecycle"];
 }
 
+- (void)applicationDidReceiveMemoryWarning:(NSNotification*)notification {
+  [self sendJSON:@{ @"type" : @"memoryPressure" }
+      withMessageName:@"flutter/system"];
+}
+
 #pragma mark - Touch event handling
 
 enum MapperPhase {
@@ -11,8 +11,8 @@
 #include <utility>
 
 #include "base/mac/scoped_nsautorelease_pool.h"
-#include "base/trace_event/trace_event.h"
 #include "flutter/common/threads.h"
+#include "flutter/glue/trace_event.h"
 #include "flutter/shell/gpu/gpu_rasterizer.h"
 #include "flutter/shell/platform/darwin/ios/framework/Source/vsync_waiter_ios.h"
 #include "lib/ftl/synchronization/waitable_event.h"
@@ -311,7 +311,7 @@ ftl::WeakPtr<PlatformViewIOS> PlatformViewIOS::GetWeakPtr() {
 }
 
 void PlatformViewIOS::UpdateSurfaceSize() {
-  blink::Threads::Gpu()->PostTask([self = GetWeakPtr()]() {
+  threads_->gpu()->PostTask([self = GetWeakPtr()]() {
     if (self && self->context_ != nullptr) {
       self->context_->UpdateStorageSizeIfNecessary();
     }
@@ -0,0 +1,88 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/testing/benchmark_rasterizer.h"
+
+#include <functional>
+#include <utility>
+
+#include "flutter/glue/trace_event.h"
+
+namespace shell {
+
+BenchmarkRasterizer::BenchmarkRasterizer() : weak_factory_(this) {}
+
+BenchmarkRasterizer::~BenchmarkRasterizer() = default;
+
+void BenchmarkRasterizer::Setup(
+    std::unique_ptr<Surface> surface_or_null,
+    ftl::Closure rasterizer_continuation,
+    ftl::AutoResetWaitableEvent* setup_completion_event) {
+  // Frames are drawn offscreen whether or not there is a surface.
+  rasterizer_continuation();
+  setup_completion_event->Signal();
+}
+
+void BenchmarkRasterizer::Teardown(
+    ftl::AutoResetWaitableEvent* teardown_completion_event) {
+  surface_.reset();
+  last_layer_tree_.reset();
+  teardown_completion_event->Signal();
+}
+
+void BenchmarkRasterizer::Clear(SkColor color, const SkISize& size) {
+  // Nothing is shown, so there is nothing to clear.
+}
+
+ftl::WeakPtr<Rasterizer> BenchmarkRasterizer::GetWeakRasterizerPtr() {
+  return weak_factory_.GetWeakPtr();
+}
+
+ftl::WeakPtr<BenchmarkRasterizer> BenchmarkRasterizer::GetWeakPtr() {
+  return weak_factory_.GetWeakPtr();
+}
+
+flow::LayerTree* BenchmarkRasterizer::GetLastLayerTree() {
+  return last_layer_tree_.get();
+}
+
+void BenchmarkRasterizer::Draw(
+    ftl::RefPtr<flutter::Pipeline<flow::LayerTree>> pipeline) {
+  TRACE_EVENT0("flutter", "BenchmarkRasterizer::Draw");
+
+  flutter::Pipeline<flow::LayerTree>::Consumer consumer =
+      std::bind(&BenchmarkRasterizer::DoDraw, this, std::placeholders::_1);
+
+  // Unlike the GPU rasterizer, do not yield between frames, so that tasks
+  // posted to the GPU thread after this one run once the frames are drawn.
+  while (pipeline->Consume(consumer) ==
+         flutter::PipelineConsumeResult::MoreAvailable) {
+  }
+}
+
+void BenchmarkRasterizer::DoDraw(std::unique_ptr<flow::LayerTree> layer_tree) {
+  if (!layer_tree)
+    return;
+
+  const SkISize& size = layer_tree->frame_size();
+  if (!surface_ || surface_->width() != size.width() ||
+      surface_->height() != size.height()) {
+    surface_ = SkSurface::MakeRasterN32Premul(size.width(), size.height());
+    if (!surface_)
+      return;
+  }
+
+  {
+    SkCanvas* canvas = surface_->getCanvas();
+    auto compositor_frame = compositor_context_.AcquireFrame(nullptr, *canvas);
+    canvas->clear(SK_ColorBLACK);
+    layer_tree->Raster(compositor_frame);
+  }
+
+  // The frame is timed until the compositor frame goes away.
+  raster_times_.push_back(compositor_context_.frame_time().LastLap());
+  last_layer_tree_ = std::move(layer_tree);
+}
+
+}  // namespace shell
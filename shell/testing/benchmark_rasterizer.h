@@ -0,0 +1,66 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_TESTING_BENCHMARK_RASTERIZER_H_
+#define SHELL_TESTING_BENCHMARK_RASTERIZER_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/flow/compositor_context.h"
+#include "flutter/shell/common/rasterizer.h"
+#include "lib/ftl/macros.h"
+#include "lib/ftl/memory/weak_ptr.h"
+#include "lib/ftl/time/time_delta.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace shell {
+
+// Rasterizes every frame into an offscreen raster surface and records how
+// long each took, so that the test shell can report the raster cost of a
+// benchmark without a window or a GPU.
+class BenchmarkRasterizer : public Rasterizer {
+ public:
+  BenchmarkRasterizer();
+  ~BenchmarkRasterizer() override;
+
+  void Setup(std::unique_ptr<Surface> surface_or_null,
+             ftl::Closure rasterizer_continuation,
+             ftl::AutoResetWaitableEvent* setup_completion_event) override;
+
+  void Teardown(
+      ftl::AutoResetWaitableEvent* teardown_completion_event) override;
+
+  void Clear(SkColor color, const SkISize& size) override;
+
+  ftl::WeakPtr<Rasterizer> GetWeakRasterizerPtr() override;
+
+  flow::LayerTree* GetLastLayerTree() override;
+
+  // Draws everything in the pipeline before returning.
+  void Draw(ftl::RefPtr<flutter::Pipeline<flow::LayerTree>> pipeline) override;
+
+  ftl::WeakPtr<BenchmarkRasterizer> GetWeakPtr();
+
+  // In the order the frames were drawn. Only read on the GPU thread.
+  const std::vector<ftl::TimeDelta>& raster_times() const {
+    return raster_times_;
+  }
+
+ private:
+  void DoDraw(std::unique_ptr<flow::LayerTree> layer_tree);
+
+  flow::CompositorContext compositor_context_;
+  sk_sp<SkSurface> surface_;
+  std::unique_ptr<flow::LayerTree> last_layer_tree_;
+  std::vector<ftl::TimeDelta> raster_times_;
+
+  ftl::WeakPtrFactory<BenchmarkRasterizer> weak_factory_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(BenchmarkRasterizer);
+};
+
+}  // namespace shell
+
+#endif  // SHELL_TESTING_BENCHMARK_RASTERIZER_H_
@@ -4,13 +4,76 @@
 
 #include "flutter/shell/testing/platform_view_test.h"
 
+#include <stdlib.h>
+
+#include <iostream>
+
 #include "flutter/shell/common/null_rasterizer.h"
 #include "flutter/shell/common/shell.h"
+#include "flutter/shell/testing/benchmark_rasterizer.h"
+#include "flutter/shell/testing/vsync_waiter_virtual.h"
 
 namespace shell {
+namespace {
+
+std::unique_ptr<Rasterizer> CreateRasterizer(size_t benchmark_frame_count) {
+  if (benchmark_frame_count > 0)
+    return std::unique_ptr<Rasterizer>(new BenchmarkRasterizer());
+  return std::unique_ptr<Rasterizer>(new NullRasterizer());
+}
+
+double AverageMilliseconds(const std::vector<ftl::TimeDelta>& times) {
+  if (times.empty())
+    return 0.0;
+  double total = 0.0;
+  for (const auto& time : times)
+    total += time.ToMillisecondsF();
+  return total / times.size();
+}
+
+void WriteMilliseconds(std::ostream& out,
+                       const std::vector<ftl::TimeDelta>& times) {
+  out << "[";
+  for (size_t i = 0; i < times.size(); ++i) {
+    if (i > 0)
+      out << ",";
+    out << times[i].ToMillisecondsF();
+  }
+  out << "]";
+}
+
+// Frames that were begun but not rendered have a build time and no raster
+// time, so the two lists may differ in length.
+void WriteBenchmarkReport(std::ostream& out,
+                          const std::vector<ftl::TimeDelta>& build_times,
+                          const std::vector<ftl::TimeDelta>& raster_times) {
+  out << "{\"frameCount\":" << build_times.size()
+      << ",\"averageBuildMs\":" << AverageMilliseconds(build_times)
+      << ",\"averageRasterMs\":" << AverageMilliseconds(raster_times)
+      << ",\"buildMs\":";
+  WriteMilliseconds(out, build_times);
+  out << ",\"rasterMs\":";
+  WriteMilliseconds(out, raster_times);
+  out << "}";
+}
+
+}  // namespace
 
-PlatformViewTest::PlatformViewTest()
-    : PlatformView(std::unique_ptr<Rasterizer>(new NullRasterizer())) {
+PlatformViewTest::PlatformViewTest() : PlatformViewTest(0) {}
+
+PlatformViewTest::PlatformViewTest(size_t benchmark_frame_count)
+    : PlatformView(CreateRasterizer(benchmark_frame_count)),
+      benchmark_rasterizer_(nullptr) {
+  // The engine picks up the vsync waiter when it is created.
+  if (benchmark_frame_count > 0) {
+    benchmark_rasterizer_ =
+        static_cast<BenchmarkRasterizer*>(rasterizer_.get());
+    vsync_waiter_.reset(new VsyncWaiterVirtual(
+        *threads_, benchmark_frame_count,
+        [this](const std::vector<ftl::TimeDelta>& build_times) {
+          ReportBenchmark(build_times);
+        }));
+  }
   CreateEngine();
 }
 
@@ -24,4 +87,20 @@ void PlatformViewTest::RunFromSource(const std::string& assets_directory,
                                      const std::string& main,
                                      const std::string& packages) {}
 
+void PlatformViewTest::ReportBenchmark(
+    const std::vector<ftl::TimeDelta>& build_times) {
+  // The raster times are only touched on the GPU thread, which has drawn the
+  // last frame by the time the benchmark is done.
+  threads_->gpu()->PostTask(
+      [ rasterizer = benchmark_rasterizer_->GetWeakPtr(), build_times ] {
+        if (!rasterizer)
+          return;
+        WriteBenchmarkReport(std::cout, build_times,
+                             rasterizer->raster_times());
+        std::cout << std::endl;
+        // Nothing else ends the test shell once the frames have been drawn.
+        exit(0);
+      });
+}
+
 }  // namespace shell
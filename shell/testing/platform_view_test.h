@@ -5,18 +5,26 @@
 #ifndef SHELL_TESTING_PLATFORM_VIEW_TEST_H_
 #define SHELL_TESTING_PLATFORM_VIEW_TEST_H_
 
+#include <vector>
+
 #include "flutter/shell/common/platform_view.h"
 #include "lib/ftl/macros.h"
 #include "lib/ftl/memory/weak_ptr.h"
+#include "lib/ftl/time/time_delta.h"
 
 namespace shell {
 
+class BenchmarkRasterizer;
 class Shell;
 
 class PlatformViewTest : public PlatformView {
  public:
   PlatformViewTest();
 
+  // Builds and rasterizes |benchmark_frame_count| frames off a virtual clock,
+  // as fast as they can be drawn, then prints how long each took and exits.
+  explicit PlatformViewTest(size_t benchmark_frame_count);
+
   ~PlatformViewTest();
 
   bool ResourceContextMakeCurrent() override;
@@ -26,6 +34,11 @@ class PlatformViewTest : public PlatformView {
                      const std::string& packages) override;
 
  private:
+  void ReportBenchmark(const std::vector<ftl::TimeDelta>& build_times);
+
+  // Owned by the base class. Null unless benchmarking.
+  BenchmarkRasterizer* benchmark_rasterizer_;
+
   FTL_DISALLOW_COPY_AND_ASSIGN(PlatformViewTest);
 };
 
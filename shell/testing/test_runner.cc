@@ -13,7 +13,20 @@
 
 namespace shell {
 
-TestRunner::TestRunner() : platform_view_(new PlatformViewTest()) {
+TestRunner::TestRunner() = default;
+
+TestRunner::~TestRunner() = default;
+
+TestRunner& TestRunner::Shared() {
+  static TestRunner* g_test_runner = nullptr;
+  if (!g_test_runner)
+    g_test_runner = new TestRunner();
+  return *g_test_runner;
+}
+
+void TestRunner::CreatePlatformView(size_t benchmark_frame_count) {
+  platform_view_.reset(new PlatformViewTest(benchmark_frame_count));
+
   blink::ViewportMetrics metrics;
   metrics.physical_width = 800;
   metrics.physical_height = 600;
@@ -25,16 +38,12 @@ TestRunner::TestRunner() : platform_view_(new PlatformViewTest()) {
       });
 }
 
-TestRunner::~TestRunner() = default;
-
-TestRunner& TestRunner::Shared() {
-  static TestRunner* g_test_runner = nullptr;
-  if (!g_test_runner)
-    g_test_runner = new TestRunner();
-  return *g_test_runner;
-}
-
 void TestRunner::Run(const TestDescriptor& test) {
+  // The view is created for the first test, which decides whether frames are
+  // drawn for a benchmark.
+  if (!platform_view_)
+    CreatePlatformView(test.benchmark_frame_count);
+
   blink::Threads::UI()->PostTask(
       [ engine = platform_view_->engine().GetWeakPtr(), test ] {
         if (engine)
@@ -22,6 +22,8 @@ class TestRunner {
   struct TestDescriptor {
     std::string path;
     std::string packages;
+    // When positive, the test is run as a benchmark of that many frames.
+    size_t benchmark_frame_count = 0;
   };
 
   void Run(const TestDescriptor& test);
@@ -30,6 +32,8 @@ class TestRunner {
   TestRunner();
   ~TestRunner();
 
+  void CreatePlatformView(size_t benchmark_frame_count);
+
   std::unique_ptr<PlatformView> platform_view_;
 
   FTL_DISALLOW_COPY_AND_ASSIGN(TestRunner);
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/testing/testing.h"
 
+#include <sstream>
+
 #include "base/command_line.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/testing/test_runner.h"
@@ -15,6 +17,14 @@ bool InitForTesting() {
 
   TestRunner::TestDescriptor test;
   test.packages = command_line.GetSwitchValueASCII(switches::kPackages);
+  if (command_line.HasSwitch(switches::kBenchmarkFrames)) {
+    std::stringstream stream(
+        command_line.GetSwitchValueASCII(switches::kBenchmarkFrames));
+    size_t frame_count = 0;
+    if (!(stream >> frame_count) || frame_count == 0)
+      return false;
+    test.benchmark_frame_count = frame_count;
+  }
   auto args = command_line.GetArgs();
   if (args.empty())
     return false;
@@ -0,0 +1,85 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/testing/vsync_waiter_virtual.h"
+
+#include <utility>
+
+#include "lib/ftl/logging.h"
+
+namespace shell {
+
+VsyncWaiterVirtual::VsyncWaiterVirtual(const blink::Threads& threads,
+                                       size_t frame_count,
+                                       DoneCallback done_callback)
+    : threads_(threads),
+      frame_count_(frame_count),
+      done_callback_(std::move(done_callback)),
+      frame_in_flight_(false),
+      weak_factory_(this) {
+  build_times_.reserve(frame_count_);
+}
+
+VsyncWaiterVirtual::~VsyncWaiterVirtual() = default;
+
+void VsyncWaiterVirtual::AsyncWaitForVsync(Callback callback) {
+  FTL_DCHECK(!callback_);
+  callback_ = std::move(callback);
+
+  // Requests made while a frame is being rasterized wait for it to finish.
+  if (!frame_in_flight_)
+    ScheduleFrame();
+}
+
+bool VsyncWaiterVirtual::InjectsFrameTimes() const {
+  return true;
+}
+
+void VsyncWaiterVirtual::ScheduleFrame() {
+  // Once the run is over, frames are never begun again.
+  if (build_times_.size() == frame_count_)
+    return;
+
+  frame_in_flight_ = true;
+  threads_.ui()->PostTask([self = weak_factory_.GetWeakPtr()] {
+    if (self)
+      self->BeginFrame();
+  });
+}
+
+void VsyncWaiterVirtual::BeginFrame() {
+  constexpr ftl::TimeDelta interval = ftl::TimeDelta::FromSecondsF(1.0 / 60.0);
+  frame_time_ = frame_time_ + interval;
+
+  Callback callback = std::move(callback_);
+  callback_ = Callback();
+
+  ftl::TimePoint start = ftl::TimePoint::Now();
+  callback(frame_time_);
+  build_times_.push_back(ftl::TimePoint::Now() - start);
+
+  // The frame, if one was rendered, has been posted to the GPU thread. Once
+  // the GPU thread gets past it, the next frame can begin.
+  threads_.gpu()->PostTask(
+      [ self = weak_factory_.GetWeakPtr(), ui = threads_.ui() ] {
+        ui->PostTask([self] {
+          if (self)
+            self->FinishFrame();
+        });
+      });
+}
+
+void VsyncWaiterVirtual::FinishFrame() {
+  frame_in_flight_ = false;
+
+  if (build_times_.size() == frame_count_) {
+    done_callback_(build_times_);
+    return;
+  }
+
+  if (callback_)
+    ScheduleFrame();
+}
+
+}  // namespace shell
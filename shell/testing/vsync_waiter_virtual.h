@@ -0,0 +1,61 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_TESTING_VSYNC_WAITER_VIRTUAL_H_
+#define SHELL_TESTING_VSYNC_WAITER_VIRTUAL_H_
+
+#include <functional>
+#include <vector>
+
+#include "flutter/common/threads.h"
+#include "flutter/shell/common/vsync_waiter.h"
+#include "lib/ftl/macros.h"
+#include "lib/ftl/memory/weak_ptr.h"
+#include "lib/ftl/time/time_delta.h"
+#include "lib/ftl/time/time_point.h"
+
+namespace shell {
+
+// Drives frames off a virtual clock that advances by one 60Hz interval per
+// frame, so that animations see the same frame times on every run. A frame
+// begins as soon as the previous one has been rasterized instead of at the
+// next display refresh, which keeps the UI and GPU threads from overlapping
+// and the cost of each frame measurable. Used on the UI thread.
+class VsyncWaiterVirtual : public VsyncWaiter {
+ public:
+  // Called once |frame_count| frames have been built and rasterized, with how
+  // long the UI thread spent beginning each frame.
+  using DoneCallback =
+      std::function<void(const std::vector<ftl::TimeDelta>& build_times)>;
+
+  VsyncWaiterVirtual(const blink::Threads& threads,
+                     size_t frame_count,
+                     DoneCallback done_callback);
+  ~VsyncWaiterVirtual() override;
+
+  void AsyncWaitForVsync(Callback callback) override;
+
+  bool InjectsFrameTimes() const override;
+
+ private:
+  void ScheduleFrame();
+  void BeginFrame();
+  void FinishFrame();
+
+  const blink::Threads& threads_;
+  const size_t frame_count_;
+  DoneCallback done_callback_;
+  ftl::TimePoint frame_time_;
+  Callback callback_;
+  bool frame_in_flight_;
+  std::vector<ftl::TimeDelta> build_times_;
+
+  ftl::WeakPtrFactory<VsyncWaiterVirtual> weak_factory_;
+
+  FTL_DISALLOW_COPY_AND_ASSIGN(VsyncWaiterVirtual);
+};
+
+}  // namespace shell
+
+#endif  // SHELL_TESTING_VSYNC_WAITER_VIRTUAL_H_
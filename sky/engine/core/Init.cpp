@@ -30,6 +30,7 @@
 
 #include "flutter/sky/engine/core/Init.h"
 
+#include "flutter/sky/engine/core/rendering/RenderArena.h"
 #include "flutter/sky/engine/platform/Partitions.h"
 #include "flutter/sky/engine/wtf/text/StringImpl.h"
 #include "flutter/sky/engine/wtf/text/StringStatics.h"
@@ -46,6 +47,7 @@ void CoreInitializer::init()
     WTF::StringStatics::init();
 
     Partitions::init();
+    RenderArena::init();
 
     StringImpl::freezeStaticStrings();
 }
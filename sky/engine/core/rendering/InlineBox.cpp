@@ -21,10 +21,10 @@
 
 #include "flutter/sky/engine/core/rendering/InlineFlowBox.h"
 #include "flutter/sky/engine/core/rendering/PaintInfo.h"
+#include "flutter/sky/engine/core/rendering/RenderArena.h"
 #include "flutter/sky/engine/core/rendering/RenderParagraph.h"
 #include "flutter/sky/engine/core/rendering/RenderObjectInlines.h"
 #include "flutter/sky/engine/core/rendering/RootInlineBox.h"
-#include "flutter/sky/engine/platform/Partitions.h"
 #include "flutter/sky/engine/platform/fonts/FontMetrics.h"
 
 #ifndef NDEBUG
@@ -64,12 +64,12 @@ void InlineBox::remove(MarkLineBoxes markLineBoxes)
 
 void* InlineBox::operator new(size_t sz)
 {
-    return partitionAlloc(Partitions::getRenderingPartition(), sz);
+    return RenderArena::allocate(sz);
 }
 
-void InlineBox::operator delete(void* ptr)
+void InlineBox::operator delete(void* ptr, size_t sz)
 {
-    partitionFree(ptr);
+    RenderArena::free(ptr, sz);
 }
 
 #ifndef NDEBUG
@@ -95,7 +95,7 @@ public:
 
     // InlineBoxes are allocated out of the rendering partition.
     void* operator new(size_t);
-    void operator delete(void*);
+    void operator delete(void*, size_t);
 
 #ifndef NDEBUG
     void showTreeForThis() const;
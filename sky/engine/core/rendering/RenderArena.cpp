@@ -0,0 +1,216 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/sky/engine/core/rendering/RenderArena.h"
+
+#include "flutter/sky/engine/platform/Partitions.h"
+#include "flutter/sky/engine/wtf/PageAllocator.h"
+#include "flutter/sky/engine/wtf/RefPtr.h"
+#include "flutter/sky/engine/wtf/SpinLock.h"
+#include "flutter/sky/engine/wtf/ThreadSpecific.h"
+
+namespace blink {
+
+// Chunks are aligned to their size so the owning chunk of any slot can be
+// found by masking its address.
+static const size_t cChunkSize = 16 * 1024;
+static const uintptr_t cChunkBaseMask = ~static_cast<uintptr_t>(cChunkSize - 1);
+
+// How many chunks no arena is using are kept for reuse, 1MB worth.
+static const size_t cMaxFreeChunks = 64;
+
+COMPILE_ASSERT(!(cChunkSize & WTF::kPageAllocationGranularityOffsetMask), RenderArena_chunks_must_be_whole_allocation_units);
+
+// The first slot-sized block of each chunk points back at its arena, or at
+// the next free chunk while no arena is using it.
+union RenderArenaChunkHeader {
+    RenderArena* arena;
+    RenderArenaChunkHeader* nextFree;
+};
+
+static int s_freeChunksLock = 0;
+static RenderArenaChunkHeader* s_freeChunks = 0;
+static size_t s_freeChunkCount = 0;
+
+static char* takeChunk()
+{
+    spinLockLock(&s_freeChunksLock);
+    RenderArenaChunkHeader* chunk = s_freeChunks;
+    if (chunk) {
+        s_freeChunks = chunk->nextFree;
+        --s_freeChunkCount;
+    }
+    spinLockUnlock(&s_freeChunksLock);
+
+    if (chunk)
+        return reinterpret_cast<char*>(chunk);
+    return static_cast<char*>(WTF::allocPages(0, cChunkSize, cChunkSize));
+}
+
+static void releaseChunk(void* ptr)
+{
+    RenderArenaChunkHeader* chunk = static_cast<RenderArenaChunkHeader*>(ptr);
+    spinLockLock(&s_freeChunksLock);
+    bool keep = s_freeChunkCount < cMaxFreeChunks;
+    if (keep) {
+        chunk->nextFree = s_freeChunks;
+        s_freeChunks = chunk;
+        ++s_freeChunkCount;
+    }
+    spinLockUnlock(&s_freeChunksLock);
+
+    if (!keep)
+        WTF::freePages(ptr, cChunkSize);
+}
+
+void RenderArena::purgeFreeChunks()
+{
+    spinLockLock(&s_freeChunksLock);
+    RenderArenaChunkHeader* chunk = s_freeChunks;
+    s_freeChunks = 0;
+    s_freeChunkCount = 0;
+    spinLockUnlock(&s_freeChunksLock);
+
+    while (chunk) {
+        RenderArenaChunkHeader* next = chunk->nextFree;
+        WTF::freePages(chunk, cChunkSize);
+        chunk = next;
+    }
+}
+
+namespace {
+
+struct RenderArenaThreadState {
+    RenderArena* current;
+    // Serves allocations on this thread while no arena is in scope.
+    RefPtr<RenderArena> fallback;
+};
+
+} // namespace
+
+static WTF::ThreadSpecific<RenderArenaThreadState>* s_threadState = 0;
+
+static RenderArenaThreadState& threadState()
+{
+    ASSERT(s_threadState);
+    return **s_threadState;
+}
+
+void RenderArena::init()
+{
+    if (!s_threadState)
+        s_threadState = new WTF::ThreadSpecific<RenderArenaThreadState>;
+}
+
+RenderArena* RenderArena::current()
+{
+    return threadState().current;
+}
+
+RenderArena* RenderArena::setCurrent(RenderArena* arena)
+{
+    RenderArenaThreadState& state = threadState();
+    RenderArena* previous = state.current;
+    state.current = arena;
+    return previous;
+}
+
+RenderArena::RenderArena()
+    : m_cursor(0)
+    , m_end(0)
+    , m_liveAllocations(0)
+{
+#if ENABLE(ASSERT)
+    m_thread = currentThread();
+#endif
+    memset(m_freeLists, 0, sizeof(m_freeLists));
+}
+
+RenderArena::~RenderArena()
+{
+    ASSERT(!m_liveAllocations);
+    ASSERT(m_thread == currentThread());
+    for (size_t i = 0; i < m_chunks.size(); ++i)
+        releaseChunk(m_chunks[i]);
+}
+
+void* RenderArena::allocate(size_t size)
+{
+    size_t slotSize = slotSizeFor(size);
+    if (!slotSize || slotSize > cMaxSlotSize)
+        return partitionAlloc(Partitions::getRenderingPartition(), size);
+
+    RenderArenaThreadState& state = threadState();
+    RenderArena* arena = state.current;
+    if (!arena) {
+        if (!state.fallback)
+            state.fallback = create();
+        arena = state.fallback.get();
+    }
+    return arena->allocateSlot(slotSize);
+}
+
+void RenderArena::free(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+    size_t slotSize = slotSizeFor(size);
+    if (!slotSize || slotSize > cMaxSlotSize) {
+        partitionFree(ptr);
+        return;
+    }
+
+    // Every slot-sized allocation came from some arena's chunk.
+    uintptr_t chunk = reinterpret_cast<uintptr_t>(ptr) & cChunkBaseMask;
+    reinterpret_cast<RenderArenaChunkHeader*>(chunk)->arena->freeSlot(ptr, slotSize);
+}
+
+void* RenderArena::allocateSlot(size_t slotSize)
+{
+    ASSERT(m_thread == currentThread());
+    void* result;
+    FreeSlot*& freeList = m_freeLists[slotSize / cSlotGranularity - 1];
+    if (freeList) {
+        result = freeList;
+        freeList = freeList->next;
+    } else {
+        if (static_cast<size_t>(m_end - m_cursor) < slotSize)
+            addChunk();
+        result = m_cursor;
+        m_cursor += slotSize;
+    }
+
+    // Live slots keep the arena alive, even past its last external owner.
+    if (!m_liveAllocations++)
+        ref();
+    return result;
+}
+
+void RenderArena::freeSlot(void* ptr, size_t slotSize)
+{
+    ASSERT(slotSize && slotSize <= cMaxSlotSize);
+    ASSERT(m_liveAllocations);
+    ASSERT(m_thread == currentThread());
+    FreeSlot* slot = static_cast<FreeSlot*>(ptr);
+    FreeSlot*& freeList = m_freeLists[slotSize / cSlotGranularity - 1];
+    slot->next = freeList;
+    freeList = slot;
+
+    if (!--m_liveAllocations)
+        deref();
+}
+
+void RenderArena::addChunk()
+{
+    // Whatever is left of the current chunk is too small for this slot size
+    // and is simply abandoned; it is reclaimed with the rest of the arena.
+    char* chunk = takeChunk();
+    RELEASE_ASSERT(chunk);
+    reinterpret_cast<RenderArenaChunkHeader*>(chunk)->arena = this;
+    m_chunks.append(chunk);
+    m_cursor = chunk + cSlotGranularity;
+    m_end = chunk + cChunkSize;
+}
+
+} // namespace blink
@@ -0,0 +1,113 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_CORE_RENDERING_RENDERARENA_H_
+#define SKY_ENGINE_CORE_RENDERING_RENDERARENA_H_
+
+#include "flutter/sky/engine/wtf/Noncopyable.h"
+#include "flutter/sky/engine/wtf/PassRefPtr.h"
+#include "flutter/sky/engine/wtf/RefCounted.h"
+#include "flutter/sky/engine/wtf/Threading.h"
+#include "flutter/sky/engine/wtf/Vector.h"
+
+namespace blink {
+
+// Backing store for the render objects, inline boxes, layers and styles of a
+// single render tree (in practice, one Paragraph).
+//
+// Objects are carved out of a few chunks by bumping a cursor, so a tree built
+// or laid out in one go ends up close together in memory. Freed slots are kept
+// on per-size free lists for reuse by later relayouts. When the arena dies its
+// chunks go back on a process-wide free list for the next arena, so building
+// a paragraph rarely has to map pages. Chunks are aligned to their size, which
+// finds the arena owning a slot by masking its address.
+//
+// Allocation goes to whichever arena is current on the calling thread (see
+// RenderArena::Scope). With no arena in scope, small objects come from a
+// long-lived arena private to the thread, and objects too large for a slot
+// come from the rendering partition. An arena may only be used on the thread
+// that created it. It stays alive for as long as any of its slots are in use,
+// so a style that outlives its tree is still safe to release.
+class RenderArena : public RefCounted<RenderArena> {
+    WTF_MAKE_NONCOPYABLE(RenderArena);
+public:
+    static PassRefPtr<RenderArena> create() { return adoptRef(new RenderArena); }
+    ~RenderArena();
+
+    // Must be called once before any thread allocates from an arena.
+    static void init();
+
+    // Returns the chunks no arena is using to the system, e.g. under memory
+    // pressure.
+    static void purgeFreeChunks();
+
+    // |size| must be the same value in both calls. Classes routing through the
+    // arena use the sized form of operator delete to guarantee that.
+    static void* allocate(size_t);
+    static void free(void*, size_t);
+
+    static RenderArena* current();
+
+    size_t liveAllocationCount() const { return m_liveAllocations; }
+    size_t chunkCount() const { return m_chunks.size(); }
+
+    // Makes |arena| the target of render tree allocations on this thread for
+    // its lifetime. Passing null routes allocations back to the thread's own
+    // long-lived arena.
+    class Scope {
+        WTF_MAKE_NONCOPYABLE(Scope);
+    public:
+        explicit Scope(RenderArena* arena)
+            : m_previous(setCurrent(arena))
+        {
+        }
+        ~Scope() { setCurrent(m_previous); }
+
+    private:
+        RenderArena* m_previous;
+    };
+
+private:
+    static const size_t cSlotGranularity = 16;
+    static const size_t cMaxSlotSize = 1024;
+    static const size_t cSizeClassCount = cMaxSlotSize / cSlotGranularity;
+
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    RenderArena();
+
+    static RenderArena* setCurrent(RenderArena*);
+    static size_t slotSizeFor(size_t size) { return (size + cSlotGranularity - 1) & ~(cSlotGranularity - 1); }
+
+    void* allocateSlot(size_t slotSize);
+    void freeSlot(void*, size_t slotSize);
+    void addChunk();
+
+#if ENABLE(ASSERT)
+    ThreadIdentifier m_thread;
+#endif
+    FreeSlot* m_freeLists[cSizeClassCount];
+    char* m_cursor;
+    char* m_end;
+    Vector<void*> m_chunks;
+    size_t m_liveAllocations;
+};
+
+} // namespace blink
+
+// Routes allocations of a class through RenderArena, like
+// WTF_MAKE_FAST_ALLOCATED does for fastMalloc. The class must not be
+// allocated in arrays, and must be deleted through its own type or a
+// virtual destructor so that operator delete sees the allocated size.
+#define MAKE_RENDER_ARENA_ALLOCATED \
+public: \
+    void* operator new(size_t, void* p) { return p; } \
+    void* operator new(size_t size) { return ::blink::RenderArena::allocate(size); } \
+    void operator delete(void* p, size_t size) { ::blink::RenderArena::free(p, size); } \
+private: \
+typedef int __thisIsHereToForceASemicolonAfterThisMacro
+
+#endif  // SKY_ENGINE_CORE_RENDERING_RENDERARENA_H_
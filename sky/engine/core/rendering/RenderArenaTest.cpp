@@ -0,0 +1,140 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tests for the RenderArena class.
+
+#include "flutter/sky/engine/core/rendering/RenderArena.h"
+
+#include "flutter/sky/engine/wtf/RefPtr.h"
+
+#include <gtest/gtest.h>
+
+namespace blink {
+
+namespace {
+
+class RenderArenaTest : public ::testing::Test {
+protected:
+    virtual void SetUp() override { RenderArena::init(); }
+};
+
+} // namespace
+
+TEST_F(RenderArenaTest, AllocatesFromCurrentArena)
+{
+    RefPtr<RenderArena> arena = RenderArena::create();
+    EXPECT_EQ(0u, arena->chunkCount());
+
+    RenderArena::Scope scope(arena.get());
+    EXPECT_EQ(arena.get(), RenderArena::current());
+
+    void* first = RenderArena::allocate(24);
+    void* second = RenderArena::allocate(24);
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(2u, arena->liveAllocationCount());
+    EXPECT_EQ(1u, arena->chunkCount());
+
+    // Bump allocation keeps consecutive objects together.
+    EXPECT_EQ(32, static_cast<char*>(second) - static_cast<char*>(first));
+
+    RenderArena::free(first, 24);
+    RenderArena::free(second, 24);
+    EXPECT_EQ(0u, arena->liveAllocationCount());
+}
+
+TEST_F(RenderArenaTest, ReusesReleasedSlots)
+{
+    RefPtr<RenderArena> arena = RenderArena::create();
+    RenderArena::Scope scope(arena.get());
+
+    void* slot = RenderArena::allocate(40);
+    RenderArena::free(slot, 40);
+
+    // Any size rounding to the same slot size gets the freed slot back.
+    void* reused = RenderArena::allocate(48);
+    EXPECT_EQ(slot, reused);
+
+    // Other slot sizes do not.
+    void* other = RenderArena::allocate(16);
+    EXPECT_NE(slot, other);
+
+    RenderArena::free(reused, 48);
+    RenderArena::free(other, 16);
+    EXPECT_EQ(0u, arena->liveAllocationCount());
+}
+
+TEST_F(RenderArenaTest, LiveSlotsKeepArenaAlive)
+{
+    RefPtr<RenderArena> arena = RenderArena::create();
+    RenderArena* rawArena = arena.get();
+    void* slot;
+    {
+        RenderArena::Scope scope(rawArena);
+        slot = RenderArena::allocate(64);
+    }
+    EXPECT_FALSE(rawArena->hasOneRef());
+
+    // Dropping the last external reference leaves the arena to its slot,
+    // which is freed through the arena found from its address.
+    arena.clear();
+    EXPECT_EQ(1u, rawArena->liveAllocationCount());
+    RenderArena::free(slot, 64);
+}
+
+TEST_F(RenderArenaTest, ScopesNest)
+{
+    RefPtr<RenderArena> outer = RenderArena::create();
+    RefPtr<RenderArena> inner = RenderArena::create();
+
+    EXPECT_FALSE(RenderArena::current());
+    {
+        RenderArena::Scope outerScope(outer.get());
+        {
+            RenderArena::Scope innerScope(inner.get());
+            EXPECT_EQ(inner.get(), RenderArena::current());
+        }
+        EXPECT_EQ(outer.get(), RenderArena::current());
+    }
+    EXPECT_FALSE(RenderArena::current());
+}
+
+TEST_F(RenderArenaTest, AllocatesWithoutCurrentArena)
+{
+    EXPECT_FALSE(RenderArena::current());
+
+    // Small objects come from the thread's own arena, large ones from the
+    // rendering partition.
+    void* small = RenderArena::allocate(32);
+    void* large = RenderArena::allocate(4096);
+    ASSERT_TRUE(small);
+    ASSERT_TRUE(large);
+    RenderArena::free(small, 32);
+    RenderArena::free(large, 4096);
+}
+
+TEST_F(RenderArenaTest, RecyclesChunksOfDeadArenas)
+{
+    void* firstChunkSlot;
+    {
+        RefPtr<RenderArena> arena = RenderArena::create();
+        RenderArena::Scope scope(arena.get());
+        firstChunkSlot = RenderArena::allocate(16);
+        RenderArena::free(firstChunkSlot, 16);
+    }
+
+    // The next arena takes over the chunk the dead one released.
+    RefPtr<RenderArena> arena = RenderArena::create();
+    RenderArena::Scope scope(arena.get());
+    void* slot = RenderArena::allocate(16);
+    EXPECT_EQ(firstChunkSlot, slot);
+    RenderArena::free(slot, 16);
+
+    // Purging only drops chunks no arena is using.
+    RenderArena::purgeFreeChunks();
+    EXPECT_EQ(1u, arena->chunkCount());
+}
+
+} // namespace blink
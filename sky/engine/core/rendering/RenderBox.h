@@ -42,7 +42,7 @@ enum ShouldComputePreferred { ComputeActual, ComputePreferred };
 enum ContentsClipBehavior { ForceContentsClip, SkipContentsClipIfPossible };
 
 struct RenderBoxRareData {
-    WTF_MAKE_NONCOPYABLE(RenderBoxRareData); WTF_MAKE_FAST_ALLOCATED;
+    WTF_MAKE_NONCOPYABLE(RenderBoxRareData); MAKE_RENDER_ARENA_ALLOCATED;
 public:
     RenderBoxRareData()
         : m_inlineBoxWrapper(0)
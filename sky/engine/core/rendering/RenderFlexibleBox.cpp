@@ -501,13 +501,22 @@ LayoutUnit RenderFlexibleBox::preferredMainAxisContentExtentForChild(RenderBox*
     if (preferredMainAxisExtentDependsOnLayout(flexBasis, hasInfiniteLineLength)) {
         LayoutUnit mainAxisExtent;
         if (hasOrthogonalFlow(child)) {
-            if (child->needsLayout() || relayoutChildren) {
+            // The intrinsic size only depends on the child and the cross axis
+            // space it was measured against, so a clean child measured against
+            // the same space does not need the extra layout even when the
+            // container is relaying out all of its children.
+            LayoutUnit crossAxisConstraint = crossAxisContentExtent();
+            IntrinsicSizeMap::iterator it = m_intrinsicSizeAlongMainAxis.find(child);
+            bool hasValidIntrinsicSize = it != m_intrinsicSizeAlongMainAxis.end()
+                && !child->needsLayout()
+                && (!relayoutChildren || it->value.crossAxisConstraint == crossAxisConstraint);
+            if (!hasValidIntrinsicSize) {
                 m_intrinsicSizeAlongMainAxis.remove(child);
                 child->forceChildLayout();
-                m_intrinsicSizeAlongMainAxis.set(child, child->logicalHeight());
+                m_intrinsicSizeAlongMainAxis.set(child, IntrinsicSize(child->logicalHeight(), crossAxisConstraint));
             }
             ASSERT(m_intrinsicSizeAlongMainAxis.contains(child));
-            mainAxisExtent = m_intrinsicSizeAlongMainAxis.get(child);
+            mainAxisExtent = m_intrinsicSizeAlongMainAxis.get(child).mainAxisExtent;
         } else {
             mainAxisExtent = child->maxPreferredLogicalWidth();
         }
@@ -517,6 +526,37 @@ LayoutUnit RenderFlexibleBox::preferredMainAxisContentExtentForChild(RenderBox*
     return std::max(LayoutUnit(0), computeMainAxisExtentForChild(child, MainOrPreferredSize, flexBasis));
 }
 
+static bool hasPercentagePaddingOrMargin(const RenderStyle* style)
+{
+    return style->paddingTop().isPercent()
+        || style->paddingRight().isPercent()
+        || style->paddingBottom().isPercent()
+        || style->paddingLeft().isPercent()
+        || style->marginTop().isPercent()
+        || style->marginRight().isPercent()
+        || style->marginBottom().isPercent()
+        || style->marginLeft().isPercent();
+}
+
+bool RenderFlexibleBox::childLayoutDependsOnContainer(RenderBox* child) const
+{
+    if (child->needsLayout() || isColumnFlow() || child->needsPreferredWidthsRecalculation())
+        return true;
+
+    // In a row, a child whose flexed width changed has already been marked for
+    // layout, so a clean child keeps its width. Its contents can still depend
+    // on us: through stretching, percentages of our height, or percentage
+    // padding and margins, which resolve against our width.
+    if (alignmentForChild(child) == ItemPositionStretch)
+        return true;
+
+    RenderStyle* childStyle = child->style();
+    return childStyle->logicalHeight().isPercent()
+        || childStyle->logicalMinHeight().isPercent()
+        || childStyle->logicalMaxHeight().isPercent()
+        || hasPercentagePaddingOrMargin(childStyle);
+}
+
 void RenderFlexibleBox::layoutFlexItems(bool relayoutChildren)
 {
     Vector<LineContext> lineContexts;
@@ -953,7 +993,8 @@ void RenderFlexibleBox::layoutAndPlaceChildren(LayoutUnit& crossAxisOffset, cons
             resetAutoMarginsAndLogicalTopInCrossAxis(child);
         }
         // We may have already forced relayout for orthogonal flowing children in preferredMainAxisContentExtentForChild.
-        bool forceChildRelayout = relayoutChildren && !childPreferredMainAxisContentExtentRequiresLayout(child, hasInfiniteLineLength);
+        bool forceChildRelayout = relayoutChildren && !childPreferredMainAxisContentExtentRequiresLayout(child, hasInfiniteLineLength)
+            && childLayoutDependsOnContainer(child);
         updateBlockChildDirtyBitsBeforeLayout(forceChildRelayout, child);
         child->layoutIfNeeded();
 
@@ -116,6 +116,7 @@ private:
     LayoutUnit preferredMainAxisContentExtentForChild(RenderBox* child, bool hasInfiniteLineLength, bool relayoutChildren = false);
     bool childPreferredMainAxisContentExtentRequiresLayout(RenderBox* child, bool hasInfiniteLineLength) const;
     bool needToStretchChildLogicalHeight(RenderBox* child) const;
+    bool childLayoutDependsOnContainer(RenderBox* child) const;
 
     void layoutFlexItems(bool relayoutChildren);
     LayoutUnit autoMarginOffsetInMainAxis(const OrderedFlexItemList&, LayoutUnit& availableFreeSpace);
@@ -150,8 +151,21 @@ private:
     void flipForRightToLeftColumn();
     void flipForWrapReverse(const Vector<LineContext>&, LayoutUnit crossAxisStartEdge);
 
+    struct IntrinsicSize {
+        IntrinsicSize() { }
+        IntrinsicSize(LayoutUnit mainAxisExtent, LayoutUnit crossAxisConstraint)
+            : mainAxisExtent(mainAxisExtent)
+            , crossAxisConstraint(crossAxisConstraint)
+        {
+        }
+
+        LayoutUnit mainAxisExtent;
+        LayoutUnit crossAxisConstraint; // The cross axis content extent the size was measured against.
+    };
+    typedef HashMap<const RenderObject*, IntrinsicSize> IntrinsicSizeMap;
+
     // This is used to cache the preferred size for orthogonal flow children so we don't have to relayout to get it
-    HashMap<const RenderObject*, LayoutUnit> m_intrinsicSizeAlongMainAxis;
+    IntrinsicSizeMap m_intrinsicSizeAlongMainAxis;
 
     mutable OrderIterator m_orderIterator;
     int m_numberOfInFlowChildrenOnFirstLine;
@@ -0,0 +1,77 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tests for the RenderFlexibleBox class.
+
+#include "flutter/sky/engine/core/rendering/RenderFlexibleBox.h"
+
+#include "flutter/sky/engine/core/rendering/RenderArena.h"
+#include "flutter/sky/engine/core/rendering/RenderParagraph.h"
+#include "flutter/sky/engine/core/rendering/RenderView.h"
+#include "flutter/sky/engine/core/rendering/style/RenderStyle.h"
+
+#include <gtest/gtest.h>
+
+namespace blink {
+
+namespace {
+
+PassRefPtr<RenderStyle> createChildStyle(const RenderStyle* parentStyle)
+{
+    RefPtr<RenderStyle> style = RenderStyle::create();
+    style->inheritFrom(parentStyle);
+    return style.release();
+}
+
+void layoutAtWidth(RenderView* renderView, int width)
+{
+    renderView->setFrameViewSize(IntSize(width, intMaxForLayoutUnit));
+    renderView->layout();
+}
+
+} // namespace
+
+TEST(RenderFlexibleBoxTest, PercentagePaddingFollowsContainerWidth)
+{
+    RenderArena::init();
+    RefPtr<RenderArena> arena = RenderArena::create();
+    RenderArena::Scope arenaScope(arena.get());
+
+    RefPtr<RenderStyle> viewStyle = RenderStyle::create();
+    viewStyle->setRTLOrdering(LogicalOrder);
+    viewStyle->setZIndex(0);
+    viewStyle->setUserModify(READ_ONLY);
+    RenderView* renderView = new RenderView();
+    renderView->setStyle(viewStyle.release());
+
+    // The view is a column, so the row below is as wide as the view.
+    RefPtr<RenderStyle> rowStyle = createChildStyle(renderView->style());
+    rowStyle->setFlexDirection(FlowRow);
+    RenderFlexibleBox* row = new RenderFlexibleBox();
+    row->setStyle(rowStyle.release());
+    renderView->addChild(row);
+
+    // Neither stretched nor sized in percentages of the row's height, so only
+    // the percentage padding, which resolves against the row's width, ties the
+    // child's layout to the row.
+    RefPtr<RenderStyle> childStyle = createChildStyle(row->style());
+    childStyle->setWidth(Length(50, Fixed));
+    childStyle->setPaddingTop(Length(10, Percent));
+    childStyle->setAlignSelf(ItemPositionFlexStart);
+    RenderParagraph* child = new RenderParagraph();
+    child->setStyle(childStyle.release());
+    row->addChild(child);
+
+    layoutAtWidth(renderView, 200);
+    EXPECT_EQ(LayoutUnit(200), row->width());
+    EXPECT_EQ(LayoutUnit(20), child->height());
+
+    layoutAtWidth(renderView, 400);
+    EXPECT_EQ(LayoutUnit(400), row->width());
+    EXPECT_EQ(LayoutUnit(40), child->height());
+
+    renderView->destroy();
+}
+
+} // namespace blink
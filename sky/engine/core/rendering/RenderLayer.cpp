@@ -46,12 +46,12 @@
 #include "flutter/sky/engine/core/rendering/HitTestRequest.h"
 #include "flutter/sky/engine/core/rendering/HitTestResult.h"
 #include "flutter/sky/engine/core/rendering/HitTestingTransformState.h"
+#include "flutter/sky/engine/core/rendering/RenderArena.h"
 #include "flutter/sky/engine/core/rendering/RenderGeometryMap.h"
 #include "flutter/sky/engine/core/rendering/RenderInline.h"
 #include "flutter/sky/engine/core/rendering/RenderTreeAsText.h"
 #include "flutter/sky/engine/core/rendering/RenderView.h"
 #include "flutter/sky/engine/platform/LengthFunctions.h"
-#include "flutter/sky/engine/platform/Partitions.h"
 #include "flutter/sky/engine/platform/geometry/FloatPoint3D.h"
 #include "flutter/sky/engine/platform/geometry/FloatRect.h"
 #include "flutter/sky/engine/platform/geometry/TransformState.h"
@@ -194,12 +194,12 @@ const RenderLayer* RenderLayer::compositingContainer() const
 
 void* RenderLayer::operator new(size_t sz)
 {
-    return partitionAlloc(Partitions::getRenderingPartition(), sz);
+    return RenderArena::allocate(sz);
 }
 
-void RenderLayer::operator delete(void* ptr)
+void RenderLayer::operator delete(void* ptr, size_t sz)
 {
-    partitionFree(ptr);
+    RenderArena::free(ptr, sz);
 }
 
 void RenderLayer::addChild(RenderLayer* child, RenderLayer* beforeChild)
@@ -125,7 +125,7 @@ public:
 
     void* operator new(size_t);
     // Only safe to call from RenderBox::destroyLayer()
-    void operator delete(void*);
+    void operator delete(void*, size_t);
 
     RenderLayerClipper& clipper() { return m_clipper; }
     const RenderLayerClipper& clipper() const { return m_clipper; }
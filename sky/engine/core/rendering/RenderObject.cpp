@@ -28,6 +28,7 @@
 
 #include <algorithm>
 #include "flutter/sky/engine/core/rendering/HitTestResult.h"
+#include "flutter/sky/engine/core/rendering/RenderArena.h"
 #include "flutter/sky/engine/core/rendering/RenderFlexibleBox.h"
 #include "flutter/sky/engine/core/rendering/RenderGeometryMap.h"
 #include "flutter/sky/engine/core/rendering/RenderInline.h"
@@ -38,7 +39,6 @@
 #include "flutter/sky/engine/core/rendering/RenderTheme.h"
 #include "flutter/sky/engine/core/rendering/RenderView.h"
 #include "flutter/sky/engine/core/rendering/style/ShadowList.h"
-#include "flutter/sky/engine/platform/Partitions.h"
 #include "flutter/sky/engine/platform/geometry/TransformState.h"
 #include "flutter/sky/engine/platform/graphics/GraphicsContext.h"
 #include "flutter/sky/engine/wtf/RefCountedLeakCounter.h"
@@ -84,14 +84,12 @@ bool RenderObject::s_affectsParentBlock = false;
 #if !ENABLE(OILPAN)
 void* RenderObject::operator new(size_t sz)
 {
-    ASSERT(isMainThread());
-    return partitionAlloc(Partitions::getRenderingPartition(), sz);
+    return RenderArena::allocate(sz);
 }
 
-void RenderObject::operator delete(void* ptr)
+void RenderObject::operator delete(void* ptr, size_t sz)
 {
-    ASSERT(isMainThread());
-    partitionFree(ptr);
+    RenderArena::free(ptr, sz);
 }
 #endif
 
@@ -232,9 +232,10 @@ public:
     static unsigned instanceCount() { return s_instanceCount; }
 
 #if !ENABLE(OILPAN)
-    // RenderObjects are allocated out of the rendering partition.
+    // RenderObjects are allocated out of the current RenderArena, or the
+    // rendering partition if there is none.
     void* operator new(size_t);
-    void operator delete(void*);
+    void operator delete(void*, size_t);
 #endif
 
 public:
@@ -21,6 +21,7 @@
 #ifndef SKY_ENGINE_CORE_RENDERING_RENDEROVERFLOW_H_
 #define SKY_ENGINE_CORE_RENDERING_RENDEROVERFLOW_H_
 
+#include "flutter/sky/engine/core/rendering/RenderArena.h"
 #include "flutter/sky/engine/platform/geometry/LayoutRect.h"
 
 namespace blink
@@ -38,7 +39,7 @@ namespace blink
 
 // This object is allocated only when some of these fields have non-default values in the owning box.
 class RenderOverflow {
-    WTF_MAKE_NONCOPYABLE(RenderOverflow); WTF_MAKE_FAST_ALLOCATED;
+    WTF_MAKE_NONCOPYABLE(RenderOverflow); MAKE_RENDER_ARENA_ALLOCATED;
 public:
     RenderOverflow(const LayoutRect& layoutRect, const LayoutRect& visualRect)
         : m_layoutOverflow(layoutRect)
@@ -57,6 +57,9 @@ PassRefPtr<RenderStyle> RenderStyle::create()
 
 PassRefPtr<RenderStyle> RenderStyle::createDefaultStyle()
 {
+    // The default style is shared by every tree; keep it out of whichever
+    // arena happens to be current so it does not pin that arena forever.
+    RenderArena::Scope noArena(0);
     return adoptRef(new RenderStyle(DefaultStyle));
 }
 
@@ -25,6 +25,7 @@
 #ifndef SKY_ENGINE_CORE_RENDERING_STYLE_RENDERSTYLE_H_
 #define SKY_ENGINE_CORE_RENDERING_STYLE_RENDERSTYLE_H_
 
+#include "flutter/sky/engine/core/rendering/RenderArena.h"
 #include "flutter/sky/engine/core/rendering/style/BorderValue.h"
 #include "flutter/sky/engine/core/rendering/style/CounterDirectives.h"
 #include "flutter/sky/engine/core/rendering/style/DataRef.h"
@@ -90,6 +91,7 @@ class StyleResolver;
 class TransformationMatrix;
 
 class RenderStyle: public RefCounted<RenderStyle> {
+    MAKE_RENDER_ARENA_ALLOCATED;
     friend class EditingStyle; // Editing has to only reveal unvisited info.
     friend class CSSComputedStyleDeclaration; // Ignores visited styles, so needs to be able to see unvisited info.
     friend class StyleBuilderFunctions; // Sets color styles
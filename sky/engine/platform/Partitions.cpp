@@ -30,6 +30,9 @@
 
 #include "flutter/sky/engine/platform/Partitions.h"
 
+#include "flutter/sky/engine/wtf/MainThread.h"
+#include "flutter/sky/engine/wtf/WTF.h"
+
 namespace blink {
 
 SizeSpecificPartitionAllocator<3072> Partitions::m_objectModelAllocator;
@@ -50,4 +53,20 @@ void Partitions::shutdown()
     (void) m_objectModelAllocator.shutdown();
 }
 
+void Partitions::dumpMemoryStats(PartitionStatsDumper* dumper)
+{
+    ASSERT(isMainThread());
+    partitionDumpStats(m_objectModelAllocator.root(), "object_model", dumper);
+    partitionDumpStats(m_renderingAllocator.root(), "rendering", dumper);
+    partitionDumpStatsGeneric(WTF::Partitions::getBufferPartition(), "buffer", dumper);
+}
+
+void Partitions::decommitFreeableMemory()
+{
+    ASSERT(isMainThread());
+    partitionPurgeMemory(m_objectModelAllocator.root());
+    partitionPurgeMemory(m_renderingAllocator.root());
+    partitionPurgeMemoryGeneric(WTF::Partitions::getBufferPartition());
+}
+
 } // namespace blink
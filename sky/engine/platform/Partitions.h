@@ -49,6 +49,14 @@ public:
         return m_objectModelAllocator.root()->totalSizeOfCommittedPages;
     }
 
+    // Reports every partition the engine allocates from, including WTF's
+    // buffer partition. Must be called on the main thread.
+    static void dumpMemoryStats(PartitionStatsDumper*);
+
+    // Returns the empty slot spans of every partition to the system, for
+    // when memory is scarce. Must be called on the main thread.
+    static void decommitFreeableMemory();
+
 private:
     static SizeSpecificPartitionAllocator<3072> m_objectModelAllocator;
     static SizeSpecificPartitionAllocator<1024> m_renderingAllocator;
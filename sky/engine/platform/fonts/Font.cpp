@@ -31,6 +31,7 @@
 #include "flutter/sky/engine/platform/fonts/GlyphBuffer.h"
 #include "flutter/sky/engine/platform/fonts/GlyphPageTreeNode.h"
 #include "flutter/sky/engine/platform/fonts/SimpleFontData.h"
+#include "flutter/sky/engine/platform/fonts/TextBlobCache.h"
 #include "flutter/sky/engine/platform/fonts/WidthIterator.h"
 #include "flutter/sky/engine/platform/fonts/harfbuzz/HarfBuzzShaper.h"
 #include "flutter/sky/engine/platform/geometry/FloatRect.h"
@@ -90,6 +91,16 @@ bool Font::operator==(const Font& other) const
         && (m_fontFallbackList ? m_fontFallbackList->generation() : 0) == (other.m_fontFallbackList ? other.m_fontFallbackList->generation() : 0);
 }
 
+unsigned Font::hash() const
+{
+    unsigned hash = m_fontDescription.family().family().isNull() ? 0 : m_fontDescription.family().family().impl()->hash();
+    hash = WTF::pairIntHash(hash, m_fontDescription.traits().bitfield());
+    hash = WTF::pairIntHash(hash, bitwise_cast<unsigned>(m_fontDescription.computedSize()));
+    hash = WTF::pairIntHash(hash, bitwise_cast<unsigned>(m_fontDescription.letterSpacing()));
+    hash = WTF::pairIntHash(hash, bitwise_cast<unsigned>(m_fontDescription.wordSpacing()));
+    return WTF::pairIntHash(hash, PtrHash<FontSelector*>::hash(fontSelector()));
+}
+
 void Font::update(PassRefPtr<FontSelector> fontSelector) const
 {
     // FIXME: It is pretty crazy that we are willing to just poke into a RefPtr, but it ends up
@@ -147,6 +158,21 @@ void Font::drawText(GraphicsContext* context, const TextRunPaintInfo& runInfo,
         return;
     }
 
+    FloatRect blobBounds = runInfo.bounds;
+    blobBounds.moveBy(-point);
+
+    // Blobs outlive the boxes that paint them, so text that is relaid out
+    // or rebuilt unchanged still records the blob from the previous frame.
+    bool isBlobCacheable = TextBlobCache::isCacheable(runInfo);
+    if (isBlobCacheable) {
+        if (TextBlobPtr cachedBlob = textBlobCache().find(*this, runInfo, blobBounds)) {
+            if (runInfo.cachedTextBlob)
+                *runInfo.cachedTextBlob = cachedBlob;
+            drawTextBlob(context, cachedBlob.get(), point.data());
+            return;
+        }
+    }
+
     {
         FontCachePurgePreventer preventer;
         GlyphBuffer glyphBuffer;
@@ -158,11 +184,11 @@ void Font::drawText(GraphicsContext* context, const TextRunPaintInfo& runInfo,
         // Enabling text-blobs forces the blob rendering path even for uncacheable blobs.
         TextBlobPtr uncacheableTextBlob;
         TextBlobPtr& textBlob = runInfo.cachedTextBlob ? *runInfo.cachedTextBlob : uncacheableTextBlob;
-        FloatRect blobBounds = runInfo.bounds;
-        blobBounds.moveBy(-point);
 
         textBlob = buildTextBlob(glyphBuffer, initialAdvance, blobBounds);
         if (textBlob) {
+            if (isBlobCacheable)
+                textBlobCache().add(*this, runInfo, blobBounds, textBlob);
             drawTextBlob(context, textBlob.get(), point.data());
             return;
         }
@@ -227,39 +253,39 @@ float Font::width(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFo
             glyphOverflow = 0;
     }
 
-    bool hasWordSpacingOrLetterSpacing = fontDescription().wordSpacing() || fontDescription().letterSpacing();
-    bool isCacheable = codePathToUse == ComplexPath
-        && !hasWordSpacingOrLetterSpacing // Word spacing and letter spacing can change the width of a word.
-        && !run.allowTabs(); // If we allow tabs and a tab occurs inside a word, the width of the word varies based on its position on the line.
-
-    WidthCacheEntry* cacheEntry = isCacheable
-        ? m_fontFallbackList->widthCache().add(run, WidthCacheEntry())
+    const WidthCacheEntry* cacheEntry = codePathToUse == ComplexPath && canCacheWidth(run)
+        ? m_fontFallbackList->widthCache().find(run)
         : 0;
-    if (cacheEntry && cacheEntry->isValid()) {
+    if (cacheEntry) {
         if (glyphOverflow)
             updateGlyphOverflowFromBounds(cacheEntry->glyphBounds, fontMetrics(), glyphOverflow);
         return cacheEntry->width;
     }
 
+    // On a miss, the complex path records its result in the width cache
+    // itself (see HarfBuzzShaper::shape).
     float result;
     IntRectExtent glyphBounds;
-    if (codePathToUse == ComplexPath) {
+    if (codePathToUse == ComplexPath)
         result = floatWidthForComplexText(run, fallbackFonts, &glyphBounds);
-    } else {
-        ASSERT(!isCacheable);
+    else
         result = floatWidthForSimpleText(run, fallbackFonts, glyphOverflow ? &glyphBounds : 0);
-    }
-
-    if (cacheEntry && (!fallbackFonts || fallbackFonts->isEmpty())) {
-        cacheEntry->glyphBounds = glyphBounds;
-        cacheEntry->width = result;
-    }
 
     if (glyphOverflow)
         updateGlyphOverflowFromBounds(glyphBounds, fontMetrics(), glyphOverflow);
     return result;
 }
 
+bool Font::canCacheWidth(const TextRun& run) const
+{
+    // Word spacing, letter spacing and justification can change the width of a word.
+    if (fontDescription().wordSpacing() || fontDescription().letterSpacing() || run.expansion())
+        return false;
+
+    // If we allow tabs and a tab occurs inside a word, the width of the word varies based on its position on the line.
+    return !run.allowTabs();
+}
+
 float Font::width(const TextRun& run, int& charsConsumed, Glyph& glyphId) const
 {
     charsConsumed = run.length();
@@ -95,6 +95,9 @@ public:
     bool operator==(const Font& other) const;
     bool operator!=(const Font& other) const { return !(*this == other); }
 
+    // A hash consistent with operator==, for caches keyed by font.
+    unsigned hash() const;
+
     const FontDescription& fontDescription() const { return m_fontDescription; }
 
     void update(PassRefPtr<FontSelector>) const;
@@ -107,6 +110,9 @@ public:
     float width(const TextRun&, HashSet<const SimpleFontData*>* fallbackFonts = 0, GlyphOverflow* = 0) const;
     float width(const TextRun&, int& charsConsumed, Glyph& glyphId) const;
 
+    // Whether the width of |run| can be shared through the WidthCache.
+    bool canCacheWidth(const TextRun&) const;
+
     int offsetForPosition(const TextRun&, float position, bool includePartialGlyphs) const;
     FloatRect selectionRectForText(const TextRun&, const FloatPoint&, int h, int from = 0, int to = -1, bool accountForGlyphBounds = false) const;
 
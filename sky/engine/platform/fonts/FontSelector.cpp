@@ -0,0 +1,18 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/sky/engine/platform/fonts/FontSelector.h"
+
+#include "flutter/sky/engine/wtf/Atomics.h"
+
+namespace blink {
+
+static int s_lastFontSelectorID = 0;
+
+FontSelector::FontSelector()
+    : m_uniqueID(atomicIncrement(&s_lastFontSelectorID))
+{
+}
+
+} // namespace blink
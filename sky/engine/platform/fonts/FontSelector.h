@@ -38,11 +38,19 @@ class FontDescription;
 
 class FontSelector : public FontCacheClient {
 public:
+    FontSelector();
     virtual ~FontSelector() { }
     virtual PassRefPtr<FontData> getFontData(const FontDescription&, const AtomicString& familyName) = 0;
     virtual void willUseFontData(const FontDescription&, const AtomicString& familyName, UChar32) = 0;
 
     virtual unsigned version() const = 0;
+
+    // Never handed out twice, unlike the selector's address, so caches can
+    // tell selectors apart without keeping them alive.
+    unsigned uniqueID() const { return m_uniqueID; }
+
+private:
+    const unsigned m_uniqueID;
 };
 
 } // namespace blink
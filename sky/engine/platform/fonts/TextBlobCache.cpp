@@ -0,0 +1,237 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/sky/engine/platform/fonts/TextBlobCache.h"
+
+#include <algorithm>
+#include "flutter/sky/engine/platform/fonts/FontFallbackList.h"
+#include "flutter/sky/engine/platform/fonts/FontSelector.h"
+#include "flutter/sky/engine/platform/fonts/SimpleFontData.h"
+#include "flutter/sky/engine/wtf/HashFunctions.h"
+#include "flutter/sky/engine/wtf/StdLibExtras.h"
+#include "flutter/sky/engine/wtf/StringHasher.h"
+
+namespace blink {
+
+namespace {
+
+// What a blob costs on top of its glyphs and positions.
+const size_t cTextBlobOverhead = 64;
+
+unsigned fontSelectorID(const Font& font)
+{
+    FontSelector* selector = font.fontSelector();
+    return selector ? selector->uniqueID() : 0;
+}
+
+struct TextBlobCacheLookup {
+    TextBlobCacheLookup(const Font& font, const TextRunPaintInfo& runInfo, const FloatRect& bounds)
+        : font(font)
+        , runInfo(runInfo)
+        , bounds(bounds)
+        , hash(TextBlobCacheKey::computeHash(font, runInfo, bounds))
+    {
+    }
+
+    const Font& font;
+    const TextRunPaintInfo& runInfo;
+    const FloatRect& bounds;
+    unsigned hash;
+};
+
+struct TextBlobCacheLookupTranslator {
+    static unsigned hash(const TextBlobCacheLookup& lookup) { return lookup.hash; }
+    static bool equal(const TextBlobCacheKey& key, const TextBlobCacheLookup& lookup)
+    {
+        return key.hash() == lookup.hash && key.matches(lookup.font, lookup.runInfo, lookup.bounds);
+    }
+};
+
+} // namespace
+
+TextBlobCacheKey::TextBlobCacheKey(const Font& font, const TextRunPaintInfo& runInfo, const FloatRect& bounds)
+    : m_fontDescription(font.fontDescription())
+    , m_primaryFontID(font.primaryFont()->platformData().uniqueID())
+    , m_fontSelectorID(fontSelectorID(font))
+    , m_fontSelectorVersion(font.fontList()->fontSelectorVersion())
+    , m_fontGeneration(font.fontList()->generation())
+    , m_hash(computeHash(font, runInfo, bounds))
+    , m_from(runInfo.from)
+    , m_to(runInfo.to)
+    , m_flags(flagsForRun(runInfo.run))
+    , m_xPos(runInfo.run.xPos())
+    , m_expansion(runInfo.run.expansion())
+    , m_glyphStretch(runInfo.run.horizontalGlyphStretch())
+    , m_tabSize(runInfo.run.tabSize())
+    , m_bounds(bounds)
+{
+    const TextRun& run = runInfo.run;
+    if (run.is8Bit())
+        m_text = String(run.characters8(), run.length());
+    else
+        m_text = String(run.characters16(), run.length());
+}
+
+unsigned TextBlobCacheKey::flagsForRun(const TextRun& run)
+{
+    return run.rtl()
+        | run.directionalOverride() << 1
+        | run.allowTabs() << 2
+        | run.spacingDisabled() << 3
+        | run.allowsLeadingExpansion() << 4
+        | run.allowsTrailingExpansion() << 5
+        | run.characterScanForCodePath() << 6;
+}
+
+unsigned TextBlobCacheKey::computeHash(const Font& font, const TextRunPaintInfo& runInfo, const FloatRect& bounds)
+{
+    const TextRun& run = runInfo.run;
+    unsigned hash = run.is8Bit()
+        ? StringHasher::computeHashAndMaskTop8Bits(run.characters8(), run.length())
+        : StringHasher::computeHashAndMaskTop8Bits(run.characters16(), run.length());
+    hash = WTF::pairIntHash(hash, font.hash());
+    hash = WTF::pairIntHash(hash, font.primaryFont()->platformData().uniqueID());
+    hash = WTF::pairIntHash(hash, WTF::pairIntHash(runInfo.from, runInfo.to));
+    hash = WTF::pairIntHash(hash, flagsForRun(run));
+    return WTF::pairIntHash(hash, bitwise_cast<unsigned>(bounds.width()));
+}
+
+bool TextBlobCacheKey::matches(const Font& font, const TextRunPaintInfo& runInfo, const FloatRect& bounds) const
+{
+    const TextRun& run = runInfo.run;
+    if (m_from != runInfo.from
+        || m_to != runInfo.to
+        || m_flags != flagsForRun(run)
+        || m_xPos != run.xPos()
+        || m_expansion != run.expansion()
+        || m_glyphStretch != run.horizontalGlyphStretch()
+        || m_tabSize != run.tabSize()
+        || m_bounds != bounds
+        || m_text.length() != static_cast<unsigned>(run.length()))
+        return false;
+
+    bool sameText = run.is8Bit()
+        ? WTF::equal(m_text.impl(), run.characters8(), run.length())
+        : WTF::equal(m_text.impl(), run.characters16(), run.length());
+    return sameText && matchesFont(font);
+}
+
+bool TextBlobCacheKey::matchesFont(const Font& font) const
+{
+    const FontFallbackList* fontList = font.fontList();
+    return m_primaryFontID == font.primaryFont()->platformData().uniqueID()
+        && m_fontSelectorID == fontSelectorID(font)
+        && m_fontSelectorVersion == fontList->fontSelectorVersion()
+        && m_fontGeneration == fontList->generation()
+        && m_fontDescription == font.fontDescription();
+}
+
+bool TextBlobCacheKey::operator==(const TextBlobCacheKey& other) const
+{
+    return m_hash == other.m_hash
+        && m_from == other.m_from
+        && m_to == other.m_to
+        && m_flags == other.m_flags
+        && m_xPos == other.m_xPos
+        && m_expansion == other.m_expansion
+        && m_glyphStretch == other.m_glyphStretch
+        && m_tabSize == other.m_tabSize
+        && m_bounds == other.m_bounds
+        && m_text == other.m_text
+        && m_primaryFontID == other.m_primaryFontID
+        && m_fontSelectorID == other.m_fontSelectorID
+        && m_fontSelectorVersion == other.m_fontSelectorVersion
+        && m_fontGeneration == other.m_fontGeneration
+        && m_fontDescription == other.m_fontDescription;
+}
+
+TextBlobCache::TextBlobCache(size_t byteBudget)
+    : m_useCounter(0)
+    , m_byteBudget(byteBudget)
+    , m_byteCount(0)
+{
+}
+
+TextBlobCache::~TextBlobCache()
+{
+}
+
+bool TextBlobCache::isCacheable(const TextRunPaintInfo& runInfo)
+{
+    // SVG-style rendering contexts supply glyphs the key cannot describe.
+    return runInfo.run.length() && !runInfo.run.renderingContext();
+}
+
+TextBlobPtr TextBlobCache::find(const Font& font, const TextRunPaintInfo& runInfo, const FloatRect& bounds)
+{
+    BlobMap::iterator it = m_blobs.find<TextBlobCacheLookupTranslator>(TextBlobCacheLookup(font, runInfo, bounds));
+    if (it == m_blobs.end())
+        return nullptr;
+    it->value.lastUse = ++m_useCounter;
+    return it->value.blob;
+}
+
+void TextBlobCache::add(const Font& font, const TextRunPaintInfo& runInfo, const FloatRect& bounds, const TextBlobPtr& blob)
+{
+    ASSERT(isCacheable(runInfo));
+    TextBlobCacheKey key(font, runInfo, bounds);
+    Entry entry;
+    entry.blob = blob;
+    entry.lastUse = ++m_useCounter;
+    // Glyphs roughly follow characters; each has an id and a position.
+    entry.byteCost = key.byteCost() + sizeof(Entry) + cTextBlobOverhead
+        + runInfo.run.length() * (sizeof(uint16_t) + 2 * sizeof(SkScalar));
+
+    BlobMap::AddResult result = m_blobs.add(key, entry);
+    if (!result.isNewEntry) {
+        m_byteCount -= result.storedValue->value.byteCost;
+        result.storedValue->value = entry;
+    }
+    m_byteCount += entry.byteCost;
+
+    if (m_byteCount > m_byteBudget)
+        evictLeastRecentlyUsed();
+}
+
+void TextBlobCache::clear()
+{
+    m_blobs.clear();
+    m_byteCount = 0;
+}
+
+void TextBlobCache::purge()
+{
+    // Clearing the map releases its table as well as the blobs.
+    clear();
+}
+
+void TextBlobCache::evictLeastRecentlyUsed()
+{
+    // Drop the older half in one pass, which keeps eviction amortized O(1)
+    // without maintaining an ordered list alongside the map.
+    Vector<unsigned> uses;
+    uses.reserveInitialCapacity(m_blobs.size());
+    for (BlobMap::const_iterator it = m_blobs.begin(); it != m_blobs.end(); ++it)
+        uses.append(it->value.lastUse);
+    unsigned* median = uses.begin() + uses.size() / 2;
+    std::nth_element(uses.begin(), median, uses.end());
+    unsigned threshold = *median;
+
+    Vector<TextBlobCacheKey> toRemove;
+    for (BlobMap::const_iterator it = m_blobs.begin(); it != m_blobs.end(); ++it) {
+        if (it->value.lastUse < threshold) {
+            toRemove.append(it->key);
+            m_byteCount -= it->value.byteCost;
+        }
+    }
+    m_blobs.removeAll(toRemove);
+}
+
+TextBlobCache& textBlobCache()
+{
+    DEFINE_STATIC_LOCAL(TextBlobCache, cache, ());
+    return cache;
+}
+
+} // namespace blink
@@ -0,0 +1,121 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_PLATFORM_FONTS_TEXTBLOBCACHE_H_
+#define SKY_ENGINE_PLATFORM_FONTS_TEXTBLOBCACHE_H_
+
+#include "flutter/sky/engine/platform/fonts/Font.h"
+#include "flutter/sky/engine/platform/fonts/FontDescription.h"
+#include "flutter/sky/engine/platform/fonts/FontPlatformData.h"
+#include "flutter/sky/engine/platform/fonts/TextBlob.h"
+#include "flutter/sky/engine/platform/geometry/FloatRect.h"
+#include "flutter/sky/engine/platform/text/TextRun.h"
+#include "flutter/sky/engine/wtf/HashMap.h"
+#include "flutter/sky/engine/wtf/Noncopyable.h"
+#include "flutter/sky/engine/wtf/text/WTFString.h"
+
+namespace blink {
+
+// Identifies the glyphs a TextRunPaintInfo produces with a given font,
+// independent of where they are drawn. The font is identified by its
+// description and the ids of its primary typeface and font selector, so keys
+// do not keep the font's fallback list or selector alive.
+class TextBlobCacheKey {
+public:
+    TextBlobCacheKey() : m_primaryFontID(0), m_fontSelectorID(0), m_fontSelectorVersion(0), m_fontGeneration(0), m_hash(0), m_from(0), m_to(0), m_flags(0), m_xPos(0), m_expansion(0), m_glyphStretch(0), m_tabSize(0) { }
+    TextBlobCacheKey(WTF::HashTableDeletedValueType) : m_text(WTF::HashTableDeletedValue), m_primaryFontID(0), m_fontSelectorID(0), m_fontSelectorVersion(0), m_fontGeneration(0), m_hash(0), m_from(0), m_to(0), m_flags(0), m_xPos(0), m_expansion(0), m_glyphStretch(0), m_tabSize(0) { }
+    TextBlobCacheKey(const Font&, const TextRunPaintInfo&, const FloatRect& bounds);
+
+    bool isHashTableDeletedValue() const { return m_text.isHashTableDeletedValue(); }
+    bool isHashTableEmptyValue() const { return m_text.isNull(); }
+
+    unsigned hash() const { return m_hash; }
+    bool matches(const Font&, const TextRunPaintInfo&, const FloatRect& bounds) const;
+    bool operator==(const TextBlobCacheKey&) const;
+
+    static unsigned computeHash(const Font&, const TextRunPaintInfo&, const FloatRect& bounds);
+
+    // Approximately the bytes held by the key.
+    size_t byteCost() const { return sizeof(TextBlobCacheKey) + m_text.length() * (m_text.is8Bit() ? 1 : 2); }
+
+private:
+    static unsigned flagsForRun(const TextRun&);
+    bool matchesFont(const Font&) const;
+
+    String m_text;
+    FontDescription m_fontDescription;
+    SkFontID m_primaryFontID;
+    unsigned m_fontSelectorID;
+    unsigned m_fontSelectorVersion;
+    unsigned m_fontGeneration;
+    unsigned m_hash;
+    int m_from;
+    int m_to;
+    unsigned m_flags;
+    float m_xPos;
+    float m_expansion;
+    float m_glyphStretch;
+    unsigned m_tabSize;
+    FloatRect m_bounds;
+};
+
+struct TextBlobCacheKeyHash {
+    static unsigned hash(const TextBlobCacheKey& key) { return key.hash(); }
+    static bool equal(const TextBlobCacheKey& a, const TextBlobCacheKey& b) { return a == b; }
+    static const bool safeToCompareToEmptyOrDeleted = true;
+};
+
+struct TextBlobCacheKeyTraits : WTF::SimpleClassHashTraits<TextBlobCacheKey> {
+    static const bool hasIsEmptyValueFunction = true;
+    static bool isEmptyValue(const TextBlobCacheKey& key) { return key.isHashTableEmptyValue(); }
+};
+
+// Keeps the SkTextBlobs built for painted text runs alive across frames, so
+// repainting unchanged text records a reference to an existing blob and
+// Skia's GPU text blob cache can recognize it. Blobs are positioned relative
+// to the text origin, so a moved run still hits. The cache is bounded by the
+// approximate bytes its keys and blobs hold.
+class TextBlobCache {
+    WTF_MAKE_NONCOPYABLE(TextBlobCache); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static const size_t defaultByteBudget = 1024 * 1024;
+
+    explicit TextBlobCache(size_t byteBudget = defaultByteBudget);
+    ~TextBlobCache();
+
+    // Returns the blob previously added for the same run, or null.
+    TextBlobPtr find(const Font&, const TextRunPaintInfo&, const FloatRect& bounds);
+    void add(const Font&, const TextRunPaintInfo&, const FloatRect& bounds, const TextBlobPtr&);
+
+    void clear();
+    // Drops every blob and shrinks the table, e.g. under memory pressure.
+    void purge();
+    size_t size() const { return m_blobs.size(); }
+    size_t byteCount() const { return m_byteCount; }
+
+    // Whether blobs for this run may be kept; runs that depend on state
+    // outside the key are not.
+    static bool isCacheable(const TextRunPaintInfo&);
+
+private:
+    struct Entry {
+        TextBlobPtr blob;
+        unsigned lastUse;
+        size_t byteCost;
+    };
+
+    void evictLeastRecentlyUsed();
+
+    typedef HashMap<TextBlobCacheKey, Entry, TextBlobCacheKeyHash, TextBlobCacheKeyTraits> BlobMap;
+    BlobMap m_blobs;
+    unsigned m_useCounter;
+    size_t m_byteBudget;
+    size_t m_byteCount;
+};
+
+TextBlobCache& textBlobCache();
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_PLATFORM_FONTS_TEXTBLOBCACHE_H_
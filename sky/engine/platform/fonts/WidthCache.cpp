@@ -0,0 +1,43 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/sky/engine/platform/fonts/WidthCache.h"
+
+#include "flutter/sky/engine/wtf/HashSet.h"
+#include "flutter/sky/engine/wtf/StdLibExtras.h"
+
+namespace blink {
+
+namespace {
+
+HashSet<WidthCache*>& liveWidthCaches()
+{
+    DEFINE_STATIC_LOCAL(HashSet<WidthCache*>, caches, ());
+    return caches;
+}
+
+} // namespace
+
+WidthCache::WidthCache()
+    : m_admissionInterval(1)
+    , m_missesUntilAdmission(0)
+    , m_windowLookups(0)
+    , m_windowHits(0)
+    , m_byteCount(0)
+{
+    liveWidthCaches().add(this);
+}
+
+WidthCache::~WidthCache()
+{
+    liveWidthCaches().remove(this);
+}
+
+void WidthCache::purgeAll()
+{
+    for (WidthCache* cache : liveWidthCaches())
+        cache->clear();
+}
+
+} // namespace blink
@@ -30,9 +30,12 @@
 #include "flutter/sky/engine/platform/text/TextRun.h"
 #include "flutter/sky/engine/wtf/Forward.h"
 #include "flutter/sky/engine/wtf/HashFunctions.h"
-#include "flutter/sky/engine/wtf/HashSet.h"
+#include "flutter/sky/engine/wtf/HashMap.h"
 #include "flutter/sky/engine/wtf/HashTableDeletedValueType.h"
+#include "flutter/sky/engine/wtf/Noncopyable.h"
 #include "flutter/sky/engine/wtf/StringHasher.h"
+#include "flutter/sky/engine/wtf/text/StringImpl.h"
+#include "flutter/sky/engine/wtf/text/WTFString.h"
 
 namespace blink {
 
@@ -46,168 +49,208 @@ struct WidthCacheEntry {
     IntRectExtent glyphBounds;
 };
 
+// Caches the width and glyph bounds of short text runs for a single font.
+// Shared by Font::width and HarfBuzzShaper, so a run shaped for painting or
+// hit testing does not have to be shaped again to be measured. Each cache is
+// bounded by bytes, and all of them are emptied by purgeAll().
 class WidthCache {
+    WTF_MAKE_NONCOPYABLE(WidthCache);
 private:
-    // Used to optimize small strings as hash table keys. Avoids malloc'ing an out-of-line StringImpl.
-    class SmallStringKey {
-    public:
-        static unsigned capacity() { return s_capacity; }
-
-        SmallStringKey()
-            : m_length(s_emptyValueLength)
+    // Identifies a run being looked up without copying its characters.
+    struct RunLookup {
+        explicit RunLookup(const TextRun& run)
+            : run(run)
         {
+            unsigned characterHash = run.is8Bit()
+                ? StringHasher::computeHashAndMaskTop8Bits(run.characters8(), run.length())
+                : StringHasher::computeHashAndMaskTop8Bits(run.characters16(), run.length());
+            // The direction can affect shaping, and hence the width, of
+            // bidi-sensitive runs.
+            hash = WTF::pairIntHash(characterHash, run.rtl());
         }
 
-        SmallStringKey(WTF::HashTableDeletedValueType)
-            : m_length(s_deletedValueLength)
+        const TextRun& run;
+        unsigned hash;
+    };
+
+    // Stored keys own a copy of their run's characters, so that a hash
+    // collision can never hand out another run's measurement.
+    class RunKey {
+    public:
+        RunKey()
+            : m_hash(0)
+            , m_rtl(false)
         {
         }
 
-        template<typename CharacterType> SmallStringKey(CharacterType* characters, unsigned short length)
-            : m_length(length)
+        RunKey(WTF::HashTableDeletedValueType)
+            : m_characters(WTF::HashTableDeletedValue)
+            , m_hash(0)
+            , m_rtl(false)
         {
-            ASSERT(length <= s_capacity);
-
-            StringHasher hasher;
-
-            bool remainder = length & 1;
-            length >>= 1;
+        }
 
-            unsigned i = 0;
-            while (length--) {
-                m_characters[i] = characters[i];
-                m_characters[i + 1] = characters[i + 1];
-                hasher.addCharactersAssumingAligned(characters[i], characters[i + 1]);
-                i += 2;
-            }
+        explicit RunKey(const RunLookup& lookup)
+            : m_characters(lookup.run.is8Bit()
+                ? String(lookup.run.characters8(), lookup.run.length())
+                : String(lookup.run.characters16(), lookup.run.length()))
+            , m_hash(lookup.hash)
+            , m_rtl(lookup.run.rtl())
+        {
+        }
 
-            if (remainder) {
-                m_characters[i] = characters[i];
-                hasher.addCharacter(characters[i]);
-            }
+        unsigned hash() const { return m_hash; }
+        size_t characterByteCount() const { return m_characters.length() * (m_characters.is8Bit() ? 1 : 2); }
 
-            m_hash = hasher.hash();
+        bool operator==(const RunKey& other) const
+        {
+            return m_hash == other.m_hash && m_rtl == other.m_rtl && m_characters == other.m_characters;
         }
 
-        const UChar* characters() const { return m_characters; }
-        unsigned short length() const { return m_length; }
-        unsigned hash() const { return m_hash; }
+        bool matches(const RunLookup& lookup) const
+        {
+            const TextRun& run = lookup.run;
+            if (m_hash != lookup.hash || m_rtl != run.rtl() || m_characters.length() != run.length())
+                return false;
+            return run.is8Bit()
+                ? WTF::equal(m_characters.impl(), run.characters8(), run.length())
+                : WTF::equal(m_characters.impl(), run.characters16(), run.length());
+        }
 
-        bool isHashTableDeletedValue() const { return m_length == s_deletedValueLength; }
-        bool isHashTableEmptyValue() const { return m_length == s_emptyValueLength; }
+        bool isHashTableDeletedValue() const { return m_characters.isHashTableDeletedValue(); }
+        bool isHashTableEmptyValue() const { return m_characters.isNull(); }
 
     private:
-        static const unsigned s_capacity = 15;
-        static const unsigned s_emptyValueLength = s_capacity + 1;
-        static const unsigned s_deletedValueLength = s_capacity + 2;
-
+        String m_characters;
         unsigned m_hash;
-        unsigned short m_length;
-        UChar m_characters[s_capacity];
+        bool m_rtl;
     };
 
-    struct SmallStringKeyHash {
-        static unsigned hash(const SmallStringKey& key) { return key.hash(); }
-        static bool equal(const SmallStringKey& a, const SmallStringKey& b) { return a == b; }
-        static const bool safeToCompareToEmptyOrDeleted = true; // Empty and deleted values have lengths that are not equal to any valid length.
+    struct RunKeyHash {
+        static unsigned hash(const RunKey& key) { return key.hash(); }
+        static bool equal(const RunKey& a, const RunKey& b) { return a == b; }
+        static const bool safeToCompareToEmptyOrDeleted = false;
     };
 
-    struct SmallStringKeyHashTraits : WTF::SimpleClassHashTraits<SmallStringKey> {
+    struct RunKeyHashTraits : WTF::SimpleClassHashTraits<RunKey> {
+        static const bool emptyValueIsZero = true;
         static const bool hasIsEmptyValueFunction = true;
-        static bool isEmptyValue(const SmallStringKey& key) { return key.isHashTableEmptyValue(); }
-        static const bool needsDestruction = false;
+        static bool isEmptyValue(const RunKey& key) { return key.isHashTableEmptyValue(); }
         static const unsigned minimumTableSize = 16;
     };
 
-    friend bool operator==(const SmallStringKey&, const SmallStringKey&);
+    struct RunLookupTranslator {
+        static unsigned hash(const RunLookup& lookup) { return lookup.hash; }
+        static bool equal(const RunKey& key, const RunLookup& lookup) { return key.matches(lookup); }
+        static void translate(RunKey& location, const RunLookup& lookup, unsigned) { location = RunKey(lookup); }
+    };
 
 public:
-    WidthCache()
-        : m_interval(s_maxInterval)
-        , m_countdown(m_interval)
-    {
-    }
+    WidthCache();
+    ~WidthCache();
 
-    WidthCacheEntry* add(const TextRun& run, WidthCacheEntry entry)
+    // Empties every live cache, e.g. under memory pressure. Must be called on
+    // the thread the caches are used on.
+    static void purgeAll();
+
+    // Returns the cached measurement for |run|, or 0 on a miss.
+    const WidthCacheEntry* find(const TextRun& run)
     {
-        if (static_cast<unsigned>(run.length()) > SmallStringKey::capacity())
+        if (!run.length() || run.length() > s_maxRunLength)
             return 0;
 
-        if (m_countdown > 0) {
-            --m_countdown;
-            return 0;
+        const WidthCacheEntry* entry = 0;
+        if (run.length() == 1) {
+            SingleCharMap::const_iterator it = m_singleCharMap.find(run[0]);
+            if (it != m_singleCharMap.end())
+                entry = &it->value;
+        } else {
+            Map::const_iterator it = m_map.find<RunLookupTranslator>(RunLookup(run));
+            if (it != m_map.end())
+                entry = &it->value;
         }
 
-        return addSlowCase(run, entry);
+        recordLookup(entry);
+        return entry;
     }
 
-    void clear()
+    void add(const TextRun& run, const WidthCacheEntry& entry)
     {
-        m_singleCharMap.clear();
-        m_map.clear();
-    }
+        ASSERT(entry.isValid());
+        if (!run.length() || run.length() > s_maxRunLength)
+            return;
 
-private:
-    WidthCacheEntry* addSlowCase(const TextRun& run, WidthCacheEntry entry)
-    {
-        int length = run.length();
-        bool isNewEntry;
-        WidthCacheEntry *value;
-        if (length == 1) {
-            SingleCharMap::AddResult addResult = m_singleCharMap.add(run[0], entry);
-            isNewEntry = addResult.isNewEntry;
-            value = &addResult.storedValue->value;
-        } else {
-            SmallStringKey smallStringKey;
-            if (run.is8Bit())
-                smallStringKey = SmallStringKey(run.characters8(), length);
-            else
-                smallStringKey = SmallStringKey(run.characters16(), length);
-
-            Map::AddResult addResult = m_map.add(smallStringKey, entry);
-            isNewEntry = addResult.isNewEntry;
-            value = &addResult.storedValue->value;
+        if (m_missesUntilAdmission) {
+            --m_missesUntilAdmission;
+            return;
         }
+        m_missesUntilAdmission = m_admissionInterval - 1;
 
-        // Cache hit: ramp up by sampling the next few words.
-        if (!isNewEntry) {
-            m_interval = s_minInterval;
-            return value;
+        if (run.length() == 1) {
+            if (m_singleCharMap.set(run[0], entry).isNewEntry)
+                m_byteCount += sizeof(uint32_t) + sizeof(WidthCacheEntry);
+        } else {
+            Map::AddResult result = m_map.add<RunLookupTranslator>(RunLookup(run), entry);
+            result.storedValue->value = entry;
+            if (result.isNewEntry)
+                m_byteCount += sizeof(RunKey) + sizeof(WidthCacheEntry) + sizeof(StringImpl) + result.storedValue->key.characterByteCount();
         }
 
-        // Cache miss: ramp down by increasing our sampling interval.
-        if (m_interval < s_maxInterval)
-            ++m_interval;
-        m_countdown = m_interval;
-
-        if ((m_singleCharMap.size() + m_map.size()) < s_maxSize)
-            return value;
+        if (m_byteCount < s_byteBudget)
+            return;
 
         // No need to be fancy: we're just trying to avoid pathological growth.
+        clear();
+    }
+
+    void clear()
+    {
         m_singleCharMap.clear();
         m_map.clear();
-        return 0;
+        m_byteCount = 0;
     }
 
-    typedef HashMap<SmallStringKey, WidthCacheEntry, SmallStringKeyHash, SmallStringKeyHashTraits> Map;
-    typedef HashMap<uint32_t, WidthCacheEntry, DefaultHash<uint32_t>::Hash, WTF::UnsignedWithZeroKeyHashTraits<uint32_t> > SingleCharMap;
-    static const int s_minInterval = -3; // A cache hit pays for about 3 cache misses.
-    static const int s_maxInterval = 20; // Sampling at this interval has almost no overhead.
-    static const unsigned s_maxSize = 500000; // Just enough to guard against pathological growth.
+    // Approximately the bytes held by the cached runs.
+    size_t byteCount() const { return m_byteCount; }
+
+private:
+    // Admission adapts to the observed hit rate: while the cache is paying
+    // off every miss is stored, and while it is not only a sample of misses
+    // is, so one-off strings do not churn the table.
+    void recordLookup(bool hit)
+    {
+        if (hit)
+            ++m_windowHits;
+        if (++m_windowLookups < s_windowSize)
+            return;
+
+        if (m_windowHits * 4 >= m_windowLookups)
+            m_admissionInterval = 1;
+        else if (m_windowHits * 16 < m_windowLookups && m_admissionInterval < s_maxAdmissionInterval)
+            m_admissionInterval *= 2;
+
+        if (m_missesUntilAdmission >= m_admissionInterval)
+            m_missesUntilAdmission = m_admissionInterval - 1;
+        m_windowLookups = 0;
+        m_windowHits = 0;
+    }
 
-    int m_interval;
-    int m_countdown;
+    typedef HashMap<RunKey, WidthCacheEntry, RunKeyHash, RunKeyHashTraits> Map;
+    typedef HashMap<uint32_t, WidthCacheEntry, DefaultHash<uint32_t>::Hash, WTF::UnsignedWithZeroKeyHashTraits<uint32_t> > SingleCharMap;
+    static const unsigned s_windowSize = 128; // Lookups between admission adjustments.
+    static const unsigned s_maxAdmissionInterval = 16; // Admit at least one miss in this many.
+    static const unsigned s_maxRunLength = 15; // Longer runs rarely repeat, and would cost their characters.
+    static const size_t s_byteBudget = 256 * 1024; // Just enough to guard against pathological growth.
+
+    unsigned m_admissionInterval;
+    unsigned m_missesUntilAdmission;
+    unsigned m_windowLookups;
+    unsigned m_windowHits;
+    size_t m_byteCount;
     SingleCharMap m_singleCharMap;
     Map m_map;
 };
 
-inline bool operator==(const WidthCache::SmallStringKey& a, const WidthCache::SmallStringKey& b)
-{
-    if (a.length() != b.length())
-        return false;
-    return WTF::equal(a.characters(), b.characters(), a.length());
-}
-
 } // namespace blink
 
 #endif  // SKY_ENGINE_PLATFORM_FONTS_WIDTHCACHE_H_
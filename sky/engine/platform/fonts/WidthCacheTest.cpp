@@ -0,0 +1,129 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tests for the WidthCache class.
+
+#include "flutter/sky/engine/platform/fonts/WidthCache.h"
+
+#include "flutter/sky/engine/wtf/HashMap.h"
+#include "flutter/sky/engine/wtf/text/WTFString.h"
+
+#include <gtest/gtest.h>
+
+namespace blink {
+
+namespace {
+
+WidthCacheEntry entryWithWidth(float width)
+{
+    WidthCacheEntry entry;
+    entry.width = width;
+    return entry;
+}
+
+unsigned characterHash(const String& string)
+{
+    return StringHasher::computeHashAndMaskTop8Bits(string.characters8(), string.length());
+}
+
+} // namespace
+
+TEST(WidthCacheTest, FindsAddedRun)
+{
+    WidthCache cache;
+    String hello("hello");
+    cache.add(TextRun(hello), entryWithWidth(10));
+
+    const WidthCacheEntry* entry = cache.find(TextRun(hello));
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(10, entry->width);
+
+    // The same characters stored as 16-bit are the same run.
+    const UChar hello16[] = { 'h', 'e', 'l', 'l', 'o' };
+    entry = cache.find(TextRun(hello16, 5));
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(10, entry->width);
+
+    EXPECT_FALSE(cache.find(TextRun(String("hell"))));
+    EXPECT_FALSE(cache.find(TextRun(String("world"))));
+    EXPECT_FALSE(cache.find(TextRun(hello, 0, 0, TextRun::AllowTrailingExpansion, RTL)));
+}
+
+TEST(WidthCacheTest, HashCollisionIsAMiss)
+{
+    // Find two different runs of the same length whose hashes collide. The
+    // character hash is 24 bits wide, so a few thousand candidates suffice.
+    HashMap<unsigned, String> candidates;
+    String first;
+    String second;
+    for (unsigned i = 100000; i < 1000000 && first.isNull(); ++i) {
+        String candidate = String::number(i);
+        HashMap<unsigned, String>::AddResult result = candidates.add(characterHash(candidate), candidate);
+        if (!result.isNewEntry) {
+            first = result.storedValue->value;
+            second = candidate;
+        }
+    }
+    ASSERT_FALSE(first.isNull());
+    ASSERT_EQ(first.length(), second.length());
+
+    WidthCache cache;
+    cache.add(TextRun(first), entryWithWidth(10));
+    EXPECT_TRUE(cache.find(TextRun(first)));
+    EXPECT_FALSE(cache.find(TextRun(second)));
+
+    cache.add(TextRun(second), entryWithWidth(20));
+    EXPECT_EQ(10, cache.find(TextRun(first))->width);
+    EXPECT_EQ(20, cache.find(TextRun(second))->width);
+}
+
+TEST(WidthCacheTest, SkipsLongRuns)
+{
+    WidthCache cache;
+    String shortRun("fifteen chars!!");
+    String longRun("sixteen chars!!!");
+    ASSERT_EQ(15u, shortRun.length());
+    ASSERT_EQ(16u, longRun.length());
+
+    cache.add(TextRun(shortRun), entryWithWidth(10));
+    cache.add(TextRun(longRun), entryWithWidth(20));
+    EXPECT_TRUE(cache.find(TextRun(shortRun)));
+    EXPECT_FALSE(cache.find(TextRun(longRun)));
+}
+
+TEST(WidthCacheTest, CountsBytesOfCachedRuns)
+{
+    WidthCache cache;
+    EXPECT_EQ(0u, cache.byteCount());
+
+    cache.add(TextRun(String("hello")), entryWithWidth(10));
+    size_t oneRun = cache.byteCount();
+    EXPECT_LT(0u, oneRun);
+
+    // Replacing a run's measurement costs nothing more.
+    cache.add(TextRun(String("hello")), entryWithWidth(12));
+    EXPECT_EQ(oneRun, cache.byteCount());
+
+    cache.add(TextRun(String("world")), entryWithWidth(10));
+    EXPECT_EQ(2 * oneRun, cache.byteCount());
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.byteCount());
+}
+
+TEST(WidthCacheTest, PurgeAllEmptiesEveryCache)
+{
+    WidthCache first;
+    WidthCache second;
+    first.add(TextRun(String("hello")), entryWithWidth(10));
+    second.add(TextRun(String("world")), entryWithWidth(20));
+
+    WidthCache::purgeAll();
+    EXPECT_FALSE(first.find(TextRun(String("hello"))));
+    EXPECT_FALSE(second.find(TextRun(String("world"))));
+    EXPECT_EQ(0u, first.byteCount());
+    EXPECT_EQ(0u, second.byteCount());
+}
+
+} // namespace blink
@@ -0,0 +1,218 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/sky/engine/platform/fonts/harfbuzz/HarfBuzzRunCache.h"
+
+#include "flutter/sky/engine/wtf/HashFunctions.h"
+#include "flutter/sky/engine/wtf/StdLibExtras.h"
+#include "flutter/sky/engine/wtf/StringHasher.h"
+
+namespace blink {
+
+static const unsigned cMinimumTableCapacity = 256;
+
+HarfBuzzRunCacheKey::HarfBuzzRunCacheKey(const UChar* characters, unsigned length, const Font& font, hb_direction_t direction, const String& locale, const hb_feature_t* features, unsigned featureCount)
+    : characters(characters)
+    , length(length)
+    , font(font)
+    , direction(direction)
+    , locale(locale)
+    , features(features)
+    , featureCount(featureCount)
+{
+    hash = StringHasher::computeHashAndMaskTop8Bits(characters, length);
+    hash = WTF::pairIntHash(hash, font.hash());
+    hash = WTF::pairIntHash(hash, direction);
+    hash = WTF::pairIntHash(hash, locale.isNull() ? 0 : locale.impl()->hash());
+    if (featureCount)
+        hash = WTF::pairIntHash(hash, StringHasher::hashMemory(features, featureCount * sizeof(hb_feature_t)));
+}
+
+HarfBuzzRunCacheEntry::HarfBuzzRunCacheEntry(const HarfBuzzRunCacheKey& key, hb_buffer_t* buffer)
+    : m_prev(0)
+    , m_next(0)
+    , m_hash(key.hash)
+    , m_font(key.font)
+    , m_direction(key.direction)
+    , m_locale(key.locale)
+    , m_buffer(buffer)
+{
+    m_characters.append(key.characters, key.length);
+    m_features.append(key.features, key.featureCount);
+
+    m_byteCost = sizeof(HarfBuzzRunCacheEntry)
+        + m_characters.capacity() * sizeof(UChar)
+        + m_features.capacity() * sizeof(hb_feature_t)
+        + hb_buffer_get_length(m_buffer) * (sizeof(hb_glyph_info_t) + sizeof(hb_glyph_position_t));
+}
+
+HarfBuzzRunCacheEntry::~HarfBuzzRunCacheEntry()
+{
+    hb_buffer_destroy(m_buffer);
+}
+
+bool HarfBuzzRunCacheEntry::matches(const HarfBuzzRunCacheKey& key) const
+{
+    if (m_hash != key.hash
+        || m_direction != key.direction
+        || m_characters.size() != key.length
+        || m_features.size() != key.featureCount)
+        return false;
+
+    if (!WTF::equal(m_characters.data(), key.characters, key.length))
+        return false;
+
+    if (key.featureCount && memcmp(m_features.data(), key.features, key.featureCount * sizeof(hb_feature_t)))
+        return false;
+
+    return m_locale == key.locale && m_font == key.font;
+}
+
+HarfBuzzRunCache::HarfBuzzRunCache(size_t byteBudget)
+    : m_table(adoptArrayPtr(new HarfBuzzRunCacheEntry*[cMinimumTableCapacity]()))
+    , m_capacity(cMinimumTableCapacity)
+    , m_byteBudget(byteBudget)
+{
+}
+
+HarfBuzzRunCache::~HarfBuzzRunCache()
+{
+    clear();
+}
+
+HarfBuzzRunCacheEntry* HarfBuzzRunCache::find(const HarfBuzzRunCacheKey& key)
+{
+    for (unsigned i = key.hash & mask(); HarfBuzzRunCacheEntry* entry = m_table[i]; i = (i + 1) & mask()) {
+        if (!entry->matches(key))
+            continue;
+
+        ++m_statistics.hits;
+        m_lru.remove(entry);
+        m_lru.append(entry);
+        return entry;
+    }
+
+    ++m_statistics.misses;
+    return 0;
+}
+
+void HarfBuzzRunCache::add(const HarfBuzzRunCacheKey& key, hb_buffer_t* buffer)
+{
+    HarfBuzzRunCacheEntry* entry = new HarfBuzzRunCacheEntry(key, buffer);
+
+    // Keep the load factor at or below one half so probe sequences stay short.
+    if ((m_statistics.entryCount + 1) * 2 > m_capacity)
+        rehash(m_capacity * 2);
+
+    insertIntoTable(entry);
+    m_lru.append(entry);
+    ++m_statistics.entryCount;
+    m_statistics.byteCount += entry->byteCost();
+
+    evictIfNeeded();
+}
+
+void HarfBuzzRunCache::clear()
+{
+    while (HarfBuzzRunCacheEntry* entry = m_lru.removeHead())
+        delete entry;
+
+    m_table = adoptArrayPtr(new HarfBuzzRunCacheEntry*[cMinimumTableCapacity]());
+    m_capacity = cMinimumTableCapacity;
+    m_statistics.entryCount = 0;
+    m_statistics.byteCount = 0;
+}
+
+void HarfBuzzRunCache::purge()
+{
+    m_statistics.evictions += m_statistics.entryCount;
+    clear();
+}
+
+void HarfBuzzRunCache::setByteBudget(size_t byteBudget)
+{
+    m_byteBudget = byteBudget;
+    evictIfNeeded();
+}
+
+void HarfBuzzRunCache::insertIntoTable(HarfBuzzRunCacheEntry* entry)
+{
+    unsigned i = entry->hash() & mask();
+    while (m_table[i])
+        i = (i + 1) & mask();
+    m_table[i] = entry;
+}
+
+void HarfBuzzRunCache::removeFromTable(HarfBuzzRunCacheEntry* entry)
+{
+    unsigned i = entry->hash() & mask();
+    while (m_table[i] != entry) {
+        ASSERT(m_table[i]);
+        i = (i + 1) & mask();
+    }
+
+    // Backward-shift deletion: pull later members of the probe sequence into
+    // the hole so that lookups never need tombstones.
+    unsigned j = i;
+    while (true) {
+        j = (j + 1) & mask();
+        HarfBuzzRunCacheEntry* candidate = m_table[j];
+        if (!candidate)
+            break;
+        unsigned home = candidate->hash() & mask();
+        bool canMove = (i <= j) ? (home <= i || home > j) : (home <= i && home > j);
+        if (canMove) {
+            m_table[i] = candidate;
+            i = j;
+        }
+    }
+    m_table[i] = 0;
+}
+
+void HarfBuzzRunCache::rehash(unsigned newCapacity)
+{
+    ASSERT(!(newCapacity & (newCapacity - 1)));
+    m_table = adoptArrayPtr(new HarfBuzzRunCacheEntry*[newCapacity]());
+    m_capacity = newCapacity;
+    for (HarfBuzzRunCacheEntry* entry = m_lru.head(); entry; entry = entry->next())
+        insertIntoTable(entry);
+}
+
+void HarfBuzzRunCache::evictIfNeeded()
+{
+    // Always keep the most recent entry, even if it alone exceeds the budget.
+    bool evicted = false;
+    while (m_statistics.byteCount > m_byteBudget && m_lru.head() != m_lru.tail()) {
+        HarfBuzzRunCacheEntry* entry = m_lru.removeHead();
+        removeFromTable(entry);
+        --m_statistics.entryCount;
+        m_statistics.byteCount -= entry->byteCost();
+        ++m_statistics.evictions;
+        delete entry;
+        evicted = true;
+    }
+
+    if (evicted)
+        shrinkIfNeeded();
+}
+
+void HarfBuzzRunCache::shrinkIfNeeded()
+{
+    // Halve the table while it is less than an eighth full. Growth happens at
+    // half full, so a shrunk table is not grown again by the next add().
+    unsigned newCapacity = m_capacity;
+    while (newCapacity > cMinimumTableCapacity && m_statistics.entryCount * 8 < newCapacity)
+        newCapacity /= 2;
+
+    if (newCapacity != m_capacity)
+        rehash(newCapacity);
+}
+
+HarfBuzzRunCache& harfBuzzRunCache()
+{
+    DEFINE_STATIC_LOCAL(HarfBuzzRunCache, globalHarfBuzzRunCache, ());
+    return globalHarfBuzzRunCache;
+}
+
+} // namespace blink
@@ -0,0 +1,130 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_PLATFORM_FONTS_HARFBUZZ_HARFBUZZRUNCACHE_H_
+#define SKY_ENGINE_PLATFORM_FONTS_HARFBUZZ_HARFBUZZRUNCACHE_H_
+
+#include "hb.h"
+#include "flutter/sky/engine/platform/fonts/Font.h"
+#include "flutter/sky/engine/wtf/DoublyLinkedList.h"
+#include "flutter/sky/engine/wtf/FastAllocBase.h"
+#include "flutter/sky/engine/wtf/Noncopyable.h"
+#include "flutter/sky/engine/wtf/OwnPtr.h"
+#include "flutter/sky/engine/wtf/Vector.h"
+#include "flutter/sky/engine/wtf/text/WTFString.h"
+
+namespace blink {
+
+// Identifies one shaped HarfBuzz run. The key does not own its characters
+// or features; it is only used for lookups and to seed new entries.
+struct HarfBuzzRunCacheKey {
+    HarfBuzzRunCacheKey(const UChar* characters, unsigned length, const Font&, hb_direction_t, const String& locale, const hb_feature_t* features, unsigned featureCount);
+
+    const UChar* characters;
+    unsigned length;
+    const Font& font;
+    hb_direction_t direction;
+    const String& locale;
+    const hb_feature_t* features;
+    unsigned featureCount;
+    unsigned hash;
+};
+
+class HarfBuzzRunCacheEntry : public DoublyLinkedListNode<HarfBuzzRunCacheEntry> {
+    WTF_MAKE_NONCOPYABLE(HarfBuzzRunCacheEntry); WTF_MAKE_FAST_ALLOCATED;
+    friend class WTF::DoublyLinkedListNode<HarfBuzzRunCacheEntry>;
+public:
+    // Takes ownership of |buffer|.
+    HarfBuzzRunCacheEntry(const HarfBuzzRunCacheKey&, hb_buffer_t* buffer);
+    ~HarfBuzzRunCacheEntry();
+
+    bool matches(const HarfBuzzRunCacheKey&) const;
+
+    hb_buffer_t* buffer() const { return m_buffer; }
+    unsigned hash() const { return m_hash; }
+    size_t byteCost() const { return m_byteCost; }
+
+private:
+    HarfBuzzRunCacheEntry* m_prev;
+    HarfBuzzRunCacheEntry* m_next;
+
+    unsigned m_hash;
+    Vector<UChar, 16> m_characters;
+    Font m_font;
+    hb_direction_t m_direction;
+    String m_locale;
+    Vector<hb_feature_t, 4> m_features;
+    hb_buffer_t* m_buffer;
+    size_t m_byteCost;
+};
+
+struct HarfBuzzRunCacheStatistics {
+    HarfBuzzRunCacheStatistics()
+        : hits(0)
+        , misses(0)
+        , evictions(0)
+        , entryCount(0)
+        , byteCount(0)
+    {
+    }
+
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    size_t entryCount;
+    size_t byteCount;
+};
+
+// Caches HarfBuzz shaping results across HarfBuzzShaper instances.
+//
+// Entries live in an open-addressing table (linear probing, backward-shift
+// deletion) and are threaded on an intrusive LRU list. The cache is bounded
+// by the approximate number of bytes held by its entries rather than by
+// entry count, so that many short runs can coexist with a few long ones.
+class HarfBuzzRunCache {
+    WTF_MAKE_NONCOPYABLE(HarfBuzzRunCache); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static const size_t defaultByteBudget = 2 * 1024 * 1024;
+
+    explicit HarfBuzzRunCache(size_t byteBudget = defaultByteBudget);
+    ~HarfBuzzRunCache();
+
+    // Returns the cached entry for |key| and marks it as most recently used,
+    // or returns 0 on a miss.
+    HarfBuzzRunCacheEntry* find(const HarfBuzzRunCacheKey&);
+
+    // Adds the shaping result for |key|, taking ownership of |buffer|. The
+    // key must not already be present in the cache.
+    void add(const HarfBuzzRunCacheKey&, hb_buffer_t* buffer);
+
+    void clear();
+
+    // Evicts every entry and shrinks the table, e.g. under memory pressure.
+    void purge();
+
+    size_t byteBudget() const { return m_byteBudget; }
+    void setByteBudget(size_t);
+
+    const HarfBuzzRunCacheStatistics& statistics() const { return m_statistics; }
+
+private:
+    unsigned mask() const { return m_capacity - 1; }
+    void insertIntoTable(HarfBuzzRunCacheEntry*);
+    void removeFromTable(HarfBuzzRunCacheEntry*);
+    void rehash(unsigned newCapacity);
+    void evictIfNeeded();
+    void shrinkIfNeeded();
+
+    OwnPtr<HarfBuzzRunCacheEntry*[]> m_table;
+    unsigned m_capacity;
+    DoublyLinkedList<HarfBuzzRunCacheEntry> m_lru;
+    size_t m_byteBudget;
+    HarfBuzzRunCacheStatistics m_statistics;
+};
+
+HarfBuzzRunCache& harfBuzzRunCache();
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_PLATFORM_FONTS_HARFBUZZ_HARFBUZZRUNCACHE_H_
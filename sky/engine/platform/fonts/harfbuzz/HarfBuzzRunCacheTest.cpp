@@ -0,0 +1,137 @@
+// Copyright 2016 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tests for the HarfBuzzRunCache class.
+
+#include "flutter/sky/engine/platform/fonts/harfbuzz/HarfBuzzRunCache.h"
+
+#include "flutter/sky/engine/platform/fonts/FontDescription.h"
+
+#include <gtest/gtest.h>
+
+namespace blink {
+
+namespace {
+
+const UChar hello[] = { 'h', 'e', 'l', 'l', 'o' };
+const UChar world[] = { 'w', 'o', 'r', 'l', 'd' };
+
+hb_buffer_t* createBuffer(unsigned glyphCount)
+{
+    hb_buffer_t* buffer = hb_buffer_create();
+    for (unsigned i = 0; i < glyphCount; ++i)
+        hb_buffer_add(buffer, 'a', i);
+    return buffer;
+}
+
+Font fontWithSize(float size)
+{
+    FontDescription description;
+    description.setComputedSize(size);
+    return Font(description);
+}
+
+} // namespace
+
+TEST(HarfBuzzRunCacheTest, MissThenHit)
+{
+    HarfBuzzRunCache cache;
+    Font font;
+    String locale("en");
+    HarfBuzzRunCacheKey key(hello, 5, font, HB_DIRECTION_LTR, locale, 0, 0);
+
+    EXPECT_FALSE(cache.find(key));
+    EXPECT_EQ(1u, cache.statistics().misses);
+
+    hb_buffer_t* buffer = createBuffer(5);
+    cache.add(key, buffer);
+    EXPECT_EQ(1u, cache.statistics().entryCount);
+
+    HarfBuzzRunCacheEntry* entry = cache.find(key);
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(buffer, entry->buffer());
+    EXPECT_EQ(1u, cache.statistics().hits);
+}
+
+TEST(HarfBuzzRunCacheTest, KeyEquality)
+{
+    HarfBuzzRunCache cache;
+    Font font;
+    String locale("en");
+    hb_feature_t feature = { HB_TAG('l', 'i', 'g', 'a'), 0, 0, static_cast<unsigned>(-1) };
+    cache.add(HarfBuzzRunCacheKey(hello, 5, font, HB_DIRECTION_LTR, locale, &feature, 1), createBuffer(5));
+
+    // The key is compared field by field; a key built from copies matches.
+    Vector<UChar> copy;
+    copy.append(hello, 5);
+    hb_feature_t featureCopy = feature;
+    String localeCopy("en");
+    EXPECT_TRUE(cache.find(HarfBuzzRunCacheKey(copy.data(), 5, font, HB_DIRECTION_LTR, localeCopy, &featureCopy, 1)));
+
+    EXPECT_FALSE(cache.find(HarfBuzzRunCacheKey(world, 5, font, HB_DIRECTION_LTR, locale, &feature, 1)));
+    EXPECT_FALSE(cache.find(HarfBuzzRunCacheKey(hello, 4, font, HB_DIRECTION_LTR, locale, &feature, 1)));
+    EXPECT_FALSE(cache.find(HarfBuzzRunCacheKey(hello, 5, font, HB_DIRECTION_RTL, locale, &feature, 1)));
+    EXPECT_FALSE(cache.find(HarfBuzzRunCacheKey(hello, 5, font, HB_DIRECTION_LTR, String("fr"), &feature, 1)));
+    EXPECT_FALSE(cache.find(HarfBuzzRunCacheKey(hello, 5, font, HB_DIRECTION_LTR, locale, 0, 0)));
+    EXPECT_FALSE(cache.find(HarfBuzzRunCacheKey(hello, 5, fontWithSize(24), HB_DIRECTION_LTR, locale, &feature, 1)));
+
+    hb_feature_t otherFeature = feature;
+    otherFeature.value = 1;
+    EXPECT_FALSE(cache.find(HarfBuzzRunCacheKey(hello, 5, font, HB_DIRECTION_LTR, locale, &otherFeature, 1)));
+
+    EXPECT_EQ(1u, cache.statistics().hits);
+    EXPECT_EQ(7u, cache.statistics().misses);
+}
+
+TEST(HarfBuzzRunCacheTest, EvictsLeastRecentlyUsed)
+{
+    HarfBuzzRunCache cache;
+    Font font;
+    String locale;
+    HarfBuzzRunCacheKey helloKey(hello, 5, font, HB_DIRECTION_LTR, locale, 0, 0);
+    HarfBuzzRunCacheKey worldKey(world, 5, font, HB_DIRECTION_LTR, locale, 0, 0);
+
+    cache.add(helloKey, createBuffer(5));
+    size_t entryCost = cache.statistics().byteCount;
+    cache.add(worldKey, createBuffer(5));
+
+    // Touch |hello| so that |world| is the least recently used.
+    EXPECT_TRUE(cache.find(helloKey));
+    cache.setByteBudget(entryCost);
+
+    EXPECT_EQ(1u, cache.statistics().entryCount);
+    EXPECT_EQ(1u, cache.statistics().evictions);
+    EXPECT_TRUE(cache.find(helloKey));
+    EXPECT_FALSE(cache.find(worldKey));
+}
+
+TEST(HarfBuzzRunCacheTest, PurgeEvictsEverything)
+{
+    HarfBuzzRunCache cache;
+    Font font;
+    String locale;
+
+    // Enough distinct runs to grow the table past its minimum size.
+    Vector<Vector<UChar>> runs;
+    for (UChar c = 0; c < 1024; ++c) {
+        Vector<UChar> run;
+        run.append(c);
+        runs.append(run);
+    }
+    for (const auto& run : runs)
+        cache.add(HarfBuzzRunCacheKey(run.data(), 1, font, HB_DIRECTION_LTR, locale, 0, 0), createBuffer(1));
+    EXPECT_EQ(1024u, cache.statistics().entryCount);
+
+    cache.purge();
+    EXPECT_EQ(0u, cache.statistics().entryCount);
+    EXPECT_EQ(0u, cache.statistics().byteCount);
+    EXPECT_EQ(1024u, cache.statistics().evictions);
+    EXPECT_FALSE(cache.find(HarfBuzzRunCacheKey(runs[0].data(), 1, font, HB_DIRECTION_LTR, locale, 0, 0)));
+
+    // The cache is still usable after a purge.
+    cache.add(HarfBuzzRunCacheKey(hello, 5, font, HB_DIRECTION_LTR, locale, 0, 0), createBuffer(5));
+    EXPECT_TRUE(cache.find(HarfBuzzRunCacheKey(hello, 5, font, HB_DIRECTION_LTR, locale, 0, 0)));
+}
+
+} // namespace blink
@@ -40,16 +40,13 @@
 #include "flutter/sky/engine/platform/fonts/Font.h"
 #include "flutter/sky/engine/platform/fonts/GlyphBuffer.h"
 #include "flutter/sky/engine/platform/fonts/harfbuzz/HarfBuzzFace.h"
+#include "flutter/sky/engine/platform/fonts/harfbuzz/HarfBuzzRunCache.h"
 #include "flutter/sky/engine/platform/text/SurrogatePairAwareTextIterator.h"
 #include "flutter/sky/engine/platform/text/TextBreakIterator.h"
 #include "flutter/sky/engine/wtf/Compiler.h"
 #include "flutter/sky/engine/wtf/MathExtras.h"
 #include "flutter/sky/engine/wtf/unicode/Unicode.h"
 
-#include <list>
-#include <map>
-#include <string>
-
 namespace blink {
 
 template<typename T>
@@ -77,137 +74,6 @@ private:
 };
 
 
-static const unsigned cHarfBuzzCacheMaxSize = 256;
-
-struct CachedShapingResultsLRUNode;
-struct CachedShapingResults;
-typedef std::map<std::wstring, CachedShapingResults*> CachedShapingResultsMap;
-typedef std::list<CachedShapingResultsLRUNode*> CachedShapingResultsLRU;
-
-struct CachedShapingResults {
-    CachedShapingResults(hb_buffer_t* harfBuzzBuffer, const Font* runFont, hb_direction_t runDir, const String& newLocale);
-    ~CachedShapingResults();
-
-    hb_buffer_t* buffer;
-    Font font;
-    hb_direction_t dir;
-    String locale;
-    CachedShapingResultsLRU::iterator lru;
-};
-
-struct CachedShapingResultsLRUNode {
-    CachedShapingResultsLRUNode(const CachedShapingResultsMap::iterator& cacheEntry);
-    ~CachedShapingResultsLRUNode();
-
-    CachedShapingResultsMap::iterator entry;
-};
-
-CachedShapingResults::CachedShapingResults(hb_buffer_t* harfBuzzBuffer, const Font* fontData, hb_direction_t dirData, const String& newLocale)
-    : buffer(harfBuzzBuffer)
-    , font(*fontData)
-    , dir(dirData)
-    , locale(newLocale)
-{
-}
-
-CachedShapingResults::~CachedShapingResults()
-{
-    hb_buffer_destroy(buffer);
-}
-
-CachedShapingResultsLRUNode::CachedShapingResultsLRUNode(const CachedShapingResultsMap::iterator& cacheEntry)
-    : entry(cacheEntry)
-{
-}
-
-CachedShapingResultsLRUNode::~CachedShapingResultsLRUNode()
-{
-}
-
-class HarfBuzzRunCache {
-public:
-    HarfBuzzRunCache();
-    ~HarfBuzzRunCache();
-
-    CachedShapingResults* find(const std::wstring& key) const;
-    void remove(CachedShapingResults* node);
-    void moveToBack(CachedShapingResults* node);
-    bool insert(const std::wstring& key, CachedShapingResults* run);
-
-private:
-    CachedShapingResultsMap m_harfBuzzRunMap;
-    CachedShapingResultsLRU m_harfBuzzRunLRU;
-};
-
-
-HarfBuzzRunCache::HarfBuzzRunCache()
-{
-}
-
-HarfBuzzRunCache::~HarfBuzzRunCache()
-{
-    for (CachedShapingResultsMap::iterator it = m_harfBuzzRunMap.begin(); it != m_harfBuzzRunMap.end(); ++it)
-        delete it->second;
-    for (CachedShapingResultsLRU::iterator it = m_harfBuzzRunLRU.begin(); it != m_harfBuzzRunLRU.end(); ++it)
-        delete *it;
-}
-
-bool HarfBuzzRunCache::insert(const std::wstring& key, CachedShapingResults* data)
-{
-    std::pair<CachedShapingResultsMap::iterator, bool> results =
-        m_harfBuzzRunMap.insert(CachedShapingResultsMap::value_type(key, data));
-
-    if (!results.second)
-        return false;
-
-    CachedShapingResultsLRUNode* node = new CachedShapingResultsLRUNode(results.first);
-
-    m_harfBuzzRunLRU.push_back(node);
-    data->lru = --m_harfBuzzRunLRU.end();
-
-    if (m_harfBuzzRunMap.size() > cHarfBuzzCacheMaxSize) {
-        CachedShapingResultsLRUNode* lru = m_harfBuzzRunLRU.front();
-        CachedShapingResults* foo = lru->entry->second;
-        m_harfBuzzRunMap.erase(lru->entry);
-        m_harfBuzzRunLRU.pop_front();
-        delete foo;
-        delete lru;
-    }
-
-    return true;
-}
-
-inline CachedShapingResults* HarfBuzzRunCache::find(const std::wstring& key) const
-{
-    CachedShapingResultsMap::const_iterator it = m_harfBuzzRunMap.find(key);
-
-    return it != m_harfBuzzRunMap.end() ? it->second : 0;
-}
-
-inline void HarfBuzzRunCache::remove(CachedShapingResults* node)
-{
-    CachedShapingResultsLRUNode* lruNode = *node->lru;
-
-    m_harfBuzzRunLRU.erase(node->lru);
-    m_harfBuzzRunMap.erase(lruNode->entry);
-    delete lruNode;
-    delete node;
-}
-
-inline void HarfBuzzRunCache::moveToBack(CachedShapingResults* node)
-{
-    CachedShapingResultsLRUNode* lruNode = *node->lru;
-    m_harfBuzzRunLRU.erase(node->lru);
-    m_harfBuzzRunLRU.push_back(lruNode);
-    node->lru = --m_harfBuzzRunLRU.end();
-}
-
-HarfBuzzRunCache& harfBuzzRunCache()
-{
-    DEFINE_STATIC_LOCAL(HarfBuzzRunCache, globalHarfBuzzRunCache, ());
-    return globalHarfBuzzRunCache;
-}
-
 static inline float harfBuzzPositionToFloat(hb_position_t value)
 {
     return static_cast<float>(value) / (1 << 16);
@@ -559,6 +425,8 @@ bool HarfBuzzShaper::shape(GlyphBuffer* glyphBuffer)
     if (!shapeHarfBuzzRuns())
         return false;
 
+    addToWidthCache();
+
     if (m_harfBuzzRuns.last()->hasGlyphToCharacterIndexes()
         && glyphBuffer && !fillGlyphBuffer(glyphBuffer))
         return false;
@@ -566,6 +434,33 @@ bool HarfBuzzShaper::shape(GlyphBuffer* glyphBuffer)
     return true;
 }
 
+IntRectExtent HarfBuzzShaper::glyphBounds() const
+{
+    IntRectExtent bounds;
+    bounds.setTop(floorf(-m_glyphBoundingBox.top()));
+    bounds.setBottom(ceilf(m_glyphBoundingBox.bottom()));
+    bounds.setLeft(std::max<int>(0, floorf(-m_glyphBoundingBox.left())));
+    bounds.setRight(std::max<int>(0, ceilf(m_glyphBoundingBox.right() - m_totalWidth)));
+    return bounds;
+}
+
+void HarfBuzzShaper::addToWidthCache()
+{
+    // Measurements that depend on which fallback fonts were used are not
+    // shareable, matching what Font::width has always done.
+    if (m_fallbackFonts && !m_fallbackFonts->isEmpty())
+        return;
+
+    FontFallbackList* fontList = m_font->fontList();
+    if (!fontList || !m_font->canCacheWidth(m_run))
+        return;
+
+    WidthCacheEntry entry;
+    entry.width = m_totalWidth;
+    entry.glyphBounds = glyphBounds();
+    fontList->widthCache().add(m_run, entry);
+}
+
 static inline int handleMultipleUChar(
     UChar32 character,
     unsigned clusterLength,
@@ -829,22 +724,14 @@ bool HarfBuzzShaper::shapeHarfBuzzRuns()
         hb_buffer_set_direction(harfBuzzBuffer.get(), currentRun->direction());
 
         const UChar* src = m_normalizedBuffer.get() + currentRun->startIndex();
-        std::wstring key(src, src + currentRun->numCharacters());
-
-        CachedShapingResults* cachedResults = runCache.find(key);
-        if (cachedResults) {
-            if (cachedResults->dir == currentRun->direction() && cachedResults->font == *m_font && cachedResults->locale == localeString) {
-                currentRun->applyShapeResult(cachedResults->buffer);
-                setGlyphPositionsForHarfBuzzRun(currentRun, cachedResults->buffer);
-
-                hb_buffer_clear_contents(harfBuzzBuffer.get());
+        HarfBuzzRunCacheKey key(src, currentRun->numCharacters(), *m_font, currentRun->direction(), localeString, m_features.data(), m_features.size());
 
-                runCache.moveToBack(cachedResults);
+        if (HarfBuzzRunCacheEntry* cachedResults = runCache.find(key)) {
+            currentRun->applyShapeResult(cachedResults->buffer());
+            setGlyphPositionsForHarfBuzzRun(currentRun, cachedResults->buffer());
 
-                continue;
-            }
-
-            runCache.remove(cachedResults);
+            hb_buffer_clear_contents(harfBuzzBuffer.get());
+            continue;
         }
 
         // Add a space as pre-context to the buffer. This prevents showing dotted-circle
@@ -869,7 +756,7 @@ bool HarfBuzzShaper::shapeHarfBuzzRuns()
         currentRun->applyShapeResult(harfBuzzBuffer.get());
         setGlyphPositionsForHarfBuzzRun(currentRun, harfBuzzBuffer.get());
 
-        runCache.insert(key, new CachedShapingResults(harfBuzzBuffer.get(), m_font, currentRun->direction(), localeString));
+        runCache.add(key, harfBuzzBuffer.get());
 
         harfBuzzBuffer.set(hb_buffer_create());
     }
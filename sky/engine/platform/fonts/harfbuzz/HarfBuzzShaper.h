@@ -34,6 +34,7 @@
 #include "hb.h"
 #include "flutter/sky/engine/platform/geometry/FloatBoxExtent.h"
 #include "flutter/sky/engine/platform/geometry/FloatPoint.h"
+#include "flutter/sky/engine/platform/geometry/IntRectExtent.h"
 #include "flutter/sky/engine/platform/text/TextRun.h"
 #include "flutter/sky/engine/wtf/HashSet.h"
 #include "flutter/sky/engine/wtf/OwnPtr.h"
@@ -64,6 +65,8 @@ public:
     int offsetForPosition(float targetX);
     FloatRect selectionRect(const FloatPoint&, int height, int from, int to);
     FloatBoxExtent glyphBoundingBox() const { return m_glyphBoundingBox; }
+    // glyphBoundingBox() rounded out and expressed as overflow beyond the advance.
+    IntRectExtent glyphBounds() const;
 
 private:
     class HarfBuzzRun {
@@ -126,6 +129,8 @@ private:
 
     void setFontFeatures();
 
+    void addToWidthCache();
+
     bool createHarfBuzzRuns();
     bool shapeHarfBuzzRuns();
     bool fillGlyphBuffer(GlyphBuffer*);
@@ -156,8 +161,6 @@ private:
     float m_totalWidth;
     FloatBoxExtent m_glyphBoundingBox;
     HashSet<const SimpleFontData*>* m_fallbackFonts;
-
-    friend struct CachedShapingResults;
 };
 
 } // namespace blink
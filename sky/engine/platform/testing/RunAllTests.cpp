@@ -30,7 +30,7 @@
 
 
 #include <string.h>
-#include "base/test/test_suite.h"
+#include "gtest/gtest.h"
 #include "flutter/sky/engine/platform/Partitions.h"
 #include "flutter/sky/engine/platform/TestingPlatformSupport.h"
 #include "flutter/sky/engine/wtf/MainThread.h"
@@ -45,7 +45,8 @@ int main(int argc, char** argv)
     blink::TestingPlatformSupport platform(platformConfig);
 
     blink::Partitions::init();
-    int result = base::RunUnitTestsUsingBaseTestSuite(argc, argv);
+    testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
     blink::Partitions::shutdown();
     return result;
 }
@@ -248,6 +248,7 @@ struct TextRunPaintInfo {
         : run(r)
         , from(0)
         , to(r.length())
+        , cachedTextBlob(nullptr)
     {
     }
 
@@ -46,6 +46,10 @@ BLINK_EXPORT void InitEngine(Platform*);
 // terminated by the time this function returns.
 BLINK_EXPORT void ShutdownEngine();
 
+// Drops cached data that can be recomputed, such as text shaping results.
+// Called on the main WebKit thread when the system is low on memory.
+BLINK_EXPORT void PurgeEngineCaches();
+
 }  // namespace blink
 
 #endif  // SKY_ENGINE_PUBLIC_WEB_SKY_H_
@@ -32,6 +32,10 @@
 
 #include "flutter/glue/trace_event.h"
 #include "flutter/sky/engine/core/Init.h"
+#include "flutter/sky/engine/core/rendering/RenderArena.h"
+#include "flutter/sky/engine/platform/fonts/TextBlobCache.h"
+#include "flutter/sky/engine/platform/fonts/WidthCache.h"
+#include "flutter/sky/engine/platform/fonts/harfbuzz/HarfBuzzRunCache.h"
 #include "flutter/sky/engine/public/platform/Platform.h"
 #include "flutter/sky/engine/wtf/Assertions.h"
 #include "flutter/sky/engine/wtf/MainThread.h"
@@ -142,4 +146,11 @@ void ShutdownEngine() {
   Platform::shutdown();
 }
 
+void PurgeEngineCaches() {
+  harfBuzzRunCache().purge();
+  WidthCache::purgeAll();
+  textBlobCache().purge();
+  RenderArena::purgeFreeChunks();
+}
+
 }  // namespace blink
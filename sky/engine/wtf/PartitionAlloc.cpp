@@ -311,7 +311,7 @@ static NEVER_INLINE void partitionFull()
 static ALWAYS_INLINE void partitionDecommitSystemPages(PartitionRootBase* root, void* addr, size_t len)
 {
     decommitSystemPages(addr, len);
-    ASSERT(root->totalSizeOfCommittedPages > len);
+    ASSERT(root->totalSizeOfCommittedPages >= len);
     root->totalSizeOfCommittedPages -= len;
 }
 
@@ -920,62 +920,149 @@ void* partitionReallocGeneric(PartitionRootGeneric* root, void* ptr, size_t newS
 #endif
 }
 
+static void partitionDecommitEmptyPages(PartitionRootBase* root)
+{
+    for (size_t i = 0; i < kMaxFreeableSpans; ++i) {
+        PartitionPage* page = root->globalEmptyPageRing[i];
+        if (!page)
+            continue;
+        // As in partitionRegisterEmptyPage(), the page may have been reused
+        // since it was registered.
+        if (!page->numAllocatedSlots && page->freelistHead)
+            partitionFreePage(root, page);
+        page->freeCacheIndex = -1;
+        root->globalEmptyPageRing[i] = 0;
+    }
+}
+
+void partitionPurgeMemory(PartitionRoot* root)
+{
+    partitionDecommitEmptyPages(root);
+}
+
+void partitionPurgeMemoryGeneric(PartitionRootGeneric* root)
+{
+    spinLockLock(&root->lock);
+    partitionDecommitEmptyPages(root);
+    spinLockUnlock(&root->lock);
+}
+
+static void partitionDumpPageStats(PartitionBucketMemoryStats* stats, const PartitionPage* page)
+{
+    // A page may be on the active list but freed and not yet swept.
+    if (!page->freelistHead && !page->numUnprovisionedSlots && !page->numAllocatedSlots) {
+        ++stats->numDecommittedPages;
+        return;
+    }
+
+    size_t bucketNumSlots = partitionBucketSlots(page->bucket);
+    size_t provisionedBytes = (bucketNumSlots - page->numUnprovisionedSlots) * stats->bucketSlotSize;
+    // Round up to system page size.
+    size_t residentBytes = (provisionedBytes + kSystemPageOffsetMask) & kSystemPageBaseMask;
+    // Pages are only marked full once they leave the active list.
+    ASSERT(page->numAllocatedSlots >= 0);
+    size_t activeBytes = page->numAllocatedSlots * stats->bucketSlotSize;
+
+    stats->activeBytes += activeBytes;
+    stats->residentBytes += residentBytes;
+    stats->freelistBytes += provisionedBytes - activeBytes;
+    if (!activeBytes) {
+        ++stats->numEmptyPages;
+        stats->decommittableBytes += residentBytes;
+    } else if (activeBytes == bucketNumSlots * stats->bucketSlotSize) {
+        ++stats->numFullPages;
+    } else {
+        ++stats->numActivePages;
+    }
+}
+
+static bool partitionDumpBucketStats(PartitionBucketMemoryStats* stats, const PartitionBucket* bucket)
+{
+    // Invalid generic buckets have no active list at all.
+    bool noActivePages = !bucket->activePagesHead || bucket->activePagesHead == &PartitionRootGeneric::gSeedPage;
+    if (noActivePages && !bucket->freePagesHead && !bucket->numFullPages)
+        return false;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->bucketSlotSize = bucket->slotSize;
+    stats->allocatedPageSize = bucket->numSystemPagesPerSlotSpan * kSystemPageSize;
+
+    // Pages moved off the active list when they filled up are only counted.
+    size_t bucketUsefulStorage = stats->bucketSlotSize * partitionBucketSlots(bucket);
+    stats->numFullPages = bucket->numFullPages;
+    stats->activeBytes = bucket->numFullPages * bucketUsefulStorage;
+    stats->residentBytes = bucket->numFullPages * stats->allocatedPageSize;
+
+    for (const PartitionPage* page = bucket->freePagesHead; page; page = page->nextPage)
+        ++stats->numDecommittedPages;
+    if (!noActivePages) {
+        for (const PartitionPage* page = bucket->activePagesHead; page; page = page->nextPage)
+            partitionDumpPageStats(stats, page);
+    }
+    return true;
+}
+
+static void partitionDumpBucketsStats(PartitionRootBase* root, const PartitionBucket* buckets, size_t numBuckets, const char* partitionName, PartitionStatsDumper* dumper)
+{
+    PartitionMemoryStats totals;
+    memset(&totals, 0, sizeof(totals));
+    totals.totalMmappedBytes = root->totalSizeOfSuperPages;
+    totals.totalCommittedBytes = root->totalSizeOfCommittedPages;
+
+    for (size_t i = 0; i < numBuckets; ++i) {
+        PartitionBucketMemoryStats stats;
+        if (!partitionDumpBucketStats(&stats, &buckets[i]))
+            continue;
+        totals.totalActiveBytes += stats.activeBytes;
+        totals.totalResidentBytes += stats.residentBytes;
+        totals.totalFreelistBytes += stats.freelistBytes;
+        totals.totalDecommittableBytes += stats.decommittableBytes;
+        dumper->partitionDumpBucketStats(partitionName, stats);
+    }
+    dumper->partitionDumpTotals(partitionName, totals);
+}
+
+void partitionDumpStats(PartitionRoot* root, const char* partitionName, PartitionStatsDumper* dumper)
+{
+    partitionDumpBucketsStats(root, root->buckets(), root->numBuckets, partitionName, dumper);
+}
+
+void partitionDumpStatsGeneric(PartitionRootGeneric* root, const char* partitionName, PartitionStatsDumper* dumper)
+{
+    // Reporting happens under the lock, so dumpers must not allocate from
+    // the partition they are given.
+    spinLockLock(&root->lock);
+    partitionDumpBucketsStats(root, root->buckets, kGenericNumBucketedOrders * kGenericNumBucketsPerOrder, partitionName, dumper);
+    spinLockUnlock(&root->lock);
+}
+
 #ifndef NDEBUG
 
+namespace {
+
+class PartitionStatsPrinter final : public PartitionStatsDumper {
+public:
+    void partitionDumpTotals(const char* partitionName, const PartitionMemoryStats& stats) override
+    {
+        printf("total live: %zu bytes\n", stats.totalActiveBytes);
+        printf("total resident: %zu bytes\n", stats.totalResidentBytes);
+        printf("total freeable: %zu bytes\n", stats.totalDecommittableBytes);
+        fflush(stdout);
+    }
+
+    void partitionDumpBucketStats(const char* partitionName, const PartitionBucketMemoryStats& stats) override
+    {
+        size_t waste = stats.allocatedPageSize % stats.bucketSlotSize;
+        printf("bucket size %zu (pageSize %zu waste %zu): %zu alloc/%zu commit/%zu freeable bytes, %zu/%zu/%zu/%zu full/active/empty/free pages\n", stats.bucketSlotSize, stats.allocatedPageSize, waste, stats.activeBytes, stats.residentBytes, stats.decommittableBytes, stats.numFullPages, stats.numActivePages, stats.numEmptyPages, stats.numDecommittedPages);
+    }
+};
+
+} // namespace
+
 void partitionDumpStats(const PartitionRoot& root)
 {
-    size_t i;
-    size_t totalLive = 0;
-    size_t totalResident = 0;
-    size_t totalFreeable = 0;
-    for (i = 0; i < root.numBuckets; ++i) {
-        const PartitionBucket& bucket = root.buckets()[i];
-        if (bucket.activePagesHead == &PartitionRootGeneric::gSeedPage && !bucket.freePagesHead && !bucket.numFullPages) {
-            // Empty bucket with no freelist or full pages. Skip reporting it.
-            continue;
-        }
-        size_t numFreePages = 0;
-        PartitionPage* freePages = bucket.freePagesHead;
-        while (freePages) {
-            ++numFreePages;
-            freePages = freePages->nextPage;
-        }
-        size_t bucketSlotSize = bucket.slotSize;
-        size_t bucketNumSlots = partitionBucketSlots(&bucket);
-        size_t bucketUsefulStorage = bucketSlotSize * bucketNumSlots;
-        size_t bucketPageSize = bucket.numSystemPagesPerSlotSpan * kSystemPageSize;
-        size_t bucketWaste = bucketPageSize - bucketUsefulStorage;
-        size_t numActiveBytes = bucket.numFullPages * bucketUsefulStorage;
-        size_t numResidentBytes = bucket.numFullPages * bucketPageSize;
-        size_t numFreeableBytes = 0;
-        size_t numActivePages = 0;
-        const PartitionPage* page = bucket.activePagesHead;
-        while (page) {
-            ASSERT(page != &PartitionRootGeneric::gSeedPage);
-            // A page may be on the active list but freed and not yet swept.
-            if (!page->freelistHead && !page->numUnprovisionedSlots && !page->numAllocatedSlots) {
-                ++numFreePages;
-            } else {
-                ++numActivePages;
-                numActiveBytes += (page->numAllocatedSlots * bucketSlotSize);
-                size_t pageBytesResident = (bucketNumSlots - page->numUnprovisionedSlots) * bucketSlotSize;
-                // Round up to system page size.
-                pageBytesResident = (pageBytesResident + kSystemPageOffsetMask) & kSystemPageBaseMask;
-                numResidentBytes += pageBytesResident;
-                if (!page->numAllocatedSlots)
-                    numFreeableBytes += pageBytesResident;
-            }
-            page = page->nextPage;
-        }
-        totalLive += numActiveBytes;
-        totalResident += numResidentBytes;
-        totalFreeable += numFreeableBytes;
-        printf("bucket size %zu (pageSize %zu waste %zu): %zu alloc/%zu commit/%zu freeable bytes, %zu/%zu/%zu full/active/free pages\n", bucketSlotSize, bucketPageSize, bucketWaste, numActiveBytes, numResidentBytes, numFreeableBytes, static_cast<size_t>(bucket.numFullPages), numActivePages, numFreePages);
-    }
-    printf("total live: %zu bytes\n", totalLive);
-    printf("total resident: %zu bytes\n", totalResident);
-    printf("total freeable: %zu bytes\n", totalFreeable);
-    fflush(stdout);
+    PartitionStatsPrinter printer;
+    partitionDumpStats(const_cast<PartitionRoot*>(&root), "", &printer);
 }
 
 #endif // !NDEBUG
@@ -309,6 +309,52 @@ WTF_EXPORT NEVER_INLINE void* partitionAllocSlowPath(PartitionRootBase*, int, si
 WTF_EXPORT NEVER_INLINE void partitionFreeSlowPath(PartitionPage*);
 WTF_EXPORT NEVER_INLINE void* partitionReallocGeneric(PartitionRootGeneric*, void*, size_t);
 
+// Decommits the empty slot spans a partition keeps around for reuse. Live
+// allocations are unaffected; the spans are recommitted on demand.
+WTF_EXPORT void partitionPurgeMemory(PartitionRoot*);
+WTF_EXPORT void partitionPurgeMemoryGeneric(PartitionRootGeneric*);
+
+// Memory held by a partition as a whole. Direct mapped allocations only show
+// up in the mapped and committed totals.
+struct PartitionMemoryStats {
+    size_t totalMmappedBytes; // Address space reserved from the system.
+    size_t totalCommittedBytes; // Pages backed by memory.
+    size_t totalResidentBytes; // Committed pages that slot spans have touched.
+    size_t totalActiveBytes; // Bytes in live allocations.
+    size_t totalFreelistBytes; // Touched bytes in free slots.
+    size_t totalDecommittableBytes; // Bytes held by empty slot spans.
+};
+
+// Memory held by the slot spans of one bucket.
+struct PartitionBucketMemoryStats {
+    size_t bucketSlotSize;
+    size_t allocatedPageSize; // Size of one slot span.
+    size_t activeBytes;
+    size_t residentBytes;
+    size_t freelistBytes;
+    size_t decommittableBytes;
+    size_t numFullPages;
+    size_t numActivePages; // Slot spans with both live and free slots.
+    size_t numEmptyPages; // Slot spans with no live slots, still committed.
+    size_t numDecommittedPages;
+};
+
+// Receives the result of partitionDumpStats(). Buckets that have never held
+// an allocation are not reported.
+class WTF_EXPORT PartitionStatsDumper {
+public:
+    virtual void partitionDumpTotals(const char* partitionName, const PartitionMemoryStats&) = 0;
+    virtual void partitionDumpBucketStats(const char* partitionName, const PartitionBucketMemoryStats&) = 0;
+
+protected:
+    virtual ~PartitionStatsDumper() { }
+};
+
+// Walks all buckets of a partition. Must be called on the thread that owns a
+// size specific partition; the generic variant takes the partition's lock.
+WTF_EXPORT void partitionDumpStats(PartitionRoot*, const char* partitionName, PartitionStatsDumper*);
+WTF_EXPORT void partitionDumpStatsGeneric(PartitionRootGeneric*, const char* partitionName, PartitionStatsDumper*);
+
 #ifndef NDEBUG
 WTF_EXPORT void partitionDumpStats(const PartitionRoot&);
 #endif
@@ -668,5 +714,12 @@ using WTF::partitionReallocGeneric;
 using WTF::partitionAllocActualSize;
 using WTF::partitionAllocSupportsGetSize;
 using WTF::partitionAllocGetSize;
+using WTF::PartitionStatsDumper;
+using WTF::PartitionMemoryStats;
+using WTF::PartitionBucketMemoryStats;
+using WTF::partitionDumpStats;
+using WTF::partitionDumpStatsGeneric;
+using WTF::partitionPurgeMemory;
+using WTF::partitionPurgeMemoryGeneric;
 
 #endif  // SKY_ENGINE_WTF_PARTITIONALLOC_H_
@@ -1096,6 +1096,152 @@ TEST(PartitionAllocTest, LostFreePagesBug)
     TestShutdown();
 }
 
+class MockPartitionStatsDumper : public WTF::PartitionStatsDumper {
+public:
+    MockPartitionStatsDumper()
+        : m_numBuckets(0)
+        , m_dumpedTotals(false)
+    {
+        memset(&m_totals, 0, sizeof(m_totals));
+        memset(&m_bucket, 0, sizeof(m_bucket));
+    }
+
+    void partitionDumpTotals(const char* partitionName, const WTF::PartitionMemoryStats& stats) override
+    {
+        m_totals = stats;
+        m_dumpedTotals = true;
+    }
+
+    void partitionDumpBucketStats(const char* partitionName, const WTF::PartitionBucketMemoryStats& stats) override
+    {
+        EXPECT_FALSE(m_dumpedTotals);
+        ++m_numBuckets;
+        m_bucket = stats;
+    }
+
+    size_t numBuckets() const { return m_numBuckets; }
+    bool dumpedTotals() const { return m_dumpedTotals; }
+    const WTF::PartitionMemoryStats& totals() const { return m_totals; }
+    // The last bucket reported.
+    const WTF::PartitionBucketMemoryStats& bucket() const { return m_bucket; }
+
+private:
+    size_t m_numBuckets;
+    bool m_dumpedTotals;
+    WTF::PartitionMemoryStats m_totals;
+    WTF::PartitionBucketMemoryStats m_bucket;
+};
+
+// Tests the per bucket statistics and the purge of empty slot spans.
+TEST(PartitionAllocTest, DumpMemoryStats)
+{
+    TestSetup();
+
+    {
+        MockPartitionStatsDumper dumper;
+        partitionDumpStats(allocator.root(), "mock_allocator", &dumper);
+        EXPECT_TRUE(dumper.dumpedTotals());
+        EXPECT_EQ(0u, dumper.numBuckets());
+        EXPECT_EQ(0u, dumper.totals().totalCommittedBytes);
+    }
+
+    void* ptr = partitionAlloc(allocator.root(), kTestAllocSize);
+    WTF::PartitionPage* page = WTF::partitionPointerToPage(WTF::partitionCookieFreePointerAdjust(ptr));
+    size_t residentBytes = 0;
+
+    {
+        MockPartitionStatsDumper dumper;
+        partitionDumpStats(allocator.root(), "mock_allocator", &dumper);
+        EXPECT_EQ(1u, dumper.numBuckets());
+        const WTF::PartitionBucketMemoryStats& stats = dumper.bucket();
+        EXPECT_EQ(kRealAllocSize, stats.bucketSlotSize);
+        EXPECT_EQ(kRealAllocSize, stats.activeBytes);
+        EXPECT_TRUE(stats.residentBytes);
+        EXPECT_FALSE(stats.residentBytes & WTF::kSystemPageOffsetMask);
+        EXPECT_EQ(0u, stats.decommittableBytes);
+        EXPECT_EQ(1u, stats.numActivePages);
+        EXPECT_EQ(0u, stats.numEmptyPages);
+        EXPECT_TRUE(stats.freelistBytes);
+        EXPECT_LE(stats.activeBytes + stats.freelistBytes, stats.residentBytes);
+
+        EXPECT_EQ(kRealAllocSize, dumper.totals().totalActiveBytes);
+        EXPECT_EQ(allocator.root()->totalSizeOfCommittedPages, dumper.totals().totalCommittedBytes);
+        EXPECT_EQ(allocator.root()->totalSizeOfSuperPages, dumper.totals().totalMmappedBytes);
+        residentBytes = stats.residentBytes;
+    }
+
+    partitionFree(ptr);
+
+    {
+        MockPartitionStatsDumper dumper;
+        partitionDumpStats(allocator.root(), "mock_allocator", &dumper);
+        EXPECT_EQ(1u, dumper.numBuckets());
+        const WTF::PartitionBucketMemoryStats& stats = dumper.bucket();
+        EXPECT_EQ(0u, stats.activeBytes);
+        EXPECT_EQ(1u, stats.numEmptyPages);
+        EXPECT_EQ(residentBytes, stats.decommittableBytes);
+        EXPECT_EQ(residentBytes, dumper.totals().totalDecommittableBytes);
+    }
+
+    size_t committedBeforePurge = allocator.root()->totalSizeOfCommittedPages;
+    partitionPurgeMemory(allocator.root());
+    EXPECT_FALSE(page->freelistHead);
+    EXPECT_EQ(-1, page->freeCacheIndex);
+    EXPECT_GT(committedBeforePurge, allocator.root()->totalSizeOfCommittedPages);
+
+    {
+        MockPartitionStatsDumper dumper;
+        partitionDumpStats(allocator.root(), "mock_allocator", &dumper);
+        EXPECT_EQ(1u, dumper.numBuckets());
+        const WTF::PartitionBucketMemoryStats& stats = dumper.bucket();
+        EXPECT_EQ(0u, stats.residentBytes);
+        EXPECT_EQ(0u, stats.decommittableBytes);
+        EXPECT_EQ(1u, stats.numDecommittedPages);
+    }
+
+    // The purged page is recommitted on demand.
+    ptr = partitionAlloc(allocator.root(), kTestAllocSize);
+    EXPECT_TRUE(ptr);
+    partitionFree(ptr);
+
+    TestShutdown();
+}
+
+TEST(PartitionAllocTest, DumpMemoryStatsGeneric)
+{
+    TestSetup();
+
+    size_t size = WTF::kSystemPageSize - kExtraAllocSize;
+    void* ptr = partitionAllocGeneric(genericAllocator.root(), size);
+    void* ptr2 = partitionAllocGeneric(genericAllocator.root(), size);
+
+    {
+        MockPartitionStatsDumper dumper;
+        partitionDumpStatsGeneric(genericAllocator.root(), "mock_generic_allocator", &dumper);
+        EXPECT_EQ(1u, dumper.numBuckets());
+        const WTF::PartitionBucketMemoryStats& stats = dumper.bucket();
+        EXPECT_EQ(WTF::kSystemPageSize, stats.bucketSlotSize);
+        EXPECT_EQ(2 * WTF::kSystemPageSize, stats.activeBytes);
+        EXPECT_EQ(2 * WTF::kSystemPageSize, stats.residentBytes);
+        EXPECT_EQ(0u, stats.freelistBytes);
+    }
+
+    partitionFreeGeneric(genericAllocator.root(), ptr);
+    partitionFreeGeneric(genericAllocator.root(), ptr2);
+    partitionPurgeMemoryGeneric(genericAllocator.root());
+
+    {
+        MockPartitionStatsDumper dumper;
+        partitionDumpStatsGeneric(genericAllocator.root(), "mock_generic_allocator", &dumper);
+        EXPECT_EQ(1u, dumper.numBuckets());
+        EXPECT_EQ(0u, dumper.bucket().activeBytes);
+        EXPECT_EQ(0u, dumper.bucket().residentBytes);
+        EXPECT_EQ(0u, dumper.totals().totalDecommittableBytes);
+    }
+
+    TestShutdown();
+}
+
 #if !OS(ANDROID) && !OS(IOS) && !OS(FUCHSIA)
 
 // Make sure that malloc(-1) dies.